@@ -0,0 +1,98 @@
+#ifndef _PRIME_VULKAN_ARENA_H
+#define _PRIME_VULKAN_ARENA_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include <type_traits>
+
+namespace pr {
+namespace vk {
+
+/// Storage for the arrays and strings a create info points to.
+///
+/// A bump allocator: the first `inline_size` bytes are part of the arena
+/// itself, so a typical create info allocates nothing, and a large one
+/// one block at a time, each twice the size of the last. Everything is
+/// freed together when the arena is destroyed or cleared, so setting an
+/// array again does not leak the old one.
+///
+/// Not copyable. A create info that is copied copies what its pointers
+/// point to into its own arena, which also fixes the pointers.
+class Arena
+{
+public:
+    static constexpr size_t inline_size = 256;
+
+public:
+    Arena();
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    /// Uninitialized storage for `count` objects, or null for none.
+    template<typename T>
+    T* allocate(size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "Arena holds plain Vulkan structs only.");
+
+        if (count == 0) {
+            return nullptr;
+        }
+
+        return static_cast<T*>(
+            this->allocate_bytes(sizeof(T) * count, alignof(T)));
+    }
+
+    /// Copy of `count` objects, or null for none or for null.
+    template<typename T>
+    T* copy(const T *data, size_t count)
+    {
+        if (data == nullptr) {
+            return nullptr;
+        }
+
+        T *p = this->allocate<T>(count);
+        if (p != nullptr) {
+            memcpy(p, data, sizeof(T) * count);
+        }
+
+        return p;
+    }
+
+    /// Copy of a NUL terminated string, or null for null.
+    const char* copy_string(const char *string);
+
+    /// Copy of `count` strings and of the array pointing to them.
+    const char* const* copy_strings(const char* const *strings,
+                                    size_t count);
+
+    /// Free everything allocated.
+    void clear();
+
+private:
+    void* allocate_bytes(size_t size, size_t alignment);
+
+private:
+    /// Heap block, followed by its bytes.
+    struct Block
+    {
+        Block *next;
+        size_t size;
+    };
+
+    alignas(alignof(max_align_t)) unsigned char _inline[inline_size];
+    /// Newest first.
+    Block *_blocks;
+    unsigned char *_cursor;
+    unsigned char *_end;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_ARENA_H
@@ -0,0 +1,113 @@
+#ifndef _PRIME_VULKAN_ASYNC_COMPUTE_H
+#define _PRIME_VULKAN_ASYNC_COMPUTE_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <primer/vector.h>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/command-pool.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/queue.h>
+#include <prime-vulkan/semaphore.h>
+#include <prime-vulkan/fence.h>
+#include <prime-vulkan/queue-topology.h>
+
+namespace pr {
+namespace vk {
+
+/// Runs compute work on the compute queue so it overlaps graphics.
+///
+/// Each frame in flight has a compute command buffer and two semaphores.
+/// A graphics submission signals `start_semaphore` at the point compute
+/// may start, e.g. after the depth prepass. A later graphics submission
+/// waits on `finished_semaphore` where it consumes the results:
+///
+///     auto& cmd = compute.begin(frame_index);
+///     cmd.bind_pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, culling);
+///     cmd.dispatch(group_count, 1, 1);
+///
+///     // Graphics part 1 signals compute.start_semaphore(frame_index).
+///     compute.submit(frame_index, true);
+///     // Graphics part 2 waits on compute.finished_semaphore(frame_index)
+///     // at VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT.
+///
+/// Without a separate compute family the work runs on the graphics
+/// family, in the same order. Resources used by both queues should be
+/// created with `sharing_mode` and `sharing_families`.
+class AsyncCompute
+{
+public:
+    AsyncCompute(const Device& device,
+                 const QueueTopology& topology,
+                 uint32_t frames_in_flight = 2);
+
+    /// Waits for the submitted work.
+    ~AsyncCompute();
+
+    AsyncCompute(const AsyncCompute&) = delete;
+
+    AsyncCompute& operator=(const AsyncCompute&) = delete;
+
+    /// Whether compute runs on a family other than graphics.
+    bool is_async() const;
+
+    uint32_t queue_family() const;
+
+    Queue& queue();
+
+    /// `VK_SHARING_MODE_CONCURRENT` if compute has its own family.
+    ::VkSharingMode sharing_mode() const;
+
+    /// The graphics and compute families when they differ, otherwise
+    /// empty.
+    pr::Vector<uint32_t> sharing_families() const;
+
+    /// Wait until the last submission of the frame slot is done, then
+    /// begin its command buffer.
+    CommandBuffer& begin(uint32_t frame_index);
+
+    /// End and submit the frame's command buffer. If `wait_for_graphics`,
+    /// all of its commands wait on `start_semaphore`. Signals
+    /// `finished_semaphore`, which must be waited on before the next
+    /// submission of the frame slot.
+    void submit(uint32_t frame_index, bool wait_for_graphics);
+
+    /// For a graphics submission to signal where compute may start.
+    SemaphoreRef start_semaphore(uint32_t frame_index) const;
+
+    /// Signaled when the frame's compute work is done.
+    SemaphoreRef finished_semaphore(uint32_t frame_index) const;
+
+    /// Wait until every submission is done.
+    void wait_idle();
+
+private:
+    struct Frame
+    {
+        UniqueFence fence;
+        UniqueSemaphore start;
+        UniqueSemaphore finished;
+    };
+
+    uint32_t slot(uint32_t frame_index) const;
+
+private:
+    Device _device;
+    uint32_t _family;
+    uint32_t _graphics_family;
+    Queue _queue;
+    UniqueCommandPool _command_pool;
+    std::vector<Frame> _frames;
+    std::vector<CommandBuffer> _command_buffers;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_ASYNC_COMPUTE_H
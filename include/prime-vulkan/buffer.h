@@ -4,6 +4,14 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <vector>
+
+#include <primer/vector.h>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
 
 namespace pr {
 namespace vk {
@@ -30,27 +38,49 @@ public:
 
         void set_sharing_mode(::VkSharingMode mode);
 
+        /// Families sharing the resource with `VK_SHARING_MODE_CONCURRENT`.
+        void set_queue_family_indices(const pr::Vector<uint32_t>& indices);
+
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
         CType _info;
+        std::vector<uint32_t> _queue_family_indices;
     };
 
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *buffer)
         {
-            vkDestroyBuffer(this->_p_device, *buffer, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_BUFFER);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_BUFFER, *buffer);
+            } else {
+                vkDestroyBuffer(this->_p_device, *buffer, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -63,6 +93,9 @@ private:
     std::shared_ptr<CType> _buffer;
 };
 
+using UniqueBuffer = Unique<Buffer>;
+using BufferRef = Ref<Buffer>;
+
 
 class BufferCopy
 {
@@ -72,6 +105,10 @@ public:
 public:
     BufferCopy();
 
+    void set_src_offset(VkDeviceSize offset);
+
+    void set_dst_offset(VkDeviceSize offset);
+
     void set_size(VkDeviceSize size);
 
     CType c_struct() const;
@@ -3,21 +3,24 @@
 
 #include <vulkan/vulkan.h>
 
+#include <initializer_list>
+
+#include <prime-vulkan/dispatch.h>
+#include <prime-vulkan/handle.h>
 #include <prime-vulkan/render-pass.h>
+#include <prime-vulkan/pipeline.h>
+#include <prime-vulkan/descriptor.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/command-pool.h>
+#include <prime-vulkan/query-pool.h>
+#include <prime-vulkan/structure-chain.h>
 
 namespace pr {
 namespace vk {
 
-class CommandPool;
-
-class Pipeline;
-
 class Device;
 
-class Buffer;
-
-class BufferCopy;
-
 class CommandBuffer
 {
     friend Device;
@@ -34,10 +37,20 @@ public:
 
         void set_command_pool(const CommandPool& command_pool);
 
+        void set_command_pool(CommandPoolRef command_pool);
+
         void set_level(::VkCommandBufferLevel level);
 
         void set_command_buffer_count(uint32_t count);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -54,6 +67,14 @@ public:
 
         void set_flags(VkCommandBufferUsageFlags flags);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -71,6 +92,9 @@ public:
     void bind_pipeline(::VkPipelineBindPoint bind_point,
                        const Pipeline& pipeline);
 
+    void bind_pipeline(::VkPipelineBindPoint bind_point,
+                       PipelineRef pipeline);
+
     void set_viewport(uint32_t first_viewport,
                       const pr::Vector<::VkViewport>& viewports);
 
@@ -88,18 +112,162 @@ public:
                       int32_t vertex_offset,
                       uint32_t first_instance);
 
+    /// `draw_count` `VkDrawIndirectCommand`s read from `buffer`, `stride`
+    /// bytes apart. More than one draw needs the multiDrawIndirect
+    /// feature.
+    void draw_indirect(BufferRef buffer,
+                       ::VkDeviceSize offset,
+                       uint32_t draw_count,
+                       uint32_t stride = sizeof(::VkDrawIndirectCommand));
+
+    /// `draw_count` `VkDrawIndexedIndirectCommand`s read from `buffer`.
+    void draw_indexed_indirect(BufferRef buffer,
+        ::VkDeviceSize offset,
+        uint32_t draw_count,
+        uint32_t stride = sizeof(::VkDrawIndexedIndirectCommand));
+
+    /// Like `draw_indirect`, with the draw count read as a `uint32_t` from
+    /// `count_buffer` and clamped to `max_draw_count`. Throws
+    /// `std::logic_error` unless `supports_draw_indirect_count`.
+    void draw_indirect_count(BufferRef buffer,
+        ::VkDeviceSize offset,
+        BufferRef count_buffer,
+        ::VkDeviceSize count_offset,
+        uint32_t max_draw_count,
+        uint32_t stride = sizeof(::VkDrawIndirectCommand));
+
+    void draw_indexed_indirect_count(BufferRef buffer,
+        ::VkDeviceSize offset,
+        BufferRef count_buffer,
+        ::VkDeviceSize count_offset,
+        uint32_t max_draw_count,
+        uint32_t stride = sizeof(::VkDrawIndexedIndirectCommand));
+
+    /// Whether the device was created with the Vulkan 1.2
+    /// drawIndirectCount feature or VK_KHR_draw_indirect_count enabled.
+    bool supports_draw_indirect_count() const;
+
+    void dispatch(uint32_t group_count_x,
+                  uint32_t group_count_y,
+                  uint32_t group_count_z);
+
+    /// Group counts read from a `VkDispatchIndirectCommand` in `buffer`.
+    void dispatch_indirect(BufferRef buffer, ::VkDeviceSize offset);
+
     void bind_vertex_buffers(uint32_t first_binding,
                              const pr::Vector<Buffer>& buffers,
                              const pr::Vector<VkDeviceSize>& offsets);
 
+    /// Bind vertex buffers without copying or allocating.
+    void bind_vertex_buffers(uint32_t first_binding,
+                             std::initializer_list<BufferRef> buffers,
+                             std::initializer_list<VkDeviceSize> offsets);
+
     void bind_index_buffer(const Buffer& buffer, VkDeviceSize offset,
                            VkIndexType index_type);
 
+    void bind_index_buffer(BufferRef buffer, VkDeviceSize offset,
+                           VkIndexType index_type);
+
+    void bind_descriptor_sets(::VkPipelineBindPoint bind_point,
+        PipelineLayoutRef layout,
+        uint32_t first_set,
+        std::initializer_list<DescriptorSetRef> sets,
+        std::initializer_list<uint32_t> dynamic_offsets = {});
+
+    /// Update `size` bytes of push constants at `offset` from `values`.
+    void push_constants(PipelineLayoutRef layout,
+                        ::VkShaderStageFlags stage_flags,
+                        uint32_t offset,
+                        uint32_t size,
+                        const void *values);
+
     void copy_buffer(const Buffer& src, Buffer& dst,
         const pr::Vector<BufferCopy>& regions);
 
+    void copy_buffer(BufferRef src, BufferRef dst,
+        const pr::Vector<BufferCopy>& regions);
+
+    /// Fill `size` bytes of `buffer` at `offset` with copies of `data`.
+    /// Both must be multiples of 4, or `size` `VK_WHOLE_SIZE`.
+    void fill_buffer(BufferRef buffer,
+                     ::VkDeviceSize offset,
+                     ::VkDeviceSize size,
+                     uint32_t data);
+
+    /// `dst` must be in `dst_layout`, either
+    /// `VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL` or `VK_IMAGE_LAYOUT_GENERAL`.
+    void copy_buffer_to_image(BufferRef src, ImageRef dst,
+        ::VkImageLayout dst_layout,
+        const pr::Vector<BufferImageCopy>& regions);
+
+    /// `src` must be in `src_layout`, either
+    /// `VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL` or `VK_IMAGE_LAYOUT_GENERAL`.
+    void copy_image_to_buffer(ImageRef src, ::VkImageLayout src_layout,
+        BufferRef dst, const pr::Vector<BufferImageCopy>& regions);
+
+    void blit_image(ImageRef src, ::VkImageLayout src_layout,
+        ImageRef dst, ::VkImageLayout dst_layout,
+        const pr::Vector<::VkImageBlit>& regions,
+        ::VkFilter filter);
+
+    /// Fill mip levels 1 and up of `image` from level 0 with a chain of
+    /// blits. All levels must be in `VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL`
+    /// after level 0 is written, and are left in
+    /// `VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL`. Use `VK_FILTER_NEAREST` for
+    /// formats without linear filtering support.
+    void generate_mipmaps(ImageRef image,
+        ::VkExtent2D extent,
+        uint32_t mip_levels,
+        uint32_t layer_count = 1,
+        ::VkFilter filter = VK_FILTER_LINEAR);
+
     void end_render_pass();
 
+    /// `vkCmdPipelineBarrier`.
+    void pipeline_barrier(::VkPipelineStageFlags src_stage_mask,
+        ::VkPipelineStageFlags dst_stage_mask,
+        ::VkDependencyFlags dependency_flags,
+        const pr::Vector<::VkMemoryBarrier>& memory_barriers,
+        const pr::Vector<::VkBufferMemoryBarrier>& buffer_memory_barriers,
+        const pr::Vector<::VkImageMemoryBarrier>& image_memory_barriers);
+
+    /// `vkCmdPipelineBarrier2`. Without synchronization2 the barriers are
+    /// translated to a single `vkCmdPipelineBarrier` call.
+    void pipeline_barrier2(const ::VkDependencyInfo& dependency_info);
+
+    /// Whether `pipeline_barrier2` maps to `vkCmdPipelineBarrier2`.
+    bool supports_synchronization2() const;
+
+    /// Reset queries before they are used again. Outside of a render pass.
+    void reset_query_pool(QueryPoolRef pool,
+                          uint32_t first_query,
+                          uint32_t query_count);
+
+    /// Write the GPU clock to `query` once the previous commands are done
+    /// with `stage`.
+    void write_timestamp(::VkPipelineStageFlagBits stage,
+                         QueryPoolRef pool,
+                         uint32_t query);
+
+    /// Start an occlusion or pipeline statistics query. Only one query of
+    /// each type can be active at a time.
+    void begin_query(QueryPoolRef pool,
+                     uint32_t query,
+                     ::VkQueryControlFlags flags = 0);
+
+    void end_query(QueryPoolRef pool, uint32_t query);
+
+    /// Copy query results to `dst`, `stride` bytes apart. Outside of a
+    /// render pass.
+    void copy_query_pool_results(QueryPoolRef pool,
+                                 uint32_t first_query,
+                                 uint32_t query_count,
+                                 BufferRef dst,
+                                 ::VkDeviceSize dst_offset,
+                                 ::VkDeviceSize stride,
+                                 ::VkQueryResultFlags flags);
+
     /// Finish recording a command buffer.
     void end();
 
@@ -110,8 +278,12 @@ private:
 
 private:
     CType _command_buffer;
+    /// Owned by the device.
+    const DeviceDispatch *_dispatch;
 };
 
+using CommandBufferRef = Ref<CommandBuffer>;
+
 } // namespace vk
 } // namespace pr
 
@@ -5,6 +5,11 @@
 
 #include <memory>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -28,6 +33,14 @@ public:
 
         void set_flags(::VkCommandPoolCreateFlags flags);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -37,18 +50,28 @@ public:
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *command_pool)
         {
-            vkDestroyCommandPool(this->_p_device, *command_pool, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_COMMAND_POOL);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_COMMAND_POOL, *command_pool);
+            } else {
+                vkDestroyCommandPool(this->_p_device, *command_pool, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -61,6 +84,9 @@ private:
     std::shared_ptr<CType> _command_pool;
 };
 
+using UniqueCommandPool = Unique<CommandPool>;
+using CommandPoolRef = Ref<CommandPool>;
+
 } // namespace vk
 } // namespace pr
 
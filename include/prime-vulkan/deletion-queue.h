@@ -0,0 +1,83 @@
+#ifndef _PRIME_VULKAN_DELETION_QUEUE_H
+#define _PRIME_VULKAN_DELETION_QUEUE_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <deque>
+#include <mutex>
+
+namespace pr {
+namespace vk {
+
+/// Defers `vkDestroy*` calls until the GPU has finished the frame that
+/// might still use the handle.
+///
+/// Set on a device with `Device::set_deletion_queue`. The deleters of the
+/// objects it creates then push their handles here instead of destroying
+/// them. Handles are tagged with the current frame, which may be a frame
+/// counter or a timeline semaphore value, and must not decrease.
+///
+/// A frame loop would look like:
+///
+///     deletion_queue.set_frame(frame);
+///     // Record, submit, release resources...
+///     deletion_queue.collect(last_completed_frame);
+class DeletionQueue
+{
+public:
+    DeletionQueue();
+
+    /// Destroys everything still queued.
+    ~DeletionQueue();
+
+    DeletionQueue(const DeletionQueue&) = delete;
+
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+    /// Tag handles pushed from now on with the given frame.
+    void set_frame(uint64_t frame);
+
+    uint64_t frame() const;
+
+    /// Queue a handle for destruction. Called by the deleters.
+    template<typename Handle>
+    void push(::VkDevice device, ::VkObjectType type, Handle handle)
+    {
+        this->push_handle(device, type, reinterpret_cast<uint64_t>(handle));
+    }
+
+    /// Destroy every handle tagged with a frame up to and including
+    /// `completed_frame`.
+    void collect(uint64_t completed_frame);
+
+    /// Destroy every queued handle. The GPU must be idle.
+    void flush();
+
+    /// Number of handles waiting for destruction.
+    uint64_t size() const;
+
+private:
+    struct Entry
+    {
+        uint64_t frame;
+        ::VkDevice device;
+        ::VkObjectType type;
+        uint64_t handle;
+    };
+
+    void push_handle(::VkDevice device, ::VkObjectType type, uint64_t handle);
+
+    static void destroy(const Entry& entry);
+
+private:
+    mutable std::mutex _mutex;
+    uint64_t _frame;
+    std::deque<Entry> _entries;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_DELETION_QUEUE_H
@@ -4,9 +4,16 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <initializer_list>
+#include <vector>
 
 #include <primer/vector.h>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -53,6 +60,14 @@ public:
         void set_bindings(
             const pr::Vector<DescriptorSetLayout::Binding>& bindings);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -64,18 +79,29 @@ public:
     class Deleter
     {
     public:
-        Deleter(VkDevice p_device)
+        Deleter(VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *set_layout)
         {
-            vkDestroyDescriptorSetLayout(this->_p_device, *set_layout, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, *set_layout);
+            } else {
+                vkDestroyDescriptorSetLayout(this->_p_device,
+                    *set_layout, nullptr);
+            }
         }
 
     private:
         VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -88,6 +114,9 @@ private:
     std::shared_ptr<CType> _layout;
 };
 
+using UniqueDescriptorSetLayout = Unique<DescriptorSetLayout>;
+using DescriptorSetLayoutRef = Ref<DescriptorSetLayout>;
+
 
 /// \brief Wrapper class for `VkDescriptorPool`.
 class DescriptorPool
@@ -129,6 +158,14 @@ public:
 
         void set_max_sets(uint32_t sets);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -140,18 +177,28 @@ public:
     class Deleter
     {
     public:
-        Deleter(VkDevice p_device)
+        Deleter(VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *pool)
         {
-            vkDestroyDescriptorPool(this->_p_device, *pool, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_DESCRIPTOR_POOL, *pool);
+            } else {
+                vkDestroyDescriptorPool(this->_p_device, *pool, nullptr);
+            }
         }
 
     private:
         VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -164,6 +211,9 @@ private:
     std::shared_ptr<CType> _pool;
 };
 
+using UniqueDescriptorPool = Unique<DescriptorPool>;
+using DescriptorPoolRef = Ref<DescriptorPool>;
+
 
 /// \brief Wrapper class for `VkDescriptorSet`.
 class DescriptorSet
@@ -184,10 +234,23 @@ public:
 
         void set_descriptor_pool(const DescriptorPool& pool);
 
+        void set_descriptor_pool(DescriptorPoolRef pool);
+
         void set_descriptor_set_count(uint32_t count);
 
         void set_set_layouts(const pr::Vector<DescriptorSetLayout>& layouts);
 
+        void set_set_layouts(
+            std::initializer_list<DescriptorSetLayoutRef> layouts);
+
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -206,6 +269,49 @@ private:
     std::shared_ptr<DescriptorSet::CType> _set;
 };
 
+using DescriptorSetRef = Ref<DescriptorSet>;
+
+
+/// \brief Wrapper class for `VkWriteDescriptorSet`.
+class WriteDescriptorSet
+{
+public:
+    using CType = VkWriteDescriptorSet;
+
+public:
+    WriteDescriptorSet();
+
+    void set_dst_set(DescriptorSetRef set);
+
+    void set_dst_binding(uint32_t binding);
+
+    void set_dst_array_element(uint32_t element);
+
+    void set_descriptor_type(VkDescriptorType type);
+
+    /// Sets the buffer info list. Count will automatically filled.
+    void set_buffer_infos(const pr::Vector<VkDescriptorBufferInfo>& infos);
+
+    /// Sets the image info list. Count will automatically filled.
+    void set_image_infos(const pr::Vector<VkDescriptorImageInfo>& infos);
+
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
+    CType c_struct() const;
+
+private:
+    CType _write;
+
+    std::vector<VkDescriptorBufferInfo> _buffer_infos;
+    std::vector<VkDescriptorImageInfo> _image_infos;
+};
+
 } // namespace vk
 } // namespace pr
 
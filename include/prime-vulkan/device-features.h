@@ -0,0 +1,86 @@
+#ifndef _PRIME_VULKAN_DEVICE_FEATURES_H
+#define _PRIME_VULKAN_DEVICE_FEATURES_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <prime-vulkan/structure-chain.h>
+
+namespace pr {
+namespace vk {
+
+/// Core features of Vulkan 1.0 to 1.3, as `VkPhysicalDeviceFeatures2`
+/// chained with the 1.1, 1.2 and 1.3 feature structs.
+///
+/// Queried by `PhysicalDevice::features2`, and enabled with
+/// `Device::CreateInfo::set_enabled_features`:
+///
+///     pr::vk::DeviceFeatures features(physical_device.api_version());
+///     features.core().samplerAnisotropy = VK_TRUE;
+///     features.vulkan12().timelineSemaphore = VK_TRUE;
+///
+///     info.set_enabled_features(features);
+///
+/// Only the structs of the API version are chained, as later ones are
+/// not valid for the device. Theirs stay zeroed.
+class DeviceFeatures
+{
+public:
+    /// All features off, for a Vulkan 1.3 device.
+    DeviceFeatures();
+
+    /// All features off, for a device of `api_version`.
+    explicit DeviceFeatures(uint32_t api_version);
+
+    uint32_t api_version() const;
+
+    /// Chain the structs of a device of `api_version`, keeping the
+    /// values.
+    void set_api_version(uint32_t api_version);
+
+    ::VkPhysicalDeviceFeatures& core();
+
+    const ::VkPhysicalDeviceFeatures& core() const;
+
+    /// Chained from Vulkan 1.2.
+    ::VkPhysicalDeviceVulkan11Features& vulkan11();
+
+    const ::VkPhysicalDeviceVulkan11Features& vulkan11() const;
+
+    /// Chained from Vulkan 1.2.
+    ::VkPhysicalDeviceVulkan12Features& vulkan12();
+
+    const ::VkPhysicalDeviceVulkan12Features& vulkan12() const;
+
+    /// Chained from Vulkan 1.3.
+    ::VkPhysicalDeviceVulkan13Features& vulkan13();
+
+    const ::VkPhysicalDeviceVulkan13Features& vulkan13() const;
+
+    /// Structs chained after the last struct of the API version.
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
+    /// The `VkPhysicalDeviceFeatures2`.
+    void* head();
+
+    const void* head() const;
+
+private:
+    uint32_t _api_version;
+    StructureChain<::VkPhysicalDeviceFeatures2,
+                   ::VkPhysicalDeviceVulkan11Features,
+                   ::VkPhysicalDeviceVulkan12Features,
+                   ::VkPhysicalDeviceVulkan13Features> _chain;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_DEVICE_FEATURES_H
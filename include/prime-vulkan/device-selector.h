@@ -0,0 +1,135 @@
+#ifndef _PRIME_VULKAN_DEVICE_SELECTOR_H
+#define _PRIME_VULKAN_DEVICE_SELECTOR_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <primer/vector.h>
+#include <primer/string.h>
+
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/device-features.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/queue-topology.h>
+#include <prime-vulkan/surface.h>
+
+namespace pr {
+namespace vk {
+
+class Instance;
+
+/// Picks the physical device that suits the application best, and
+/// creates the device with its queues.
+///
+///     DeviceSelector::CreateInfo info;
+///     info.set_required_extensions({ VK_KHR_SWAPCHAIN_EXTENSION_NAME });
+///     info.set_optional_extensions({ VK_EXT_MEMORY_BUDGET_EXTENSION_NAME });
+///     info.set_surface(surface);
+///
+///     auto selection = DeviceSelector(instance, info).select();
+///     selection.graphics_queue.submit(submits, fence);
+///
+/// Devices without the required API version, extensions or features, or
+/// without a graphics queue family, or a family presenting to the surface,
+/// are left out. The others are ranked by type, then by the number of
+/// dedicated compute and transfer families, then by device local memory,
+/// then by the number of optional extensions.
+class DeviceSelector
+{
+public:
+    class CreateInfo
+    {
+        friend DeviceSelector;
+    public:
+        /// Discrete GPUs first, Vulkan 1.0, nothing required.
+        CreateInfo();
+
+        /// Ranked before the other types. Then discrete, integrated,
+        /// virtual and CPU devices.
+        void set_preferred_type(::VkPhysicalDeviceType type);
+
+        /// Minimum version the device can be used with, as of
+        /// `PhysicalDevice::api_version`.
+        void set_api_version(uint32_t version);
+
+        /// Enabled on the device.
+        void set_required_extensions(const pr::Vector<pr::String>& names);
+
+        /// Enabled on the device when it supports them.
+        void set_optional_extensions(const pr::Vector<pr::String>& names);
+
+        /// Enabled on the device.
+        void set_required_features(const DeviceFeatures& features);
+
+        /// A queue family must present to the surface, and
+        /// `VK_KHR_swapchain` is required. Only used by the constructor of
+        /// `DeviceSelector`.
+        void set_surface(const Surface& surface);
+
+    private:
+        ::VkPhysicalDeviceType _preferred_type;
+        uint32_t _api_version;
+        pr::Vector<pr::String> _required_extensions;
+        pr::Vector<pr::String> _optional_extensions;
+        DeviceFeatures _features;
+        const Surface *_surface;
+    };
+
+    /// The created device and one queue of each family. Families can be
+    /// the same, and then so are their queues.
+    struct Selection
+    {
+        PhysicalDevice physical_device;
+        Device device;
+        QueueTopology topology;
+        /// Presents to the surface, or the graphics family without one.
+        uint32_t present_family;
+        Queue graphics_queue;
+        Queue compute_queue;
+        Queue transfer_queue;
+        Queue present_queue;
+        /// Required and supported optional extensions.
+        pr::Vector<pr::String> enabled_extensions;
+    };
+
+public:
+    /// Enumerate and rank the physical devices. Their properties, queue
+    /// families and extensions are queried once each.
+    DeviceSelector(const Instance& instance,
+                   const CreateInfo& info = CreateInfo());
+
+    /// Suitable devices, best first.
+    pr::Vector<PhysicalDevice> candidates() const;
+
+    /// Create the device on the best candidate. Throws
+    /// `std::runtime_error` when no device is suitable.
+    Selection select() const;
+
+private:
+    struct Candidate
+    {
+        PhysicalDevice physical_device;
+        QueueTopology topology;
+        uint32_t present_family;
+        pr::Vector<pr::String> extensions;
+        /// Compared in order, higher first.
+        uint32_t type_rank;
+        uint32_t dedicated_families;
+        ::VkDeviceSize device_local_size;
+        uint32_t optional_extensions;
+    };
+
+    void consider(const PhysicalDevice& physical_device);
+
+private:
+    CreateInfo _info;
+    std::vector<Candidate> _candidates;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_DEVICE_SELECTOR_H
@@ -3,10 +3,18 @@
 
 #include <vulkan/vulkan.h>
 
+#include <vector>
+#include <initializer_list>
+
 #include <primer/vector.h>
 #include <primer/string.h>
 
+#include <prime-vulkan/arena.h>
+#include <prime-vulkan/device-features.h>
+#include <prime-vulkan/dispatch.h>
+#include <prime-vulkan/deletion-queue.h>
 #include <prime-vulkan/queue.h>
+#include <prime-vulkan/image.h>
 #include <prime-vulkan/swapchain.h>
 #include <prime-vulkan/shader-module.h>
 #include <prime-vulkan/pipeline.h>
@@ -19,6 +27,9 @@
 #include <prime-vulkan/buffer.h>
 #include <prime-vulkan/memory.h>
 #include <prime-vulkan/descriptor.h>
+#include <prime-vulkan/query-pool.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
 
 namespace pr {
 namespace vk {
@@ -39,7 +50,7 @@ public:
 
         QueueCreateInfo(const QueueCreateInfo& other);
 
-        ~QueueCreateInfo();
+        QueueCreateInfo& operator=(const QueueCreateInfo& other);
 
         void set_queue_count(uint32_t count);
 
@@ -47,20 +58,32 @@ public:
 
         void set_queue_priorities(const Vector<float>& priorities);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkDeviceQueueCreateInfo c_struct() const;
 
     private:
         ::VkDeviceQueueCreateInfo _info;
+        uint32_t _priority_count;
 
-        float *_priorities;
+        Arena _arena;
     };
 
     class CreateInfo
     {
+        friend PhysicalDevice;
     public:
         CreateInfo();
 
-        ~CreateInfo();
+        CreateInfo(const CreateInfo& other);
+
+        CreateInfo& operator=(const CreateInfo& other);
 
         // void set_queue_create_info_count(uint32_t count);
 
@@ -69,17 +92,39 @@ public:
 
         void set_enabled_features(::VkPhysicalDeviceFeatures features);
 
+        /// Enable the features through a copy of the chain, to which
+        /// `set_next` appends. Before Vulkan 1.1 only the core features.
+        void set_enabled_features(const DeviceFeatures& features);
+
         void set_enabled_extension_names(const Vector<String>& names);
 
+        /// Extension structs, such as a `StructureChain`'s `head`. With
+        /// `VkPhysicalDeviceFeatures2` in the chain, leave the enabled
+        /// features unset.
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkDeviceCreateInfo c_struct() const;
 
+    private:
+        /// Leave out the feature structs of versions after `api_version`.
+        void limit_api_version(uint32_t api_version);
+
     private:
         ::VkDeviceCreateInfo _info;
 
-        ::VkDeviceQueueCreateInfo *_queue_create_infos;
         ::VkPhysicalDeviceFeatures _enabled_features;
-        Vector<String> _enabled_extension_names;
-        const char **_pp_enabled_extension_names;
+        DeviceFeatures _features;
+        /// Whether `_features` heads the chain.
+        bool _chain_features;
+        const void *_next;
+
+        Arena _arena;
     };
 
 public:
@@ -92,6 +137,8 @@ public:
 
     Vector<Image> images_for(const Swapchain& swapchain) const;
 
+    Image create_image(const Image::CreateInfo& info) const;
+
     ImageView create_image_view(const ImageView::CreateInfo& info) const;
 
     ShaderModule
@@ -105,6 +152,10 @@ public:
     pr::Vector<Pipeline> create_graphics_pipelines(
         const pr::Vector<GraphicsPipelineCreateInfo>& infos) const;
 
+    /// `vkCreateComputePipelines`.
+    pr::Vector<Pipeline> create_compute_pipelines(
+        const pr::Vector<ComputePipelineCreateInfo>& infos) const;
+
     RenderPass create_render_pass(const RenderPass::CreateInfo& info) const;
 
     Framebuffer create_framebuffer(const Framebuffer::CreateInfo& info) const;
@@ -143,6 +194,8 @@ public:
 
     MemoryRequirements memory_requirements_for(const Buffer& buffer) const;
 
+    MemoryRequirements memory_requirements_for(const Image& image) const;
+
     DeviceMemory allocate_memory(const MemoryAllocateInfo& info) const;
 
     /// Bind device memory to a buffer object.
@@ -152,6 +205,11 @@ public:
     /// Alias to `bind_buffer_memory`.
     void bind_memory_to_buffer(Buffer&, DeviceMemory&, ::VkDeviceSize);
 
+    /// Bind device memory to an image object.
+    void bind_image_memory(Image& image,
+                           DeviceMemory& memory,
+                           ::VkDeviceSize offset);
+
     void map_memory(DeviceMemory& memory,
                     ::VkDeviceSize offset,
                     ::VkDeviceSize size,
@@ -160,8 +218,141 @@ public:
 
     void unmap_memory(DeviceMemory& memory);
 
+    //=================
+    // Unique handles
+    //=================
+
+    // Same as the `create_*` functions above, but the returned handles are
+    // move-only and destroyed when they go out of scope.
+
+    UniqueSwapchain
+    create_unique_swapchain(const Swapchain::CreateInfo& info) const;
+
+    UniqueImage create_unique_image(const Image::CreateInfo& info) const;
+
+    UniqueImageView
+    create_unique_image_view(const ImageView::CreateInfo& info) const;
+
+    UniqueShaderModule
+    create_unique_shader_module(const ShaderModule::CreateInfo& info) const;
+
+    UniquePipelineLayout create_unique_pipeline_layout(
+        const PipelineLayout::CreateInfo& info) const;
+
+    std::vector<UniquePipeline> create_unique_graphics_pipelines(
+        const pr::Vector<GraphicsPipelineCreateInfo>& infos) const;
+
+    std::vector<UniquePipeline> create_unique_compute_pipelines(
+        const pr::Vector<ComputePipelineCreateInfo>& infos) const;
+
+    UniqueRenderPass
+    create_unique_render_pass(const RenderPass::CreateInfo& info) const;
+
+    UniqueFramebuffer
+    create_unique_framebuffer(const Framebuffer::CreateInfo& info) const;
+
+    UniqueCommandPool
+    create_unique_command_pool(const CommandPool::CreateInfo& info) const;
+
+    UniqueSemaphore
+    create_unique_semaphore(const Semaphore::CreateInfo& info) const;
+
+    UniqueFence create_unique_fence(const Fence::CreateInfo& info) const;
+
+    UniqueBuffer create_unique_buffer(const Buffer::CreateInfo& info) const;
+
+    UniqueDescriptorSetLayout create_unique_descriptor_set_layout(
+        const DescriptorSetLayout::CreateInfo& info) const;
+
+    UniqueDescriptorPool create_unique_descriptor_pool(
+        const DescriptorPool::CreateInfo& info) const;
+
+    UniqueDeviceMemory
+    allocate_unique_memory(const MemoryAllocateInfo& info) const;
+
+    UniqueQueryPool
+    create_unique_query_pool(const QueryPool::CreateInfo& info) const;
+
+    //=================
+    // Ref overloads
+    //=================
+
+    void wait_for_fences(std::initializer_list<FenceRef> fences,
+                         bool wait_all,
+                         uint64_t timeout) const;
+
+    void reset_fences(std::initializer_list<FenceRef> fences) const;
+
+    /// `vkGetFenceStatus`. Whether the fence is signaled, without waiting.
+    bool get_fence_status(FenceRef fence) const;
+
+    /// `vkGetQueryPoolResults`. Returns false if some of the results are
+    /// not available and `VK_QUERY_RESULT_WAIT_BIT` is not set.
+    bool get_query_pool_results(QueryPoolRef pool,
+                                uint32_t first_query,
+                                uint32_t query_count,
+                                size_t data_size,
+                                void *data,
+                                ::VkDeviceSize stride,
+                                ::VkQueryResultFlags flags) const;
+
+    uint32_t acquire_next_image(SwapchainRef swapchain,
+                                uint64_t timeout,
+                                SemaphoreRef semaphore) const;
+
+    MemoryRequirements memory_requirements_for(BufferRef buffer) const;
+
+    MemoryRequirements memory_requirements_for(ImageRef image) const;
+
+    void bind_buffer_memory(BufferRef buffer,
+                            DeviceMemoryRef memory,
+                            ::VkDeviceSize offset);
+
+    void bind_image_memory(ImageRef image,
+                           DeviceMemoryRef memory,
+                           ::VkDeviceSize offset);
+
+    void map_memory(DeviceMemoryRef memory,
+                    ::VkDeviceSize offset,
+                    ::VkDeviceSize size,
+                    ::VkMemoryMapFlags flags,
+                    void **data);
+
+    void unmap_memory(DeviceMemoryRef memory);
+
+    /// Make host writes to mapped memory that is not host coherent
+    /// visible to the device.
+    void flush_mapped_memory(DeviceMemoryRef memory,
+                             ::VkDeviceSize offset,
+                             ::VkDeviceSize size) const;
+
+    /// Make device writes to mapped memory that is not host coherent
+    /// visible to the host.
+    void invalidate_mapped_memory(DeviceMemoryRef memory,
+                                  ::VkDeviceSize offset,
+                                  ::VkDeviceSize size) const;
+
+    /// The sets written must not be in use by pending command buffers.
+    void update_descriptor_sets(
+        const pr::Vector<WriteDescriptorSet>& writes) const;
+
     void wait_idle();
 
+    /// Defer destruction of the objects created from now on to the given
+    /// queue. Pass nullptr to destroy them immediately again. The queue
+    /// must outlive those objects.
+    void set_deletion_queue(DeletionQueue *deletion_queue);
+
+    DeletionQueue* deletion_queue() const;
+
+    /// Live objects, device memory in use and memory call counts of the
+    /// library.
+    Statistics statistics() const;
+
+    /// Device-level function table used by this device and the queues and
+    /// command buffers created from it.
+    const DeviceDispatch& dispatch() const;
+
     CType c_ptr();
 
 private:
@@ -169,6 +360,12 @@ private:
 
 private:
     CType _device;
+    std::shared_ptr<const DeviceDispatch> _dispatch;
+    DeletionQueue *_deletion_queue;
+    /// Heap of each memory type, for the statistics. Inline, as devices
+    /// are copied often.
+    uint8_t _memory_heaps[VK_MAX_MEMORY_TYPES];
+    uint32_t _memory_type_count;
 };
 
 } // namespace vk
@@ -0,0 +1,123 @@
+#ifndef _PRIME_VULKAN_DISPATCH_H
+#define _PRIME_VULKAN_DISPATCH_H
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+
+namespace pr {
+namespace vk {
+
+/// Device-level function pointers.
+///
+/// Loaded with `vkGetDeviceProcAddr` so calls go straight to the driver
+/// instead of through the loader's trampolines. A pointer the driver does
+/// not return falls back to the loader's exported function.
+///
+/// Optional functions have no fallback. They are null unless the device
+/// was created with the feature or extension that provides them.
+class DeviceDispatch
+{
+public:
+    /// Load the table for the given device. Without
+    /// PRIME_VULKAN_DEVICE_DISPATCH only the optional functions are loaded
+    /// and the rest are the loader's.
+    static std::shared_ptr<const DeviceDispatch> load(::VkDevice device,
+        const ::VkDeviceCreateInfo& info);
+
+    /// The table of the loader's exported functions.
+    static std::shared_ptr<const DeviceDispatch> loader();
+
+public:
+    // Device.
+    PFN_vkGetDeviceQueue vkGetDeviceQueue;
+    PFN_vkDeviceWaitIdle vkDeviceWaitIdle;
+    PFN_vkCreateSwapchainKHR vkCreateSwapchainKHR;
+    PFN_vkGetSwapchainImagesKHR vkGetSwapchainImagesKHR;
+    PFN_vkAcquireNextImageKHR vkAcquireNextImageKHR;
+    PFN_vkCreateImage vkCreateImage;
+    PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements;
+    PFN_vkBindImageMemory vkBindImageMemory;
+    PFN_vkCreateImageView vkCreateImageView;
+    PFN_vkCreateShaderModule vkCreateShaderModule;
+    PFN_vkCreatePipelineLayout vkCreatePipelineLayout;
+    PFN_vkCreateGraphicsPipelines vkCreateGraphicsPipelines;
+    PFN_vkCreateComputePipelines vkCreateComputePipelines;
+    PFN_vkCreateRenderPass vkCreateRenderPass;
+    PFN_vkCreateFramebuffer vkCreateFramebuffer;
+    PFN_vkCreateCommandPool vkCreateCommandPool;
+    PFN_vkAllocateCommandBuffers vkAllocateCommandBuffers;
+    PFN_vkCreateSemaphore vkCreateSemaphore;
+    PFN_vkCreateFence vkCreateFence;
+    PFN_vkWaitForFences vkWaitForFences;
+    PFN_vkResetFences vkResetFences;
+    PFN_vkGetFenceStatus vkGetFenceStatus;
+    PFN_vkCreateQueryPool vkCreateQueryPool;
+    PFN_vkGetQueryPoolResults vkGetQueryPoolResults;
+    PFN_vkCreateBuffer vkCreateBuffer;
+    PFN_vkGetBufferMemoryRequirements vkGetBufferMemoryRequirements;
+    PFN_vkAllocateMemory vkAllocateMemory;
+    PFN_vkBindBufferMemory vkBindBufferMemory;
+    PFN_vkMapMemory vkMapMemory;
+    PFN_vkUnmapMemory vkUnmapMemory;
+    PFN_vkFlushMappedMemoryRanges vkFlushMappedMemoryRanges;
+    PFN_vkInvalidateMappedMemoryRanges vkInvalidateMappedMemoryRanges;
+    PFN_vkCreateDescriptorSetLayout vkCreateDescriptorSetLayout;
+    PFN_vkCreateDescriptorPool vkCreateDescriptorPool;
+    PFN_vkAllocateDescriptorSets vkAllocateDescriptorSets;
+    PFN_vkUpdateDescriptorSets vkUpdateDescriptorSets;
+
+    // Queue.
+    PFN_vkQueueSubmit vkQueueSubmit;
+    PFN_vkQueuePresentKHR vkQueuePresentKHR;
+    PFN_vkQueueWaitIdle vkQueueWaitIdle;
+
+    // Command buffer.
+    PFN_vkBeginCommandBuffer vkBeginCommandBuffer;
+    PFN_vkResetCommandBuffer vkResetCommandBuffer;
+    PFN_vkEndCommandBuffer vkEndCommandBuffer;
+    PFN_vkCmdBeginRenderPass vkCmdBeginRenderPass;
+    PFN_vkCmdEndRenderPass vkCmdEndRenderPass;
+    PFN_vkCmdBindPipeline vkCmdBindPipeline;
+    PFN_vkCmdSetViewport vkCmdSetViewport;
+    PFN_vkCmdSetScissor vkCmdSetScissor;
+    PFN_vkCmdBindVertexBuffers vkCmdBindVertexBuffers;
+    PFN_vkCmdBindIndexBuffer vkCmdBindIndexBuffer;
+    PFN_vkCmdBindDescriptorSets vkCmdBindDescriptorSets;
+    PFN_vkCmdPushConstants vkCmdPushConstants;
+    PFN_vkCmdDraw vkCmdDraw;
+    PFN_vkCmdDrawIndexed vkCmdDrawIndexed;
+    PFN_vkCmdDrawIndirect vkCmdDrawIndirect;
+    PFN_vkCmdDrawIndexedIndirect vkCmdDrawIndexedIndirect;
+    PFN_vkCmdDispatch vkCmdDispatch;
+    PFN_vkCmdDispatchIndirect vkCmdDispatchIndirect;
+    PFN_vkCmdCopyBuffer vkCmdCopyBuffer;
+    PFN_vkCmdFillBuffer vkCmdFillBuffer;
+    PFN_vkCmdCopyBufferToImage vkCmdCopyBufferToImage;
+    PFN_vkCmdBlitImage vkCmdBlitImage;
+    PFN_vkCmdCopyImageToBuffer vkCmdCopyImageToBuffer;
+    PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier;
+    PFN_vkCmdResetQueryPool vkCmdResetQueryPool;
+    PFN_vkCmdWriteTimestamp vkCmdWriteTimestamp;
+    PFN_vkCmdBeginQuery vkCmdBeginQuery;
+    PFN_vkCmdEndQuery vkCmdEndQuery;
+    PFN_vkCmdCopyQueryPoolResults vkCmdCopyQueryPoolResults;
+
+    // Optional.
+    /// `vkCmdPipelineBarrier2` or `vkCmdPipelineBarrier2KHR`. Null unless
+    /// the synchronization2 feature is enabled.
+    PFN_vkCmdPipelineBarrier2 vkCmdPipelineBarrier2;
+    /// `vkCmdDrawIndirectCount` or `vkCmdDrawIndirectCountKHR`. Null unless
+    /// the drawIndirectCount feature or VK_KHR_draw_indirect_count is
+    /// enabled.
+    PFN_vkCmdDrawIndirectCount vkCmdDrawIndirectCount;
+    PFN_vkCmdDrawIndexedIndirectCount vkCmdDrawIndexedIndirectCount;
+
+private:
+    DeviceDispatch();
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_DISPATCH_H
@@ -5,6 +5,11 @@
 
 #include <memory>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -26,6 +31,14 @@ public:
 
         void set_flags(::VkFenceCreateFlags flags);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -37,18 +50,28 @@ public:
     public:
         Deleter() = delete;
 
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *fence)
         {
-            vkDestroyFence(this->_p_device, *fence, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_FENCE);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_FENCE, *fence);
+            } else {
+                vkDestroyFence(this->_p_device, *fence, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -61,6 +84,9 @@ private:
     std::shared_ptr<CType> _fence;
 };
 
+using UniqueFence = Unique<Fence>;
+using FenceRef = Ref<Fence>;
+
 } // namespace vk
 } // namespace pr
 
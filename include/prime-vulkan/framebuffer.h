@@ -3,11 +3,17 @@
 
 #include <vulkan/vulkan.h>
 
+#include <initializer_list>
 #include <vector>
 #include <memory>
 
 #include <primer/vector.h>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -33,14 +39,26 @@ public:
 
         void set_render_pass(const RenderPass& render_pass);
 
+        void set_render_pass(Ref<RenderPass> render_pass);
+
         void set_attachments(const pr::Vector<ImageView>& attachments);
 
+        void set_attachments(std::initializer_list<Ref<ImageView>> views);
+
         void set_width(uint32_t width);
 
         void set_height(uint32_t height);
 
         void set_layers(uint32_t layers);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -52,18 +70,28 @@ public:
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *framebuffer)
         {
-            vkDestroyFramebuffer(this->_p_device, *framebuffer, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_FRAMEBUFFER);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_FRAMEBUFFER, *framebuffer);
+            } else {
+                vkDestroyFramebuffer(this->_p_device, *framebuffer, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -76,6 +104,9 @@ private:
     std::shared_ptr<CType> _framebuffer;
 };
 
+using UniqueFramebuffer = Unique<Framebuffer>;
+using FramebufferRef = Ref<Framebuffer>;
+
 } // namespace vk
 } // namespace pr
 
@@ -0,0 +1,141 @@
+#ifndef _PRIME_VULKAN_GPU_CULLING_H
+#define _PRIME_VULKAN_GPU_CULLING_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/shader-module.h>
+#include <prime-vulkan/pipeline.h>
+#include <prime-vulkan/descriptor.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/resource-state.h>
+
+namespace pr {
+namespace vk {
+
+/// Frustum culling and draw compaction on the GPU.
+///
+/// A compute shader, shaders/gpu-culling.comp, tests the bounding sphere
+/// of every instance against the frustum and appends the draw commands of
+/// the visible ones to a device local draw buffer, counting them. The
+/// draws are then recorded with one indirect call, however many instances
+/// there are:
+///
+///     culling.record(command_buffer, tracker, frame_index,
+///         BufferRef(instances), instance_count,
+///         GpuCulling::Frustum::from_view_projection(view_projection));
+///     // Begin the render pass, bind the pipeline and the mesh buffers.
+///     culling.draw(command_buffer);
+///
+/// Without `vkCmdDrawIndirectCount` the draw buffer is cleared first and
+/// all `max_instances` commands are drawn, the culled ones with no
+/// instances. With the multiDrawIndirect feature that is one call per
+/// 65535 commands, the least `maxDrawIndirectCount` of such devices, and
+/// without it one call per command. The count needs the feature too, and
+/// must stay within `maxDrawIndirectCount`.
+class GpuCulling
+{
+public:
+    /// An element of the instance buffer, in the shader's std430 layout.
+    struct Instance
+    {
+        /// Center in world space, then the radius.
+        float sphere[4];
+        ::VkDrawIndexedIndirectCommand command;
+        uint32_t padding[3];
+    };
+
+    /// Planes as (a, b, c, d) with ax + by + cz + d >= 0 inside.
+    struct Frustum
+    {
+        float planes[6][4];
+
+        /// Extract the normalized planes from a column-major
+        /// view-projection matrix with a depth range of 0 to 1.
+        static Frustum from_view_projection(const float matrix[16]);
+    };
+
+public:
+    /// `shader` is shaders/gpu-culling.comp compiled to SPIR-V.
+    GpuCulling(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        const ShaderModule& shader,
+        uint32_t max_instances,
+        uint32_t frames_in_flight = 2);
+
+    GpuCulling(const GpuCulling&) = delete;
+
+    GpuCulling& operator=(const GpuCulling&) = delete;
+
+    /// Record the culling of the first `instance_count` elements of
+    /// `instances`, outside of a render pass. The buffer needs
+    /// `VK_BUFFER_USAGE_STORAGE_BUFFER_BIT`. The draw and count buffers
+    /// are left in `ResourceState::indirect_buffer()`. The frame's
+    /// previous submission must be done.
+    void record(CommandBuffer& command_buffer,
+                ResourceStateTracker& tracker,
+                uint32_t frame_index,
+                BufferRef instances,
+                uint32_t instance_count,
+                const Frustum& frustum);
+
+    /// Record the draws of the last `record`. Without
+    /// `vkCmdDrawIndirectCount`, `multi_draw` draws up to 65535 commands
+    /// a call, which needs the multiDrawIndirect feature; otherwise one
+    /// call per command.
+    void draw(CommandBuffer& command_buffer, bool multi_draw = true) const;
+
+    /// Draw commands, at `draw_offset()` for the current frame.
+    BufferRef draw_buffer() const;
+
+    ::VkDeviceSize draw_offset() const;
+
+    /// The `uint32_t` draw count, at `count_offset()` for the current
+    /// frame.
+    BufferRef count_buffer() const;
+
+    ::VkDeviceSize count_offset() const;
+
+    uint32_t max_instances() const;
+
+private:
+    /// Create a device local buffer with its own memory.
+    void create_buffer(::VkDeviceSize size,
+        ::VkBufferUsageFlags usage,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        UniqueBuffer& buffer,
+        UniqueDeviceMemory& memory);
+
+private:
+    Device _device;
+    uint32_t _max_instances;
+    uint32_t _frames_in_flight;
+    /// Bytes between frame regions of the draw buffer.
+    ::VkDeviceSize _draw_region_size;
+    /// Frame slot of the last `record`.
+    uint32_t _frame;
+    /// Whether the last `record` was for `vkCmdDrawIndexedIndirectCount`.
+    bool _draw_count;
+    UniqueBuffer _draws;
+    UniqueDeviceMemory _draws_memory;
+    UniqueBuffer _counts;
+    UniqueDeviceMemory _counts_memory;
+    UniqueDescriptorSetLayout _set_layout;
+    UniqueDescriptorPool _descriptor_pool;
+    std::vector<DescriptorSet> _sets;
+    UniquePipelineLayout _pipeline_layout;
+    UniquePipeline _pipeline;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_GPU_CULLING_H
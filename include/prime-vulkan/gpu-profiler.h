@@ -0,0 +1,154 @@
+#ifndef _PRIME_VULKAN_GPU_PROFILER_H
+#define _PRIME_VULKAN_GPU_PROFILER_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/query-pool.h>
+#include <prime-vulkan/command-buffer.h>
+
+namespace pr {
+namespace vk {
+
+/// Times named scopes of command buffers with GPU timestamps.
+///
+/// Each frame writes its timestamps to its own range of a query pool. The
+/// range is read back when the frame comes around again, `frame_latency`
+/// frames later, without waiting: a frame whose results are not ready by
+/// then is dropped.
+///
+///     profiler.begin_frame(command_buffer);
+///     profiler.begin_scope(command_buffer, "shadows");
+///     // ...
+///     profiler.end_scope(command_buffer);
+///     profiler.end_frame();
+///
+///     for (auto& timing: profiler.results()) {
+///         printf("%*s%s %.3f ms\n", timing.depth * 2, "", timing.name,
+///             timing.milliseconds);
+///     }
+///
+/// Scopes nest, and must be closed in the frame they were opened in. The
+/// command buffers of a frame must be submitted to queues of one family
+/// with non-zero `timestamp_valid_bits`.
+///
+/// Scopes read back are also added to the current `Tracer` as GPU spans.
+/// The GPU clock is not calibrated against the CPU: a frame's first scope
+/// is placed at the time of its `begin_frame`.
+class GpuProfiler
+{
+public:
+    class CreateInfo
+    {
+        friend GpuProfiler;
+    public:
+        /// 64 scopes per frame, read back 3 frames later, 1 ns ticks.
+        CreateInfo();
+
+        /// `timestampPeriod` of `PhysicalDevice::limits`, nanoseconds per
+        /// tick.
+        void set_timestamp_period(float period);
+
+        /// `QueueFamilyProperties::timestamp_valid_bits` of the queue
+        /// family the frames are submitted to.
+        void set_timestamp_valid_bits(uint32_t bits);
+
+        void set_max_scopes(uint32_t count);
+
+        /// Frames between recording and reading back. At least the
+        /// number of frames in flight.
+        void set_frame_latency(uint32_t frames);
+
+    private:
+        float _timestamp_period;
+        uint32_t _timestamp_valid_bits;
+        uint32_t _max_scopes;
+        uint32_t _frame_latency;
+    };
+
+    struct Timing
+    {
+        const char *name;
+        /// Number of enclosing scopes.
+        uint32_t depth;
+        /// Start relative to the first scope of the frame.
+        double start_milliseconds;
+        double milliseconds;
+    };
+
+public:
+    GpuProfiler(const Device& device, const CreateInfo& info);
+
+    GpuProfiler(const GpuProfiler&) = delete;
+
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /// Read back the frame recorded `frame_latency` frames ago and reset
+    /// its queries for this frame. Outside of a render pass. The previous
+    /// submission of this frame slot must be done.
+    void begin_frame(CommandBuffer& command_buffer);
+
+    void end_frame();
+
+    /// Open a scope. `name` must outlive the profiler, like a string
+    /// literal. Scopes beyond `max_scopes` are ignored.
+    void begin_scope(CommandBuffer& command_buffer,
+        const char *name,
+        ::VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+
+    /// Close the innermost open scope.
+    void end_scope(CommandBuffer& command_buffer,
+        ::VkPipelineStageFlagBits stage =
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    /// Scopes of the latest frame read back, in the order they were
+    /// opened.
+    const std::vector<Timing>& results() const;
+
+    /// Number of frames begun, including the current one.
+    uint64_t frame() const;
+
+private:
+    struct Scope
+    {
+        const char *name;
+        uint32_t depth;
+    };
+
+    struct Frame
+    {
+        std::vector<Scope> scopes;
+        /// Whether the frame has timestamps left to read back.
+        bool pending;
+        /// `Tracer::now()` at `begin_frame`.
+        uint64_t cpu_time;
+    };
+
+    /// First query of the current frame's range.
+    uint32_t first_query() const;
+
+    void resolve(Frame& frame, uint32_t first_query);
+
+private:
+    Device _device;
+    UniqueQueryPool _pool;
+    double _timestamp_period;
+    uint64_t _timestamp_mask;
+    uint32_t _max_scopes;
+    std::vector<Frame> _frames;
+    uint64_t _frame;
+    /// Open scopes of the current frame, innermost last.
+    std::vector<uint32_t> _open;
+    std::vector<uint64_t> _timestamps;
+    std::vector<Timing> _results;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_GPU_PROFILER_H
@@ -0,0 +1,172 @@
+#ifndef _PRIME_VULKAN_HANDLE_H
+#define _PRIME_VULKAN_HANDLE_H
+
+#include <vulkan/vulkan.h>
+
+#include <utility>
+#include <type_traits>
+
+namespace pr {
+namespace vk {
+
+template<typename T>
+class Unique;
+
+/// Non-owning view of a Vulkan handle.
+///
+/// Trivially copyable and no larger than the handle itself. The owner must
+/// outlive the view.
+template<typename T>
+class Ref
+{
+public:
+    using CType = typename T::CType;
+
+public:
+    Ref() noexcept
+        : _handle(VK_NULL_HANDLE)
+    {
+    }
+
+    /// Explicit to keep `{object}` unambiguous between `pr::Vector<T>` and
+    /// `std::initializer_list<Ref<T>>` overloads.
+    explicit Ref(const T& object) noexcept
+        : _handle(object.c_ptr())
+    {
+    }
+
+    /// A template so that `Unique<T>` is only instantiated for handle
+    /// types that have a `Deleter`.
+    template<typename U, typename = std::enable_if_t<
+        std::is_same<U, Unique<T>>::value>>
+    Ref(const U& unique) noexcept
+        : _handle(unique.c_ptr())
+    {
+    }
+
+    static Ref from_c_ptr(CType handle) noexcept
+    {
+        Ref ref;
+        ref._handle = handle;
+
+        return ref;
+    }
+
+    CType c_ptr() const noexcept
+    {
+        return this->_handle;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return this->_handle != VK_NULL_HANDLE;
+    }
+
+    /// View an array of refs as an array of raw handles, without copying.
+    static const CType* c_ptrs(const Ref *refs) noexcept
+    {
+        static_assert(sizeof(Ref) == sizeof(CType),
+            "Ref must have the same layout as the raw handle.");
+
+        return reinterpret_cast<const CType*>(refs);
+    }
+
+private:
+    CType _handle;
+};
+
+
+/// Move-only owner of a Vulkan handle.
+///
+/// The handle and its `T::Deleter` are stored inline, so there is no heap
+/// allocation and no reference count.
+template<typename T>
+class Unique
+{
+public:
+    using CType = typename T::CType;
+    using Deleter = typename T::Deleter;
+
+public:
+    Unique() noexcept
+        : _handle(VK_NULL_HANDLE),
+          _deleter(VK_NULL_HANDLE)
+    {
+    }
+
+    Unique(CType handle, Deleter deleter) noexcept
+        : _handle(handle),
+          _deleter(deleter)
+    {
+    }
+
+    Unique(const Unique&) = delete;
+
+    Unique(Unique&& other) noexcept
+        : _handle(other._handle),
+          _deleter(other._deleter)
+    {
+        other._handle = VK_NULL_HANDLE;
+    }
+
+    ~Unique()
+    {
+        this->reset();
+    }
+
+    Unique& operator=(const Unique&) = delete;
+
+    Unique& operator=(Unique&& other) noexcept
+    {
+        if (this != &other) {
+            this->reset();
+            this->_handle = other._handle;
+            this->_deleter = other._deleter;
+            other._handle = VK_NULL_HANDLE;
+        }
+
+        return *this;
+    }
+
+    Ref<T> ref() const noexcept
+    {
+        return Ref<T>(*this);
+    }
+
+    CType c_ptr() const noexcept
+    {
+        return this->_handle;
+    }
+
+    /// Give up the ownership without destroying the handle.
+    CType release() noexcept
+    {
+        CType handle = this->_handle;
+        this->_handle = VK_NULL_HANDLE;
+
+        return handle;
+    }
+
+    /// Destroy the owned handle, if any.
+    void reset() noexcept
+    {
+        if (this->_handle != VK_NULL_HANDLE) {
+            this->_deleter(&(this->_handle));
+            this->_handle = VK_NULL_HANDLE;
+        }
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return this->_handle != VK_NULL_HANDLE;
+    }
+
+private:
+    CType _handle;
+    Deleter _deleter;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_HANDLE_H
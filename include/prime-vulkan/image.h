@@ -0,0 +1,240 @@
+#ifndef _PRIME_VULKAN_IMAGE_H
+#define _PRIME_VULKAN_IMAGE_H
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+#include <vector>
+
+#include <primer/vector.h>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
+namespace pr {
+namespace vk {
+
+class Device;
+
+class Image
+{
+    friend Device;
+public:
+    using CType = ::VkImage;
+
+    class CreateInfo
+    {
+    public:
+        using CType = ::VkImageCreateInfo;
+
+    public:
+        /// A single 2D image with one mip level, one layer and one sample,
+        /// optimal tiling and exclusive sharing.
+        CreateInfo();
+
+        void set_flags(::VkImageCreateFlags flags);
+
+        void set_image_type(::VkImageType type);
+
+        void set_format(::VkFormat format);
+
+        void set_extent(::VkExtent3D extent);
+
+        void set_mip_levels(uint32_t levels);
+
+        void set_array_layers(uint32_t layers);
+
+        void set_samples(::VkSampleCountFlagBits samples);
+
+        void set_tiling(::VkImageTiling tiling);
+
+        void set_usage(::VkImageUsageFlags usage);
+
+        void set_sharing_mode(::VkSharingMode mode);
+
+        /// Families sharing the resource with `VK_SHARING_MODE_CONCURRENT`.
+        void set_queue_family_indices(const pr::Vector<uint32_t>& indices);
+
+        void set_initial_layout(::VkImageLayout layout);
+
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
+        CType c_struct() const;
+
+    private:
+        CType _info;
+        std::vector<uint32_t> _queue_family_indices;
+    };
+
+    class Deleter
+    {
+    public:
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
+        {
+            this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
+        }
+
+        void operator()(CType *image)
+        {
+            Statistics::object_destroyed(VK_OBJECT_TYPE_IMAGE);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_IMAGE, *image);
+            } else {
+                vkDestroyImage(this->_p_device, *image, nullptr);
+            }
+        }
+
+    private:
+        ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
+    };
+
+public:
+    ::VkImage c_ptr() const;
+
+private:
+    Image();
+
+private:
+    /// Swapchain images are owned by the swapchain and have no deleter.
+    std::shared_ptr<CType> _image;
+};
+
+using UniqueImage = Unique<Image>;
+using ImageRef = Ref<Image>;
+
+
+class ImageView
+{
+    friend Device;
+public:
+    using CType = ::VkImageView;
+
+    class CreateInfo
+    {
+    public:
+        CreateInfo();
+
+        void set_image(const Image& image);
+
+        void set_image(ImageRef image);
+
+        void set_view_type(::VkImageViewType type);
+
+        void set_format(::VkFormat format);
+
+        void set_components(::VkComponentSwizzle r,
+                            ::VkComponentSwizzle g,
+                            ::VkComponentSwizzle b,
+                            ::VkComponentSwizzle a);
+
+        void set_subresource_range(::VkImageSubresourceRange range);
+
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
+        ::VkImageViewCreateInfo c_struct() const;
+
+    private:
+        ::VkImageViewCreateInfo _info;
+    };
+
+    class Deleter
+    {
+    public:
+        Deleter() = delete;
+
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
+        {
+            this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
+        }
+
+        void operator()(::VkImageView *image_view)
+        {
+            Statistics::object_destroyed(VK_OBJECT_TYPE_IMAGE_VIEW);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_IMAGE_VIEW, *image_view);
+            } else {
+                vkDestroyImageView(this->_p_device, *image_view, nullptr);
+            }
+        }
+
+    private:
+        ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
+    };
+
+public:
+    ~ImageView();
+
+    CType c_ptr() const;
+
+private:
+    ImageView();
+
+private:
+    std::shared_ptr<CType> _view;
+};
+
+using UniqueImageView = Unique<ImageView>;
+using ImageViewRef = Ref<ImageView>;
+
+
+/// A region copied between a buffer and an image.
+class BufferImageCopy
+{
+public:
+    using CType = ::VkBufferImageCopy;
+
+public:
+    /// Tightly packed, mip level 0 and layer 0 of the color aspect.
+    BufferImageCopy();
+
+    void set_buffer_offset(::VkDeviceSize offset);
+
+    /// In texels. 0 means tightly packed.
+    void set_buffer_row_length(uint32_t length);
+
+    /// In texels. 0 means tightly packed.
+    void set_buffer_image_height(uint32_t height);
+
+    void set_image_subresource(::VkImageAspectFlags aspect_mask,
+                               uint32_t mip_level,
+                               uint32_t base_array_layer,
+                               uint32_t layer_count);
+
+    void set_image_offset(::VkOffset3D offset);
+
+    void set_image_extent(::VkExtent3D extent);
+
+    CType c_struct() const;
+
+private:
+    CType _copy;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_IMAGE_H
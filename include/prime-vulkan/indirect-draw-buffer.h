@@ -0,0 +1,92 @@
+#ifndef _PRIME_VULKAN_INDIRECT_DRAW_BUFFER_H
+#define _PRIME_VULKAN_INDIRECT_DRAW_BUFFER_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/command-buffer.h>
+
+namespace pr {
+namespace vk {
+
+/// Packs `VkDrawIndexedIndirectCommand`s into a persistently mapped
+/// buffer, so a frame's draws are recorded with one call.
+///
+/// The buffer holds a region per frame in flight. Commands are written
+/// straight to the mapped memory of the frame's region:
+///
+///     draws.begin(frame_index);
+///     for (auto& mesh: meshes) {
+///         draws.push(mesh.index_count, 1, mesh.first_index,
+///             mesh.vertex_offset, mesh.instance);
+///     }
+///     draws.draw(command_buffer);
+///
+/// The buffer is also usable as a storage buffer, so a compute shader can
+/// read or rewrite the commands of `offset()` before they are drawn.
+class IndirectDrawBuffer
+{
+public:
+    /// Room for `capacity` commands per frame. Throws `VulkanError` with
+    /// `VK_ERROR_FEATURE_NOT_PRESENT` if no memory type is host visible.
+    IndirectDrawBuffer(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        uint32_t capacity,
+        uint32_t frames_in_flight = 2);
+
+    IndirectDrawBuffer(const IndirectDrawBuffer&) = delete;
+
+    IndirectDrawBuffer& operator=(const IndirectDrawBuffer&) = delete;
+
+    /// Start writing the region of `frame_index`, dropping its previous
+    /// commands. The frame's previous submission must be done.
+    void begin(uint32_t frame_index);
+
+    /// Append a command. Returns false if the region is full.
+    bool push(const ::VkDrawIndexedIndirectCommand& command);
+
+    bool push(uint32_t index_count,
+              uint32_t instance_count,
+              uint32_t first_index,
+              int32_t vertex_offset,
+              uint32_t first_instance);
+
+    /// Record the pushed commands. With `multi_draw` a single
+    /// `draw_indexed_indirect` call, which needs the multiDrawIndirect
+    /// feature; otherwise one call per command.
+    void draw(CommandBuffer& command_buffer, bool multi_draw = true);
+
+    /// Commands pushed since `begin`.
+    uint32_t count() const;
+
+    uint32_t capacity() const;
+
+    BufferRef buffer() const;
+
+    /// Byte offset of the current frame's region.
+    ::VkDeviceSize offset() const;
+
+private:
+    Device _device;
+    uint32_t _capacity;
+    uint32_t _frames_in_flight;
+    uint32_t _count;
+    /// Bytes between frame regions.
+    ::VkDeviceSize _region_size;
+    ::VkDeviceSize _offset;
+    UniqueBuffer _buffer;
+    UniqueDeviceMemory _memory;
+    uint8_t *_data;
+    bool _coherent;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_INDIRECT_DRAW_BUFFER_H
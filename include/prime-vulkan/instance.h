@@ -8,7 +8,9 @@
 #include <primer/vector.h>
 #include <primer/string.h>
 
+#include <prime-vulkan/arena.h>
 #include <prime-vulkan/surface.h>
+#include <prime-vulkan/structure-chain.h>
 
 namespace pr {
 namespace vk {
@@ -49,14 +51,28 @@ public:
     public:
         CreateInfo();
 
-        ~CreateInfo();
+        CreateInfo(const CreateInfo& other);
+
+        CreateInfo& operator=(const CreateInfo& other);
+
+        /// The highest Vulkan version the application uses, which limits
+        /// the version of the devices. 1.0 when unset.
+        void set_api_version(uint32_t version);
 
         void set_enabled_extension_names(const pr::Vector<pr::String>& names);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
     private:
         ::VkInstanceCreateInfo _info;
-        pr::Vector<pr::String> _enabled_extension_names;
-        const char **_pp_enabled_extension_names;
+
+        Arena _arena;
     };
 
 public:
@@ -67,6 +83,9 @@ public:
 
     ~Instance();
 
+    /// `apiVersion` of the create info, or 1.0 without one.
+    uint32_t api_version() const;
+
     /// Create a Wayland specific surface with the given info.
     Surface create_wayland_surface(
         const Surface::WaylandSurfaceCreateInfo& info
@@ -76,6 +95,7 @@ public:
 
 private:
     std::shared_ptr<CType> _instance;
+    uint32_t _api_version;
 };
 
 } // namespace vk
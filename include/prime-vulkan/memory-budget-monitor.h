@@ -0,0 +1,112 @@
+#ifndef _PRIME_VULKAN_MEMORY_BUDGET_MONITOR_H
+#define _PRIME_VULKAN_MEMORY_BUDGET_MONITOR_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+
+namespace pr {
+namespace vk {
+
+/// Polls the memory budget of each heap and calls an eviction hook when
+/// the usage goes over a fraction of the budget, before the driver starts
+/// paging.
+///
+///     MemoryBudgetMonitor monitor(physical_device, device, info);
+///     monitor.set_eviction_hook([&](const auto& heap) {
+///         auto resident = streamer.resident_memory();
+///         if (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+///             streamer.set_memory_budget(
+///                 resident - std::min(resident, heap.excess));
+///         }
+///     });
+///
+///     // Once per frame.
+///     monitor.update();
+///
+/// Enable `VK_EXT_memory_budget` on the device when
+/// `PhysicalDevice::supports_extension` reports it. Without it the usage
+/// is only the memory allocated through the library, from
+/// `Device::statistics`.
+class MemoryBudgetMonitor
+{
+public:
+    class CreateInfo
+    {
+        friend MemoryBudgetMonitor;
+    public:
+        /// 90% of the budget, polled every 30 frames.
+        CreateInfo();
+
+        /// Fraction of a heap's budget over which the hook is called.
+        void set_threshold(float fraction);
+
+        /// Frames between polls. The budget query is not free, and the
+        /// values only change as memory is allocated and freed.
+        void set_poll_interval(uint32_t frames);
+
+    private:
+        float _threshold;
+        uint32_t _poll_interval;
+    };
+
+    struct Heap
+    {
+        uint32_t index;
+        ::VkMemoryHeapFlags flags;
+        ::VkDeviceSize size;
+        ::VkDeviceSize budget;
+        ::VkDeviceSize usage;
+        /// Usage over the threshold, or 0. What the hook should free.
+        ::VkDeviceSize excess;
+    };
+
+    /// Called from `update` or `poll` for each heap over the threshold.
+    using EvictionHook = std::function<void(const Heap& heap)>;
+
+public:
+    MemoryBudgetMonitor(const PhysicalDevice& physical_device,
+                        const Device& device,
+                        const CreateInfo& info = CreateInfo());
+
+    void set_eviction_hook(EvictionHook hook);
+
+    /// Count a frame, and poll every `poll_interval` frames.
+    void update();
+
+    /// Query the budget now and call the hook for each heap over the
+    /// threshold.
+    void poll();
+
+    /// Heaps as of the last poll.
+    const std::vector<Heap>& heaps() const;
+
+    /// Bytes that can still be allocated from the heap of the memory type
+    /// before it goes over the threshold, as of the last poll.
+    ::VkDeviceSize available(uint32_t memory_type) const;
+
+    /// Whether the budget is estimated, without `VK_EXT_memory_budget`.
+    bool is_estimate() const;
+
+private:
+    PhysicalDevice _physical_device;
+    Device _device;
+    CreateInfo _info;
+    EvictionHook _hook;
+    /// Heap of each memory type.
+    std::vector<uint32_t> _memory_heaps;
+    std::vector<Heap> _heaps;
+    bool _estimate;
+    uint64_t _frame;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_MEMORY_BUDGET_MONITOR_H
@@ -5,6 +5,11 @@
 
 #include <memory>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -46,6 +51,14 @@ public:
 
     void set_memory_type_index(uint32_t index);
 
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
     CType c_struct() const;
 
 private:
@@ -62,18 +75,36 @@ public:
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        /// `memory_type` and `size` of the allocation, for `Statistics`.
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr,
+                uint32_t memory_type = 0,
+                ::VkDeviceSize size = 0)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
+            this->_memory_type = memory_type;
+            this->_size = size;
         }
 
         void operator()(CType *memory)
         {
-            vkFreeMemory(this->_p_device, *memory, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_DEVICE_MEMORY);
+            Statistics::memory_freed(this->_memory_type, this->_size);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_DEVICE_MEMORY, *memory);
+            } else {
+                vkFreeMemory(this->_p_device, *memory, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
+        uint32_t _memory_type;
+        ::VkDeviceSize _size;
     };
 
 public:
@@ -86,6 +117,9 @@ private:
     std::shared_ptr<CType> _memory;
 };
 
+using UniqueDeviceMemory = Unique<DeviceMemory>;
+using DeviceMemoryRef = Ref<DeviceMemory>;
+
 } // namespace vk
 } // namespace pr
 
@@ -0,0 +1,71 @@
+#ifndef _PRIME_VULKAN_MIPMAP_GENERATOR_H
+#define _PRIME_VULKAN_MIPMAP_GENERATOR_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/resource-state.h>
+
+namespace pr {
+namespace vk {
+
+/// Generates the mip chains of many images in one command buffer.
+///
+/// The blits of the same level of every image share their barriers, so
+/// a batch of N images with up to L levels records L barriers instead of
+/// N * L. Whether a format supports linear filtering is queried once and
+/// cached; formats without it are blitted with the nearest filter.
+///
+///     generator.add(ImageRef(albedo), VK_FORMAT_R8G8B8A8_SRGB, extent, 10);
+///     generator.add(ImageRef(normal), VK_FORMAT_R8G8B8A8_UNORM, extent, 10);
+///     generator.record(command_buffer, tracker, ResourceState::shader_read(
+///         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT));
+class MipmapGenerator
+{
+public:
+    MipmapGenerator(const PhysicalDevice& physical_device);
+
+    /// Whether `format` supports `VK_FILTER_LINEAR` with optimal tiling.
+    bool supports_linear_filter(::VkFormat format);
+
+    /// Queue an image whose level 0 is written. It must have been created
+    /// with transfer source and destination usage.
+    void add(ImageRef image,
+             ::VkFormat format,
+             ::VkExtent2D extent,
+             uint32_t mip_levels,
+             uint32_t layer_count = 1);
+
+    /// Record the queued images and leave them in `final_state`. `tracker`
+    /// supplies the state of level 0.
+    void record(CommandBuffer& command_buffer,
+                ResourceStateTracker& tracker,
+                const ResourceState& final_state);
+
+private:
+    struct Pending
+    {
+        ImageRef image;
+        ::VkExtent2D extent;
+        uint32_t mip_levels;
+        uint32_t layer_count;
+        ::VkFilter filter;
+    };
+
+private:
+    PhysicalDevice _physical_device;
+    std::unordered_map<::VkFormat, bool> _linear_filter;
+    std::vector<Pending> _pending;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_MIPMAP_GENERATOR_H
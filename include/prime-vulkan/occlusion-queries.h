@@ -0,0 +1,73 @@
+#ifndef _PRIME_VULKAN_OCCLUSION_QUERIES_H
+#define _PRIME_VULKAN_OCCLUSION_QUERIES_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/query-readback.h>
+
+namespace pr {
+namespace vk {
+
+/// Occlusion queries indexed by object, read a few frames later without
+/// waiting.
+///
+///     occlusion.begin_frame(command_buffer);
+///     // In the render pass, draw each object's bounds:
+///     occlusion.begin(command_buffer, object_id);
+///     command_buffer.draw_indexed(36, 1, 0, 0, 0);
+///     occlusion.end(command_buffer, object_id);
+///     // After the render pass:
+///     occlusion.end_frame(command_buffer);
+///
+///     if (!occlusion.visible(object_id)) {
+///         // Skip the object.
+///     }
+///
+/// Results are `frame_latency` frames old, so a visibility system should
+/// treat objects that just came into view as visible.
+class OcclusionQueries
+{
+public:
+    /// `precise` counts the samples exactly, which needs the
+    /// occlusionQueryPrecise feature. Otherwise only zero and non-zero
+    /// counts are told apart.
+    OcclusionQueries(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        uint32_t max_queries,
+        uint32_t frame_latency = 3,
+        bool precise = false);
+
+    /// Read the results of the frame `frame_latency` frames ago and reset
+    /// the queries. Outside of a render pass.
+    void begin_frame(CommandBuffer& command_buffer);
+
+    void begin(CommandBuffer& command_buffer, uint32_t index);
+
+    void end(CommandBuffer& command_buffer, uint32_t index);
+
+    /// Outside of a render pass.
+    void end_frame(CommandBuffer& command_buffer);
+
+    /// Samples that passed for `index` in the latest frame read, or -1 if
+    /// it was not queried.
+    int64_t samples(uint32_t index) const;
+
+    /// Whether any sample passed. True if `index` was not queried.
+    bool visible(uint32_t index) const;
+
+    uint32_t max_queries() const;
+
+private:
+    QueryReadback _readback;
+    ::VkQueryControlFlags _flags;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_OCCLUSION_QUERIES_H
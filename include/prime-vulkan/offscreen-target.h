@@ -0,0 +1,142 @@
+#ifndef _PRIME_VULKAN_OFFSCREEN_TARGET_H
+#define _PRIME_VULKAN_OFFSCREEN_TARGET_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <initializer_list>
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/queue.h>
+#include <prime-vulkan/semaphore.h>
+#include <prime-vulkan/fence.h>
+
+namespace pr {
+namespace vk {
+
+/// Images to render to without a surface, e.g. on a server with a CPU
+/// driver.
+///
+/// Owns a set of color images, and optionally depth images, with their
+/// memory and views. `acquire_next_image` and `present` stand in for the
+/// swapchain functions so the same frame loop drives both:
+///
+///     uint32_t index = target.acquire_next_image(queue, UINT64_MAX,
+///         SemaphoreRef(image_available));
+///     // Submit rendering to target.color_view(index), waiting for
+///     // image_available and signaling render_finished.
+///     target.present(queue, index, { SemaphoreRef(render_finished) });
+///
+/// An image is handed out again only after the GPU finished the frame
+/// that presented it, which keeps the CPU at most `image_count` frames
+/// ahead.
+class OffscreenTarget
+{
+public:
+    class CreateInfo
+    {
+        friend OffscreenTarget;
+    public:
+        /// Two RGBA8 color images without depth.
+        CreateInfo();
+
+        void set_image_count(uint32_t count);
+
+        void set_extent(::VkExtent2D extent);
+
+        void set_color_format(::VkFormat format);
+
+        /// Color attachment and transfer source by default, so the images
+        /// can be read back.
+        void set_color_usage(::VkImageUsageFlags usage);
+
+        /// `VK_FORMAT_UNDEFINED`, the default, creates no depth images.
+        void set_depth_format(::VkFormat format);
+
+    private:
+        uint32_t _image_count;
+        ::VkExtent2D _extent;
+        ::VkFormat _color_format;
+        ::VkImageUsageFlags _color_usage;
+        ::VkFormat _depth_format;
+    };
+
+public:
+    OffscreenTarget(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        const CreateInfo& info);
+
+    /// Waits for the frames still using the images.
+    ~OffscreenTarget();
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    /// Index of the next image. Waits until the frame that last presented
+    /// it is done, then signals `semaphore` on `queue`. Throws
+    /// `VulkanError` with `VK_TIMEOUT` if the wait times out.
+    uint32_t acquire_next_image(Queue& queue,
+                                uint64_t timeout,
+                                SemaphoreRef semaphore);
+
+    /// Give an acquired image back once `wait_semaphores` are signaled.
+    void present(Queue& queue,
+                 uint32_t image_index,
+                 std::initializer_list<SemaphoreRef> wait_semaphores);
+
+    uint32_t image_count() const;
+
+    ::VkExtent2D extent() const;
+
+    ::VkFormat color_format() const;
+
+    ::VkFormat depth_format() const;
+
+    ImageRef color_image(uint32_t index) const;
+
+    ImageViewRef color_view(uint32_t index) const;
+
+    /// Null without a depth format.
+    ImageRef depth_image(uint32_t index) const;
+
+    /// Null without a depth format.
+    ImageViewRef depth_view(uint32_t index) const;
+
+    /// Wait for every presented frame.
+    void wait_idle();
+
+private:
+    struct Attachment
+    {
+        UniqueImage image;
+        UniqueDeviceMemory memory;
+        UniqueImageView view;
+    };
+
+    Attachment create_attachment(
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        ::VkFormat format,
+        ::VkImageUsageFlags usage,
+        ::VkImageAspectFlags aspect_mask);
+
+private:
+    Device _device;
+    CreateInfo _info;
+    std::vector<Attachment> _colors;
+    std::vector<Attachment> _depths;
+    /// Signaled when the frame that presented the image is done.
+    std::vector<UniqueFence> _fences;
+    uint32_t _next_image;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_OFFSCREEN_TARGET_H
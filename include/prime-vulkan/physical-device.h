@@ -3,9 +3,13 @@
 
 #include <vulkan/vulkan.h>
 
+#include <memory>
+
 #include <primer/vector.h>
 
 #include <prime-vulkan/device.h>
+#include <prime-vulkan/device-features.h>
+#include <prime-vulkan/structure-chain.h>
 #include <prime-vulkan/surface.h>
 
 namespace pr {
@@ -23,6 +27,10 @@ public:
 
     uint32_t queue_count() const;
 
+    /// Meaningful bits of timestamps written on the family's queues, or 0
+    /// without timestamp support.
+    uint32_t timestamp_valid_bits() const;
+
 private:
     QueueFamilyProperties();
 
@@ -44,6 +52,11 @@ public:
 
         pr::Vector<::VkMemoryType> memory_types() const;
 
+        /// Index of the first memory type allowed by `type_bits` that has
+        /// all of `properties`, or -1.
+        int32_t find_memory_type(uint32_t type_bits,
+                                 ::VkMemoryPropertyFlags properties) const;
+
         CType c_struct() const;
 
     private:
@@ -53,9 +66,72 @@ public:
         CType _properties;
     };
 
+    /// Core properties of Vulkan 1.0 to 1.3, from
+    /// `vkGetPhysicalDeviceProperties2` with the 1.1, 1.2 and 1.3 property
+    /// structs chained up to `api_version()`. Those of a later version
+    /// are zeroed.
+    class Properties
+    {
+        friend PhysicalDevice;
+    public:
+        const ::VkPhysicalDeviceProperties& core() const;
+
+        const ::VkPhysicalDeviceLimits& limits() const;
+
+        const ::VkPhysicalDeviceVulkan11Properties& vulkan11() const;
+
+        const ::VkPhysicalDeviceVulkan12Properties& vulkan12() const;
+
+        const ::VkPhysicalDeviceVulkan13Properties& vulkan13() const;
+
+    private:
+        Properties();
+
+    private:
+        StructureChain<::VkPhysicalDeviceProperties2,
+                       ::VkPhysicalDeviceVulkan11Properties,
+                       ::VkPhysicalDeviceVulkan12Properties,
+                       ::VkPhysicalDeviceVulkan13Properties> _chain;
+    };
+
+    /// Per-heap budget and usage of the whole process, from
+    /// `VK_EXT_memory_budget`.
+    ///
+    /// Without the extension or a Vulkan 1.1 device, the budget of each
+    /// heap is estimated as 80% of its size and the usage is zero.
+    class MemoryBudget
+    {
+        friend PhysicalDevice;
+    public:
+        uint32_t heap_count() const;
+
+        ::VkDeviceSize heap_size(uint32_t heap) const;
+
+        /// Memory the process can use from the heap before allocations
+        /// fail or the driver starts paging.
+        ::VkDeviceSize heap_budget(uint32_t heap) const;
+
+        /// Memory the process uses from the heap, by any means.
+        ::VkDeviceSize heap_usage(uint32_t heap) const;
+
+        /// Whether the budget is estimated from the heap sizes.
+        bool is_estimate() const;
+
+    private:
+        MemoryBudget();
+
+    private:
+        uint32_t _heap_count;
+        ::VkDeviceSize _heap_sizes[VK_MAX_MEMORY_HEAPS];
+        ::VkDeviceSize _heap_budgets[VK_MAX_MEMORY_HEAPS];
+        ::VkDeviceSize _heap_usages[VK_MAX_MEMORY_HEAPS];
+        bool _estimate;
+    };
+
 public:
     PhysicalDevice(const PhysicalDevice& other);
 
+    /// Empty without Vulkan devices. See `DeviceSelector` to pick one.
     static Vector<PhysicalDevice> enumerate(const Instance& instance);
 
     /// Get the list of queue family properties.
@@ -65,6 +141,44 @@ public:
     /// Using `vk_` function.
     MemoryProperties memory_properties() const;
 
+    /// Using `vkGetPhysicalDeviceMemoryProperties2` function with
+    /// `VkPhysicalDeviceMemoryBudgetPropertiesEXT` chained when the
+    /// extension was available at enumeration. The values
+    /// change as the process and others allocate, so query again instead
+    /// of keeping the result.
+    MemoryBudget memory_budget() const;
+
+    /// The version the device can be used with: the lower of its
+    /// `apiVersion` and the instance's.
+    uint32_t api_version() const;
+
+    /// Cached `properties2().core()`.
+    ::VkPhysicalDeviceProperties properties() const;
+
+    /// Queried once when enumerated, and shared by copies.
+    const Properties& properties2() const;
+
+    /// Cached `properties2().limits()`, such as
+    /// `minUniformBufferOffsetAlignment` and `timestampPeriod`.
+    const ::VkPhysicalDeviceLimits& limits() const;
+
+    /// Cached `features2().core()`.
+    ::VkPhysicalDeviceFeatures features() const;
+
+    /// Supported features, queried once when enumerated with
+    /// `vkGetPhysicalDeviceFeatures2`, and shared by copies.
+    const DeviceFeatures& features2() const;
+
+    /// Using `vkEnumerateDeviceExtensionProperties` function.
+    Vector<::VkExtensionProperties> extension_properties() const;
+
+    /// Whether the device extension is available. Using
+    /// `vkEnumerateDeviceExtensionProperties` function.
+    bool supports_extension(const char *name) const;
+
+    /// Using `vkGetPhysicalDeviceFormatProperties` function.
+    ::VkFormatProperties format_properties(::VkFormat format) const;
+
     Device create_device(const Device::CreateInfo& create_info) const;
 
     /// Using `vkGetPhysicalDeviceSurfaceCapabilitiesKHR` function.
@@ -88,8 +202,16 @@ public:
 private:
     PhysicalDevice();
 
+    /// Fill the caches.
+    void query();
+
 private:
     ::VkPhysicalDevice _device;
+    uint32_t _instance_api_version;
+    std::shared_ptr<const Properties> _properties;
+    std::shared_ptr<const DeviceFeatures> _features;
+    /// Whether `VK_EXT_memory_budget` is available, for `memory_budget`.
+    bool _memory_budget;
 };
 
 } // namespace vk
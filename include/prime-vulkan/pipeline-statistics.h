@@ -0,0 +1,82 @@
+#ifndef _PRIME_VULKAN_PIPELINE_STATISTICS_H
+#define _PRIME_VULKAN_PIPELINE_STATISTICS_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/query-readback.h>
+
+namespace pr {
+namespace vk {
+
+/// Counts vertices and shader invocations per pass with pipeline
+/// statistics queries. Needs the pipelineStatisticsQuery feature.
+///
+///     statistics.begin_frame(command_buffer);
+///     statistics.begin_pass(command_buffer, "opaque");
+///     // Record the pass.
+///     statistics.end_pass(command_buffer);
+///     statistics.end_frame(command_buffer);
+///
+///     for (auto& report: statistics.results()) {
+///         double overdraw = double(report.fragment_shader_invocations) /
+///             (width * height);
+///     }
+///
+/// Passes do not nest. A pass begins and ends in one command buffer,
+/// either both outside of a render pass or both in the same subpass.
+class PipelineStatistics
+{
+public:
+    struct Report
+    {
+        const char *name;
+        uint64_t input_assembly_vertices;
+        uint64_t vertex_shader_invocations;
+        uint64_t clipping_primitives;
+        uint64_t fragment_shader_invocations;
+        uint64_t compute_shader_invocations;
+    };
+
+public:
+    PipelineStatistics(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        uint32_t max_passes = 32,
+        uint32_t frame_latency = 3);
+
+    /// Read the reports of the frame `frame_latency` frames ago and reset
+    /// the queries. Outside of a render pass.
+    void begin_frame(CommandBuffer& command_buffer);
+
+    /// `name` must outlive the object, like a string literal. Passes
+    /// beyond `max_passes` are not counted.
+    void begin_pass(CommandBuffer& command_buffer, const char *name);
+
+    void end_pass(CommandBuffer& command_buffer);
+
+    /// Outside of a render pass.
+    void end_frame(CommandBuffer& command_buffer);
+
+    /// Reports of the latest frame read, in the order the passes began.
+    const std::vector<Report>& results() const;
+
+private:
+    QueryReadback _readback;
+    /// Pass names of each frame slot.
+    std::vector<std::vector<const char*>> _names;
+    uint64_t _frame;
+    /// Index of the open pass, or -1.
+    int64_t _open;
+    std::vector<Report> _results;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_PIPELINE_STATISTICS_H
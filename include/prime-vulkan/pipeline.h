@@ -8,6 +8,12 @@
 
 #include <primer/string.h>
 
+#include <prime-vulkan/arena.h>
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -86,17 +92,30 @@ public:
     public:
         ShaderStageCreateInfo();
 
+        ShaderStageCreateInfo(const ShaderStageCreateInfo& other);
+
+        ShaderStageCreateInfo& operator=(const ShaderStageCreateInfo& other);
+
         void set_stage(::VkShaderStageFlagBits stage);
 
         void set_module(const ShaderModule& shader_module);
 
         void set_name(const pr::String& name);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkPipelineShaderStageCreateInfo c_struct() const;
 
     private:
         ::VkPipelineShaderStageCreateInfo _info;
-        pr::String _name;
+
+        Arena _arena;
     };
 
     /// A wrapper class for `VkPipelineDynamicStateCreateInfo` struct.
@@ -110,17 +129,26 @@ public:
 
         DynamicStateCreateInfo(const DynamicStateCreateInfo& other);
 
-        ~DynamicStateCreateInfo();
+        DynamicStateCreateInfo& operator=(
+            const DynamicStateCreateInfo& other);
 
         /// Sets `.pDynamicStates` and automatically fills the count field.
         void set_dynamic_states(const pr::Vector<::VkDynamicState>& states);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkPipelineDynamicStateCreateInfo c_struct() const;
 
     private:
         ::VkPipelineDynamicStateCreateInfo _info;
 
-        ::VkDynamicState *_states;
+        Arena _arena;
     };
 
     /// A wrapper class for `VkPipelineVertexInputStateCreateInfo` struct.
@@ -132,6 +160,11 @@ public:
     public:
         VertexInputStateCreateInfo();
 
+        VertexInputStateCreateInfo(const VertexInputStateCreateInfo& other);
+
+        VertexInputStateCreateInfo& operator=(
+            const VertexInputStateCreateInfo& other);
+
         /// Set the vertex input binding descriptions.
         /// Count will automatically filled.
         void set_vertex_binding_descriptions(
@@ -142,13 +175,20 @@ public:
         void set_vertex_attribute_descriptions(
             const pr::Vector<VertexInputAttributeDescription>& descriptions);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
         CType _info;
 
-        std::vector<VertexInputBindingDescription::CType> _bindings;
-        std::vector<VertexInputAttributeDescription::CType> _attributes;
+        Arena _arena;
     };
 
     /// A wrapper class for `VkPipelineInputAssemblyStateCreateInfo` struct.
@@ -164,6 +204,14 @@ public:
 
         void set_primitive_restart_enable(bool enable);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -185,6 +233,14 @@ public:
         /// Set scissor count for dynamic state.
         void set_scissor_count(uint32_t count);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -214,6 +270,14 @@ public:
 
         void set_depth_bias_enable(bool enable);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -233,6 +297,14 @@ public:
 
         void set_rasterization_samples(::VkSampleCountFlagBits samples);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -267,7 +339,10 @@ public:
     public:
         ColorBlendStateCreateInfo();
 
-        ~ColorBlendStateCreateInfo();
+        ColorBlendStateCreateInfo(const ColorBlendStateCreateInfo& other);
+
+        ColorBlendStateCreateInfo& operator=(
+            const ColorBlendStateCreateInfo& other);
 
         /// Set `.logicOp` field.
         ///
@@ -280,30 +355,48 @@ public:
 
         void set_blend_constants(float r, float g, float b, float a);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
         CType _info;
 
-        ::VkPipelineColorBlendAttachmentState *_p_attachments;
+        Arena _arena;
     };
 
     /// Custom deleter used by a logical device when creating pipelines.
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *pipeline)
         {
-            vkDestroyPipeline(this->_p_device, *pipeline, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_PIPELINE);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_PIPELINE, *pipeline);
+            } else {
+                vkDestroyPipeline(this->_p_device, *pipeline, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 //===================
@@ -325,6 +418,9 @@ private:
     std::shared_ptr<CType> _pipeline;
 };
 
+using UniquePipeline = Unique<Pipeline>;
+using PipelineRef = Ref<Pipeline>;
+
 
 /// A wrapper class for `VkGraphicsPipelineCreateInfo` struct.
 class GraphicsPipelineCreateInfo
@@ -335,6 +431,11 @@ public:
 public:
     GraphicsPipelineCreateInfo();
 
+    GraphicsPipelineCreateInfo(const GraphicsPipelineCreateInfo& other);
+
+    GraphicsPipelineCreateInfo& operator=(
+        const GraphicsPipelineCreateInfo& other);
+
     void set_stages(const pr::Vector<Pipeline::ShaderStageCreateInfo>& stages);
 
     void set_vertex_input_state(const Pipeline::VertexInputStateCreateInfo& info);
@@ -353,19 +454,42 @@ public:
 
     void set_layout(const PipelineLayout& layout);
 
+    void set_layout(Ref<PipelineLayout> layout);
+
     void set_render_pass(const RenderPass& render_pass);
 
+    void set_render_pass(Ref<RenderPass> render_pass);
+
     void set_subpass(uint32_t subpass);
 
     void set_base_pipeline_handle(const Pipeline& pipeline_handle);
 
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
     CType c_struct() const;
 
+private:
+    // Copy what the stages and the states point to into the arena, so the
+    // create info does not depend on the objects it was set from.
+
+    void copy_arrays(Pipeline::ShaderStageCreateInfo::CType *stages,
+                     uint32_t count);
+
+    void copy_arrays(Pipeline::VertexInputStateCreateInfo::CType& state);
+
+    void copy_arrays(Pipeline::ColorBlendStateCreateInfo::CType& state);
+
+    void copy_arrays(Pipeline::DynamicStateCreateInfo::CType& state);
+
 private:
     CType _info;
 
-    pr::Vector<Pipeline::ShaderStageCreateInfo> _stages;
-    std::vector<Pipeline::ShaderStageCreateInfo::CType> _vk_stages;
     Pipeline::VertexInputStateCreateInfo::CType _vertex_input_state;
     Pipeline::InputAssemblyStateCreateInfo::CType _input_assembly_state;
     Pipeline::ViewportStateCreateInfo::CType _viewport_state;
@@ -376,6 +500,8 @@ private:
     ::VkPipelineLayout _layout;
     ::VkRenderPass _render_pass;
     ::VkPipeline _pipeline_handle;
+
+    Arena _arena;
 };
 
 
@@ -400,10 +526,11 @@ public:
     public:
         CreateInfo();
 
+        CreateInfo(const CreateInfo& other);
+
+        CreateInfo& operator=(const CreateInfo& other);
+
         /// Sets the set layout list. Count will automatically filled.
-        ///
-        /// TODO: Currently only accepts 0 length Vector.
-        /// Others not implemented.
         void set_set_layouts(
             const pr::Vector<::VkDescriptorSetLayout>& set_layouts);
 
@@ -411,18 +538,23 @@ public:
             const pr::Vector<DescriptorSetLayout>& set_layouts);
 
         /// Sets the push constant range list. Count will automatically filled.
-        ///
-        /// TODO: Currently only accepts 0 length Vector.
-        /// Others not implemented.
         void set_push_constant_range(
             const pr::Vector<::VkPushConstantRange>& push_constant_range);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
         CType _info;
 
-        pr::Vector<VkDescriptorSetLayout> _set_layouts;
+        Arena _arena;
     };
 
     class Deleter
@@ -430,18 +562,28 @@ public:
     public:
         Deleter() = delete;
 
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *layout)
         {
-            vkDestroyPipelineLayout(this->_p_device, *layout, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_PIPELINE_LAYOUT, *layout);
+            } else {
+                vkDestroyPipelineLayout(this->_p_device, *layout, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 //=================
@@ -463,6 +605,47 @@ private:
     std::shared_ptr<CType> _layout;
 };
 
+using UniquePipelineLayout = Unique<PipelineLayout>;
+using PipelineLayoutRef = Ref<PipelineLayout>;
+
+
+/// A wrapper class for `VkComputePipelineCreateInfo` struct.
+class ComputePipelineCreateInfo
+{
+public:
+    using CType = ::VkComputePipelineCreateInfo;
+
+public:
+    ComputePipelineCreateInfo();
+
+    ComputePipelineCreateInfo(const ComputePipelineCreateInfo& other);
+
+    ComputePipelineCreateInfo& operator=(
+        const ComputePipelineCreateInfo& other);
+
+    void set_stage(const Pipeline::ShaderStageCreateInfo& stage);
+
+    void set_layout(const PipelineLayout& layout);
+
+    void set_layout(PipelineLayoutRef layout);
+
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
+    CType c_struct() const;
+
+private:
+    CType _info;
+
+    /// Entry point name the stage points to.
+    Arena _arena;
+};
+
 } // namespace vk
 } // namespace pr
 
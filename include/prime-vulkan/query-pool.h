@@ -0,0 +1,99 @@
+#ifndef _PRIME_VULKAN_QUERY_POOL_H
+#define _PRIME_VULKAN_QUERY_POOL_H
+
+#include <vulkan/vulkan.h>
+
+#include <memory>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
+namespace pr {
+namespace vk {
+
+class Device;
+
+class QueryPool
+{
+    friend Device;
+public:
+    using CType = ::VkQueryPool;
+
+    class CreateInfo
+    {
+    public:
+        using CType = ::VkQueryPoolCreateInfo;
+
+    public:
+        CreateInfo();
+
+        void set_query_type(::VkQueryType type);
+
+        void set_query_count(uint32_t count);
+
+        /// Counters of a `VK_QUERY_TYPE_PIPELINE_STATISTICS` pool.
+        void set_pipeline_statistics(
+            ::VkQueryPipelineStatisticFlags statistics);
+
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
+        CType c_struct() const;
+
+    private:
+        CType _info;
+    };
+
+    class Deleter
+    {
+    public:
+        Deleter() = delete;
+
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
+        {
+            this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
+        }
+
+        void operator()(CType *pool)
+        {
+            Statistics::object_destroyed(VK_OBJECT_TYPE_QUERY_POOL);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_QUERY_POOL, *pool);
+            } else {
+                vkDestroyQueryPool(this->_p_device, *pool, nullptr);
+            }
+        }
+
+    private:
+        ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
+    };
+
+public:
+    CType c_ptr() const;
+
+private:
+    QueryPool();
+
+private:
+    std::shared_ptr<CType> _pool;
+};
+
+using UniqueQueryPool = Unique<QueryPool>;
+using QueryPoolRef = Ref<QueryPool>;
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_QUERY_POOL_H
@@ -0,0 +1,108 @@
+#ifndef _PRIME_VULKAN_QUERY_READBACK_H
+#define _PRIME_VULKAN_QUERY_READBACK_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/query-pool.h>
+#include <prime-vulkan/command-buffer.h>
+
+namespace pr {
+namespace vk {
+
+/// A query pool whose results are copied on the GPU to a host visible
+/// buffer, so reading them never waits.
+///
+/// Each frame has a range of `queries_per_frame` queries and a region of
+/// the buffer. `end_frame` copies the queries used in the frame with one
+/// `vkCmdCopyQueryPoolResults` per run of consecutive indices. The results
+/// are read when the frame slot is begun again, `frame_latency` frames
+/// later:
+///
+///     if (readback.begin_frame(command_buffer)) {
+///         const uint64_t *values = readback.values(0);
+///         // nullptr if query 0 was not used back then.
+///     }
+///     command_buffer.begin_query(readback.pool(), readback.use(0));
+///     // ...
+///     command_buffer.end_query(readback.pool(), readback.query(0));
+///     readback.end_frame(command_buffer);
+class QueryReadback
+{
+public:
+    /// `statistics` is for `VK_QUERY_TYPE_PIPELINE_STATISTICS` pools, and
+    /// sets the number of values per query. Throws `VulkanError` with
+    /// `VK_ERROR_FEATURE_NOT_PRESENT` if no memory type is host visible.
+    QueryReadback(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        ::VkQueryType type,
+        ::VkQueryPipelineStatisticFlags statistics,
+        uint32_t queries_per_frame,
+        uint32_t frame_latency = 3);
+
+    QueryReadback(const QueryReadback&) = delete;
+
+    QueryReadback& operator=(const QueryReadback&) = delete;
+
+    /// Move to the next frame slot and reset its queries. Outside of a
+    /// render pass. Returns whether the slot holds results from
+    /// `frame_latency` frames ago, which stay readable until this frame is
+    /// submitted. The slot's previous submission must be done.
+    bool begin_frame(CommandBuffer& command_buffer);
+
+    /// Mark `index` as used in the current frame. Returns its query.
+    uint32_t use(uint32_t index);
+
+    /// Query of `index` in the current frame.
+    uint32_t query(uint32_t index) const;
+
+    /// Record the copy of the used queries and make it visible to the
+    /// host. Outside of a render pass. Every used query must have ended.
+    void end_frame(CommandBuffer& command_buffer);
+
+    /// The values of `index` in the frame read by `begin_frame`, or
+    /// nullptr if it was not used.
+    const uint64_t* values(uint32_t index) const;
+
+    /// 64-bit values per query.
+    uint32_t values_per_query() const;
+
+    uint32_t queries_per_frame() const;
+
+    QueryPoolRef pool() const;
+
+private:
+    /// First query of the current frame's range.
+    uint32_t first_query() const;
+
+private:
+    Device _device;
+    UniqueQueryPool _pool;
+    UniqueBuffer _buffer;
+    UniqueDeviceMemory _memory;
+    const uint64_t *_data;
+    bool _coherent;
+    uint32_t _values_per_query;
+    uint32_t _queries_per_frame;
+    uint32_t _frame_latency;
+    uint64_t _frame;
+    /// Indices used in each frame slot.
+    std::vector<std::vector<bool>> _used;
+    /// Indices used in the frame read by `begin_frame`.
+    std::vector<bool> _read_used;
+    /// Slot of the frame read by `begin_frame`.
+    uint32_t _read_slot;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_QUERY_READBACK_H
@@ -0,0 +1,61 @@
+#ifndef _PRIME_VULKAN_QUEUE_TOPOLOGY_H
+#define _PRIME_VULKAN_QUEUE_TOPOLOGY_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <primer/vector.h>
+
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+
+namespace pr {
+namespace vk {
+
+/// The queue families to use for graphics, async compute and transfers.
+///
+/// Prefers a compute family without graphics, and a transfer family with
+/// neither graphics nor compute, which usually maps to the DMA engines.
+/// Falls back to the graphics family when there is none.
+///
+///     QueueTopology topology(physical_device);
+///     Device::CreateInfo info;
+///     info.set_queue_create_infos(topology.queue_create_infos());
+///     auto device = physical_device.create_device(info);
+///     auto transfer_queue = device.queue_for(topology.transfer_family(), 0);
+class QueueTopology
+{
+public:
+    QueueTopology(const PhysicalDevice& physical_device);
+
+    QueueTopology(const pr::Vector<QueueFamilyProperties>& families);
+
+    uint32_t graphics_family() const;
+
+    uint32_t compute_family() const;
+
+    uint32_t transfer_family() const;
+
+    /// Whether transfers run on a family other than graphics.
+    bool has_dedicated_transfer() const;
+
+    /// Whether compute runs on a family other than graphics.
+    bool has_async_compute() const;
+
+    /// One queue of each distinct family.
+    pr::Vector<Device::QueueCreateInfo> queue_create_infos() const;
+
+private:
+    void select(const pr::Vector<QueueFamilyProperties>& families);
+
+private:
+    uint32_t _graphics_family;
+    uint32_t _compute_family;
+    uint32_t _transfer_family;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_QUEUE_TOPOLOGY_H
@@ -3,13 +3,18 @@
 
 #include <vulkan/vulkan.h>
 
-#include <vector>
+#include <initializer_list>
 
 #include <primer/vector.h>
 
+#include <prime-vulkan/arena.h>
+#include <prime-vulkan/dispatch.h>
+#include <prime-vulkan/handle.h>
 #include <prime-vulkan/semaphore.h>
+#include <prime-vulkan/fence.h>
 #include <prime-vulkan/command-buffer.h>
 #include <prime-vulkan/swapchain.h>
+#include <prime-vulkan/structure-chain.h>
 
 namespace pr {
 namespace vk {
@@ -18,8 +23,6 @@ class SubmitInfo;
 
 class PresentInfo;
 
-class Fence;
-
 class Device;
 
 class Queue
@@ -31,6 +34,8 @@ public:
 public:
     void submit(const pr::Vector<SubmitInfo>& submits, const Fence& fence);
 
+    void submit(const pr::Vector<SubmitInfo>& submits, FenceRef fence);
+
     /// Submit the queue without a fence.
     void submit(const pr::Vector<SubmitInfo>& submits);
 
@@ -45,9 +50,13 @@ private:
 
 private:
     ::VkQueue _queue;
+    /// Owned by the device.
+    const DeviceDispatch *_dispatch;
 };
 
 
+/// The arrays set are copied into the info's arena, inline for a typical
+/// submit, so the arguments need not outlive it. Copies are deep.
 class SubmitInfo
 {
 public:
@@ -56,27 +65,45 @@ public:
 public:
     SubmitInfo();
 
+    SubmitInfo(const SubmitInfo& other);
+
+    SubmitInfo& operator=(const SubmitInfo& other);
+
     void set_wait_semaphores(const pr::Vector<Semaphore>& semaphores);
 
+    void set_wait_semaphores(std::initializer_list<SemaphoreRef> semaphores);
+
     void set_wait_dst_stage_mask(
         const pr::Vector<::VkPipelineStageFlags>& mask);
 
     void set_command_buffers(const pr::Vector<CommandBuffer>& command_buffers);
 
+    void set_command_buffers(
+        std::initializer_list<CommandBufferRef> command_buffers);
+
     void set_signal_semaphores(const pr::Vector<Semaphore>& semaphores);
 
+    void set_signal_semaphores(std::initializer_list<SemaphoreRef> semaphores);
+
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
     CType c_struct() const;
 
 private:
     CType _info;
 
-    std::vector<Semaphore::CType> _wait_semaphores;
-    std::vector<::VkPipelineStageFlags> _wait_dst_stage_mask;
-    std::vector<CommandBuffer::CType> _command_buffers;
-    std::vector<Semaphore::CType> _signal_semaphores;
+    Arena _arena;
 };
 
 
+/// The arrays set are copied into the info's arena, inline for a typical
+/// present, so the arguments need not outlive it. Copies are deep.
 class PresentInfo
 {
 public:
@@ -85,20 +112,34 @@ public:
 public:
     PresentInfo();
 
+    PresentInfo(const PresentInfo& other);
+
+    PresentInfo& operator=(const PresentInfo& other);
+
     void set_wait_semaphores(const pr::Vector<Semaphore>& semaphores);
 
+    void set_wait_semaphores(std::initializer_list<SemaphoreRef> semaphores);
+
     void set_swapchains(const pr::Vector<Swapchain>& swapchains);
 
+    void set_swapchains(std::initializer_list<SwapchainRef> swapchains);
+
     void set_image_indices(const pr::Vector<uint32_t>& indices);
 
+    void set_next(const void *next);
+
+    template<typename... Ts>
+    void set_next(const StructureChain<Ts...>& chain)
+    {
+        this->set_next(chain.head());
+    }
+
     CType c_struct() const;
 
 private:
     CType _info;
 
-    std::vector<Semaphore::CType> _wait_semaphores;
-    std::vector<Swapchain::CType> _swapchains;
-    std::vector<uint32_t> _indices;
+    Arena _arena;
 };
 
 } // namespace vk
@@ -0,0 +1,154 @@
+#ifndef _PRIME_VULKAN_READBACK_QUEUE_H
+#define _PRIME_VULKAN_READBACK_QUEUE_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/command-pool.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/queue.h>
+#include <prime-vulkan/semaphore.h>
+#include <prime-vulkan/fence.h>
+
+namespace pr {
+namespace vk {
+
+/// Copies images and buffers back to the host without stalling the GPU.
+///
+/// Each readback takes one of `frame_count` host cached buffers, records
+/// the copy in its own command buffer and submits it. The returned future
+/// is fulfilled from a worker thread once the copy is done, so the caller
+/// keeps rendering while earlier frames are encoded or uploaded:
+///
+///     auto pixels = readback.read_image(queue, target.color_image(index),
+///         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, target.extent(), 4,
+///         { SemaphoreRef(render_finished) });
+///     // Later, on any thread.
+///     encode(pixels.get());
+///
+/// A readback waits for a free buffer when `frame_count` readbacks are
+/// already in flight.
+class ReadbackQueue
+{
+public:
+    class CreateInfo
+    {
+        friend ReadbackQueue;
+    public:
+        /// Three frames in flight on queue family 0.
+        CreateInfo();
+
+        void set_frame_count(uint32_t count);
+
+        /// Size of each readback buffer, the most one readback can copy.
+        void set_buffer_size(::VkDeviceSize size);
+
+        /// Family of the queues the readbacks are submitted to.
+        void set_queue_family_index(uint32_t index);
+
+    private:
+        uint32_t _frame_count;
+        ::VkDeviceSize _buffer_size;
+        uint32_t _queue_family_index;
+    };
+
+public:
+    ReadbackQueue(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        const CreateInfo& info);
+
+    /// Waits for the readbacks in flight.
+    ~ReadbackQueue();
+
+    ReadbackQueue(const ReadbackQueue&) = delete;
+
+    ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+    /// Copy mip level 0, layer 0 of `image`, tightly packed with
+    /// `texel_size` bytes per texel. The image must be in `layout` and is
+    /// left in it. The copy waits for `wait_semaphores` and for earlier
+    /// work on `queue`. Throws `std::length_error` if the image does not
+    /// fit in a readback buffer.
+    std::future<std::vector<uint8_t>> read_image(Queue& queue,
+        ImageRef image,
+        ::VkImageLayout layout,
+        ::VkExtent2D extent,
+        uint32_t texel_size,
+        std::initializer_list<SemaphoreRef> wait_semaphores = {},
+        ::VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /// Copy `size` bytes of `buffer` from `offset`.
+    std::future<std::vector<uint8_t>> read_buffer(Queue& queue,
+        BufferRef buffer,
+        ::VkDeviceSize offset,
+        ::VkDeviceSize size,
+        std::initializer_list<SemaphoreRef> wait_semaphores = {});
+
+    uint32_t frame_count() const;
+
+    /// Readbacks submitted but not yet fulfilled.
+    uint32_t in_flight_count() const;
+
+    /// Wait until every submitted readback is fulfilled.
+    void wait_idle();
+
+private:
+    struct Frame
+    {
+        UniqueBuffer buffer;
+        UniqueDeviceMemory memory;
+        UniqueFence fence;
+        const uint8_t *data;
+        ::VkDeviceSize size;
+        std::promise<std::vector<uint8_t>> promise;
+    };
+
+    /// Wait for a free frame and begin its command buffer.
+    uint32_t begin_frame(::VkDeviceSize size);
+
+    std::future<std::vector<uint8_t>> submit_frame(Queue& queue,
+        uint32_t index,
+        std::initializer_list<SemaphoreRef> wait_semaphores);
+
+    /// Return a frame that was not submitted, on an error.
+    void release_frame(uint32_t index);
+
+    /// Worker thread. Fulfills the submitted frames in order.
+    void run();
+
+private:
+    Device _device;
+    CreateInfo _info;
+    /// Whether the readback memory is host coherent.
+    bool _coherent;
+    UniqueCommandPool _command_pool;
+    std::vector<Frame> _frames;
+    std::vector<CommandBuffer> _command_buffers;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<uint32_t> _free;
+    std::deque<uint32_t> _submitted;
+    bool _stop;
+    std::thread _worker;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_READBACK_QUEUE_H
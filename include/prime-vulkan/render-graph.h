@@ -0,0 +1,232 @@
+#ifndef _PRIME_VULKAN_RENDER_GRAPH_H
+#define _PRIME_VULKAN_RENDER_GRAPH_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <primer/vector.h>
+#include <primer/string.h>
+
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/render-pass.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/resource-state.h>
+
+namespace pr {
+namespace vk {
+
+/// Frame graph of passes that declare the resources they read and write.
+///
+/// `compile` orders the passes by their dependencies, culls the ones whose
+/// results are never used, and creates the transient images. Transient
+/// images whose lifetimes do not overlap share the same memory.
+/// `execute` records the passes with the barriers between them.
+///
+///     RenderGraph graph(device);
+///     auto hdr = graph.create_image(hdr_info);
+///     auto back_buffer = graph.import_image(ImageRef(swapchain_image),
+///         ResourceState(), ResourceState::present());
+///
+///     auto& scene = graph.add_pass("scene");
+///     scene.write(hdr, ResourceState::color_attachment());
+///     scene.set_record([&](CommandBuffer& cmd) { ... });
+///
+///     auto& tonemap = graph.add_pass("tonemap");
+///     tonemap.read(hdr, ResourceState::shader_read(
+///         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT));
+///     tonemap.write(back_buffer, ResourceState::color_attachment());
+///     tonemap.set_record([&](CommandBuffer& cmd) { ... });
+///
+///     graph.compile(physical_device.memory_properties());
+///     graph.execute(command_buffer);
+///
+/// Render passes begun in a record callback should use the declared layout
+/// as both the initial and the final layout of their attachments.
+///
+/// A pure reader runs after every writer of the resource, and writers run
+/// in the order they were added. Transient images are rewritten every
+/// frame; their contents do not survive between passes that are not
+/// ordered by the graph, nor between frames.
+class RenderGraph
+{
+public:
+    using ResourceId = uint32_t;
+
+    /// An image created and owned by the graph.
+    class TransientImageInfo
+    {
+        friend RenderGraph;
+    public:
+        /// A 2D color image with one sample.
+        TransientImageInfo();
+
+        void set_format(::VkFormat format);
+
+        void set_extent(::VkExtent2D extent);
+
+        void set_usage(::VkImageUsageFlags usage);
+
+        void set_samples(::VkSampleCountFlagBits samples);
+
+        void set_aspect_mask(::VkImageAspectFlags aspect_mask);
+
+    private:
+        ::VkFormat _format;
+        ::VkExtent2D _extent;
+        ::VkImageUsageFlags _usage;
+        ::VkSampleCountFlagBits _samples;
+        ::VkImageAspectFlags _aspect_mask;
+    };
+
+    class Pass
+    {
+        friend RenderGraph;
+    public:
+        /// Read `resource` in `state`.
+        void read(ResourceId resource, const ResourceState& state);
+
+        /// Write `resource` in `state`. Read-modify-write counts as a write.
+        void write(ResourceId resource, const ResourceState& state);
+
+        /// Keep the pass even if nothing uses what it writes.
+        void set_side_effects(bool side_effects);
+
+        /// Commands of the pass. Barriers for the declared resources are
+        /// recorded before it is called.
+        void set_record(std::function<void(CommandBuffer&)> record);
+
+        const pr::String& name() const;
+
+    private:
+        struct Use
+        {
+            ResourceId resource;
+            ResourceState state;
+            bool write;
+        };
+
+        Pass(const pr::String& name);
+
+    private:
+        pr::String _name;
+        std::vector<Use> _uses;
+        bool _side_effects;
+        std::function<void(CommandBuffer&)> _record;
+    };
+
+public:
+    RenderGraph(const Device& device);
+
+    RenderGraph(const RenderGraph&) = delete;
+
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    ResourceId create_image(const TransientImageInfo& info);
+
+    /// An image owned elsewhere. It is in `initial` when the graph runs and
+    /// is left in `final`, e.g. `ResourceState::present()`.
+    ResourceId import_image(ImageRef image,
+        const ResourceState& initial,
+        const ResourceState& final,
+        ::VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /// A buffer owned elsewhere, in `initial` when the graph runs.
+    ResourceId import_buffer(BufferRef buffer, const ResourceState& initial);
+
+    /// Point an imported image at another image, e.g. the next swapchain
+    /// image, without compiling again.
+    void set_imported_image(ResourceId resource, ImageRef image);
+
+    /// The returned pass lives as long as the graph.
+    Pass& add_pass(const pr::String& name);
+
+    /// Order and cull the passes, then create the transient images and
+    /// their memory. Throws `std::logic_error` on a dependency cycle, and
+    /// `VulkanError` when no memory type fits an aliased group.
+    void compile(const PhysicalDevice::MemoryProperties& memory_properties);
+
+    /// Record the live passes in order.
+    void execute(CommandBuffer& command_buffer);
+
+    ImageRef image(ResourceId resource) const;
+
+    /// A view of the whole transient image. Null for imported resources.
+    ImageViewRef image_view(ResourceId resource) const;
+
+    BufferRef buffer(ResourceId resource) const;
+
+    /// Names of the live passes in execution order.
+    pr::Vector<pr::String> pass_order() const;
+
+    uint32_t culled_pass_count() const;
+
+    /// Dependencies between the live passes if each is recorded as a
+    /// subpass of one render pass, subpass indices in execution order.
+    pr::Vector<SubpassDependency> subpass_dependencies() const;
+
+    /// Device memory allocated for the transient images.
+    ::VkDeviceSize transient_memory_size() const;
+
+    /// Device memory the transient images would need without aliasing.
+    ::VkDeviceSize unaliased_memory_size() const;
+
+private:
+    struct Resource
+    {
+        Resource();
+
+        bool transient;
+        TransientImageInfo info;
+        ::VkImage image;
+        ::VkBuffer buffer;
+        ResourceState initial;
+        ResourceState final;
+        ::VkImageAspectFlags aspect_mask;
+
+        UniqueImage owned_image;
+        UniqueImageView view;
+        ::VkDeviceSize size;
+        /// Position of the first and the last live pass using it.
+        int64_t first;
+        int64_t last;
+        /// Transient image that used the same memory before this one.
+        int64_t previous_alias;
+    };
+
+    struct Slot
+    {
+        UniqueDeviceMemory memory;
+        ::VkDeviceSize size;
+        uint32_t memory_type_bits;
+        /// Resources sharing the memory, by first use.
+        std::vector<ResourceId> resources;
+    };
+
+    void sort_and_cull();
+
+    void allocate_transients(
+        const PhysicalDevice::MemoryProperties& memory_properties);
+
+private:
+    Device _device;
+    std::vector<Resource> _resources;
+    std::vector<std::unique_ptr<Pass>> _passes;
+    /// Live passes in execution order.
+    std::vector<uint32_t> _order;
+    std::vector<Slot> _slots;
+    ResourceStateTracker _tracker;
+    bool _compiled;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_RENDER_GRAPH_H
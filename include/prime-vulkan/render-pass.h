@@ -8,6 +8,12 @@
 
 #include <primer/vector.h>
 
+#include <prime-vulkan/arena.h>
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -73,7 +79,7 @@ public:
 
     SubpassDescription(const SubpassDescription& other);
 
-    ~SubpassDescription();
+    SubpassDescription& operator=(const SubpassDescription& other);
 
     void set_pipeline_bind_point(::VkPipelineBindPoint bind_point);
 
@@ -85,7 +91,7 @@ public:
 private:
     CType _description;
 
-    AttachmentReference::CType *_attachments;
+    Arena _arena;
 };
 
 
@@ -105,6 +111,8 @@ public:
     void set_access_mask_src_dst(::VkAccessFlags src,
                                  ::VkAccessFlags dst);
 
+    void set_dependency_flags(::VkDependencyFlags flags);
+
     CType c_struct() const;
 
 private:
@@ -126,7 +134,9 @@ public:
     public:
         CreateInfo();
 
-        ~CreateInfo();
+        CreateInfo(const CreateInfo& other);
+
+        CreateInfo& operator=(const CreateInfo& other);
 
         void set_attachments(const pr::Vector<AttachmentDescription>& vec);
 
@@ -134,17 +144,25 @@ public:
 
         void set_dependencies(const pr::Vector<SubpassDependency>& vec);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
+    private:
+        /// Copy what the subpasses point to into the arena.
+        void copy_subpass_references(SubpassDescription::CType *subpasses,
+                                     uint32_t count);
+
     private:
         CType _info;
 
-        pr::Vector<AttachmentDescription> _attachments;
-        std::vector<AttachmentDescription::CType> _p_attachments;
-        pr::Vector<SubpassDescription> _subpasses;
-        std::vector<SubpassDescription::CType> _p_subpasses;
-        pr::Vector<SubpassDependency> _dependencies;
-        std::vector<SubpassDependency::CType> _p_dependencies;
+        Arena _arena;
     };
 
     class BeginInfo
@@ -157,12 +175,24 @@ public:
 
         void set_render_pass(const RenderPass& render_pass);
 
+        void set_render_pass(Ref<RenderPass> render_pass);
+
         void set_framebuffer(const Framebuffer& framebuffer);
 
+        void set_framebuffer(Ref<Framebuffer> framebuffer);
+
         void set_render_area(::VkRect2D area);
 
         void set_clear_values(const pr::Vector<::VkClearValue>& values);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -174,18 +204,28 @@ public:
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *render_pass)
         {
-            vkDestroyRenderPass(this->_p_device, *render_pass, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_RENDER_PASS);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_RENDER_PASS, *render_pass);
+            } else {
+                vkDestroyRenderPass(this->_p_device, *render_pass, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -198,6 +238,9 @@ private:
     std::shared_ptr<CType> _render_pass;
 };
 
+using UniqueRenderPass = Unique<RenderPass>;
+using RenderPassRef = Ref<RenderPass>;
+
 } // namespace vk
 } // namespace pr
 
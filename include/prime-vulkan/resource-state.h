@@ -0,0 +1,201 @@
+#ifndef _PRIME_VULKAN_RESOURCE_STATE_H
+#define _PRIME_VULKAN_RESOURCE_STATE_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/swapchain.h>
+#include <prime-vulkan/command-buffer.h>
+
+namespace pr {
+namespace vk {
+
+/// How a command uses a resource: the pipeline stages, the memory accesses
+/// and, for images, the layout. Buffers ignore the layout.
+class ResourceState
+{
+public:
+    /// No stage, no access and an undefined layout.
+    ResourceState();
+
+    ResourceState(::VkPipelineStageFlags2 stages,
+                  ::VkAccessFlags2 access,
+                  ::VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED);
+
+    ::VkPipelineStageFlags2 stages() const;
+
+    ::VkAccessFlags2 access() const;
+
+    ::VkImageLayout layout() const;
+
+    /// Whether any of the accesses is a write.
+    bool writes() const;
+
+    /// Access flags that only read.
+    static ::VkAccessFlags2 read_access(::VkAccessFlags2 access);
+
+    /// Access flags that write. Unknown flags count as writes.
+    static ::VkAccessFlags2 write_access(::VkAccessFlags2 access);
+
+    /// Closest `VkPipelineStageFlags` to synchronization2 stages. `none`
+    /// replaces an empty mask, since legacy barriers need a stage.
+    static ::VkPipelineStageFlags legacy_stages(
+        ::VkPipelineStageFlags2 stages, ::VkPipelineStageFlags none);
+
+    /// Closest `VkAccessFlags` to synchronization2 accesses.
+    static ::VkAccessFlags legacy_access(::VkAccessFlags2 access);
+
+    static ResourceState transfer_read();
+
+    static ResourceState transfer_write();
+
+    static ResourceState vertex_buffer();
+
+    static ResourceState index_buffer();
+
+    static ResourceState indirect_buffer();
+
+    static ResourceState uniform_buffer(::VkPipelineStageFlags2 stages);
+
+    /// Sampled image or read-only storage buffer.
+    static ResourceState shader_read(::VkPipelineStageFlags2 stages);
+
+    /// Storage image or buffer, in the general layout.
+    static ResourceState shader_write(::VkPipelineStageFlags2 stages);
+
+    static ResourceState color_attachment();
+
+    static ResourceState depth_stencil_attachment();
+
+    static ResourceState present();
+
+    static ResourceState host_read();
+
+private:
+    ::VkPipelineStageFlags2 _stages;
+    ::VkAccessFlags2 _access;
+    ::VkImageLayout _layout;
+};
+
+
+/// Tracks the last state of buffers and images, and emits the barriers
+/// needed to move them to a new state.
+///
+/// Before each command, declare how it uses its resources with
+/// `use_buffer` and `use_image`, then call `flush` once. Barriers are
+/// queued only on a hazard or a layout change: reads after reads in the
+/// same layout need none. All queued barriers are recorded as a single
+/// `vkCmdPipelineBarrier2`, or one `vkCmdPipelineBarrier` without
+/// synchronization2.
+///
+///     tracker.use_image(ImageRef(image), ResourceState::transfer_write());
+///     tracker.use_buffer(BufferRef(staging),
+///         ResourceState::transfer_read());
+///     tracker.flush(command_buffer);
+///     // Copy the buffer to the image...
+///
+/// Images are tracked as a whole, all mip levels and layers together.
+/// Resources seen for the first time are assumed unused, and images in the
+/// undefined layout. Use `set_buffer_state` or `set_image_state` for
+/// resources used outside of the tracker. The tracker is meant to follow
+/// the submission order of one queue and is not thread-safe.
+class ResourceStateTracker
+{
+public:
+    ResourceStateTracker();
+
+    /// Declare that the next command uses `buffer` in `state`.
+    void use_buffer(BufferRef buffer, const ResourceState& state);
+
+    /// Declare that the next command uses `image` in `state`. The aspect
+    /// mask is remembered from the first call.
+    void use_image(ImageRef image, const ResourceState& state,
+        ::VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /// Record the queued barriers, if any.
+    void flush(CommandBuffer& command_buffer);
+
+    /// Number of barriers queued since the last flush.
+    uint32_t pending_barrier_count() const;
+
+    /// Set the last known state without a barrier.
+    void set_buffer_state(BufferRef buffer, const ResourceState& state);
+
+    /// Set the last known state without a barrier.
+    void set_image_state(ImageRef image, const ResourceState& state,
+        ::VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /// The last state a buffer was used in.
+    ResourceState buffer_state(BufferRef buffer) const;
+
+    /// The last state an image was used in.
+    ResourceState image_state(ImageRef image) const;
+
+    /// Stop tracking a buffer, e.g. before destroying it.
+    void forget(BufferRef buffer);
+
+    /// Stop tracking an image, e.g. before destroying it.
+    void forget(ImageRef image);
+
+    /// Stop tracking everything. Queued barriers are dropped.
+    void clear();
+
+private:
+    struct Tracked
+    {
+        Tracked();
+
+        /// Stages and write accesses of the last write or layout change.
+        ::VkPipelineStageFlags2 write_stages;
+        ::VkAccessFlags2 write_access;
+        /// Stages that read since then.
+        ::VkPipelineStageFlags2 read_stages;
+        /// Stages and accesses a barrier made the last write visible to.
+        ::VkPipelineStageFlags2 visible_stages;
+        ::VkAccessFlags2 visible_access;
+        /// The last use. Its layout is the current layout of an image.
+        ResourceState last;
+        ::VkImageAspectFlags aspect_mask;
+        /// Index of the queued barrier, or -1.
+        int64_t pending;
+    };
+
+    struct Barrier
+    {
+        ::VkPipelineStageFlags2 src_stages;
+        ::VkAccessFlags2 src_access;
+    };
+
+    /// Whether using the resource in `state` needs a barrier, and from
+    /// what.
+    static bool needs_barrier(const Tracked& tracked,
+                              const ResourceState& state,
+                              bool is_image,
+                              Barrier *barrier);
+
+    /// Forget the history and take `state` as the last use.
+    static void assign(Tracked& tracked, const ResourceState& state);
+
+    /// Update the tracked state after a use.
+    static void apply(Tracked& tracked,
+                      const ResourceState& state,
+                      bool is_image,
+                      bool barrier);
+
+private:
+    std::unordered_map<::VkBuffer, Tracked> _buffers;
+    std::unordered_map<::VkImage, Tracked> _images;
+    std::vector<::VkBufferMemoryBarrier2> _buffer_barriers;
+    std::vector<::VkImageMemoryBarrier2> _image_barriers;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_RESOURCE_STATE_H
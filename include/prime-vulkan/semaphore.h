@@ -5,6 +5,11 @@
 
 #include <memory>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -24,6 +29,14 @@ public:
     public:
         CreateInfo();
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         CType c_struct() const;
 
     private:
@@ -35,18 +48,28 @@ public:
     public:
         Deleter() = delete;
 
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *semaphore)
         {
-            vkDestroySemaphore(this->_p_device, *semaphore, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_SEMAPHORE);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_SEMAPHORE, *semaphore);
+            } else {
+                vkDestroySemaphore(this->_p_device, *semaphore, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -59,6 +82,9 @@ private:
     std::shared_ptr<CType> _semaphore;
 };
 
+using UniqueSemaphore = Unique<Semaphore>;
+using SemaphoreRef = Ref<Semaphore>;
+
 } // namespace vk
 } // namespace pr
 
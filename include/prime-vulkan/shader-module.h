@@ -5,6 +5,11 @@
 
 #include <memory>
 
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -14,6 +19,8 @@ class ShaderModule
 {
     friend Device;
 public:
+    using CType = ::VkShaderModule;
+
     class CreateInfo
     {
     public:
@@ -21,6 +28,14 @@ public:
 
         void set_code(const uint32_t *code, uint64_t size);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkShaderModuleCreateInfo c_struct() const;
 
     private:
@@ -30,18 +45,29 @@ public:
     class Deleter
     {
     public:
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(::VkShaderModule *shader_module)
         {
-            vkDestroyShaderModule(this->_p_device, *shader_module, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_SHADER_MODULE);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_SHADER_MODULE, *shader_module);
+            } else {
+                vkDestroyShaderModule(this->_p_device,
+                    *shader_module, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -54,6 +80,9 @@ private:
     std::shared_ptr<::VkShaderModule> _shader_module;
 };
 
+using UniqueShaderModule = Unique<ShaderModule>;
+using ShaderModuleRef = Ref<ShaderModule>;
+
 } // namespace vk
 } // namespace pr
 
@@ -0,0 +1,135 @@
+#ifndef _PRIME_VULKAN_STAGING_UPLOADER_H
+#define _PRIME_VULKAN_STAGING_UPLOADER_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <primer/vector.h>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/resource-state.h>
+
+namespace pr {
+namespace vk {
+
+/// Uploads texture and buffer data through one host visible staging
+/// buffer.
+///
+/// Uploads are copied to the staging buffer right away and recorded
+/// together by `record`: one barrier into the transfer layout for all the
+/// destinations, one copy per destination with all of its regions, and
+/// one barrier into their final states.
+///
+///     BufferImageCopy level0;
+///     level0.set_image_extent(::VkExtent3D { 256, 256, 1 });
+///     uploader.upload_image(ImageRef(texture), pixels, 256 * 256 * 4, 4,
+///         { level0 }, ResourceState::shader_read(
+///             VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT));
+///     uploader.record(command_buffer, tracker);
+///     // Submit, and once the submission is done:
+///     uploader.reset();
+///
+/// The staging memory is reused only after `reset`, which must wait until
+/// the recorded copies are done.
+class StagingUploader
+{
+public:
+    StagingUploader(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        ::VkDeviceSize capacity);
+
+    StagingUploader(const StagingUploader&) = delete;
+
+    StagingUploader& operator=(const StagingUploader&) = delete;
+
+    /// Stage `size` bytes of `data` for `regions` of `image`. The buffer
+    /// offsets of the regions are relative to `data`, and multiples of
+    /// `texel_size`, the bytes per texel or per compressed block. Returns
+    /// false without staging anything if the staging buffer is full.
+    /// Throws `std::length_error` if `size` is larger than the capacity.
+    bool upload_image(ImageRef image,
+        const void *data,
+        ::VkDeviceSize size,
+        uint32_t texel_size,
+        const pr::Vector<BufferImageCopy>& regions,
+        const ResourceState& final_state,
+        ::VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    /// Stage `size` bytes of `data` for `buffer` at `offset`.
+    bool upload_buffer(BufferRef buffer,
+        ::VkDeviceSize offset,
+        const void *data,
+        ::VkDeviceSize size,
+        const ResourceState& final_state);
+
+    /// Record the staged uploads. `tracker` supplies the current states
+    /// of the destinations, `VK_IMAGE_LAYOUT_UNDEFINED` for new images,
+    /// and is left with their final states.
+    void record(CommandBuffer& command_buffer,
+                ResourceStateTracker& tracker);
+
+    /// Record only the copies of the staged uploads, for callers that
+    /// manage the barriers themselves. The destinations must be in a
+    /// transfer destination layout.
+    void record_copies(CommandBuffer& command_buffer);
+
+    /// Make the whole staging buffer available again.
+    void reset();
+
+    /// Whether there are staged uploads not yet recorded.
+    bool empty() const;
+
+    ::VkDeviceSize capacity() const;
+
+    /// Bytes of the staging buffer in use since the last reset.
+    ::VkDeviceSize used() const;
+
+private:
+    struct ImageUpload
+    {
+        ImageRef image;
+        ResourceState final_state;
+        ::VkImageAspectFlags aspect_mask;
+        pr::Vector<BufferImageCopy> regions;
+    };
+
+    struct BufferUpload
+    {
+        BufferRef buffer;
+        ResourceState final_state;
+        pr::Vector<BufferCopy> regions;
+    };
+
+    /// Copy `data` to the staging buffer at a multiple of `alignment`.
+    /// Returns its offset, or -1 if it does not fit.
+    int64_t stage(const void *data, ::VkDeviceSize size,
+                  ::VkDeviceSize alignment);
+
+    void copy(CommandBuffer& command_buffer);
+
+private:
+    Device _device;
+    ::VkDeviceSize _capacity;
+    ::VkDeviceSize _used;
+    UniqueBuffer _buffer;
+    UniqueDeviceMemory _memory;
+    uint8_t *_data;
+    /// Whether the staging memory is host coherent.
+    bool _coherent;
+    std::vector<ImageUpload> _images;
+    std::vector<BufferUpload> _buffers;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_STAGING_UPLOADER_H
@@ -0,0 +1,100 @@
+#ifndef _PRIME_VULKAN_STATISTICS_H
+#define _PRIME_VULKAN_STATISTICS_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace pr {
+namespace vk {
+
+class Device;
+
+/// Snapshot of the library-wide object and memory counters, taken by
+/// `Device::statistics`.
+///
+/// `Device` counts the objects it creates and the memory it allocates and
+/// maps, and the deleters count what they destroy. The counters are
+/// relaxed atomics: cheap to update, but a snapshot taken while other
+/// threads create objects may not be consistent between counters.
+///
+///     auto before = device.statistics();
+///     // Run frames.
+///     auto after = device.statistics();
+///     if (after.live_objects(VK_OBJECT_TYPE_BUFFER) >
+///             before.live_objects(VK_OBJECT_TYPE_BUFFER)) {
+///         // Leaking buffers.
+///     }
+///
+/// An object handed to a `DeletionQueue` counts as destroyed. With more
+/// than one device, the counters of all devices add up.
+class Statistics
+{
+    friend Device;
+public:
+    /// Called by `Device` when it creates `count` objects of `type`.
+    static void object_created(::VkObjectType type, uint64_t count = 1);
+
+    /// Called by the deleters.
+    static void object_destroyed(::VkObjectType type);
+
+    static void memory_allocated(uint32_t memory_type, ::VkDeviceSize size);
+
+    static void memory_freed(uint32_t memory_type, ::VkDeviceSize size);
+
+    static void memory_mapped();
+
+    static void memory_unmapped();
+
+public:
+    /// Objects of `type` created and not yet destroyed. Command buffers
+    /// and descriptor sets are freed with their pools and are never
+    /// counted as destroyed.
+    uint64_t live_objects(::VkObjectType type) const;
+
+    /// Objects of `type` created so far.
+    uint64_t created_objects(::VkObjectType type) const;
+
+    /// Bytes allocated from the memory type and not yet freed.
+    ::VkDeviceSize memory_type_bytes(uint32_t memory_type) const;
+
+    /// Live allocations from the memory type.
+    uint64_t memory_type_allocations(uint32_t memory_type) const;
+
+    /// Bytes allocated from the memory types of the heap. Zero for a
+    /// device not created by `PhysicalDevice::create_device`.
+    ::VkDeviceSize heap_bytes(uint32_t heap) const;
+
+    /// `vkAllocateMemory` calls so far.
+    uint64_t allocate_count() const;
+
+    uint64_t free_count() const;
+
+    /// `vkMapMemory` calls so far.
+    uint64_t map_count() const;
+
+    uint64_t unmap_count() const;
+
+private:
+    /// Read the counters. `memory_heaps` is the heap of each of the
+    /// `memory_type_count` memory types.
+    Statistics(const uint8_t *memory_heaps, uint32_t memory_type_count);
+
+private:
+    std::vector<uint64_t> _created;
+    std::vector<uint64_t> _destroyed;
+    ::VkDeviceSize _memory_type_bytes[VK_MAX_MEMORY_TYPES];
+    uint64_t _memory_type_allocations[VK_MAX_MEMORY_TYPES];
+    ::VkDeviceSize _heap_bytes[VK_MAX_MEMORY_HEAPS];
+    uint64_t _allocate_count;
+    uint64_t _free_count;
+    uint64_t _map_count;
+    uint64_t _unmap_count;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_STATISTICS_H
@@ -0,0 +1,232 @@
+#ifndef _PRIME_VULKAN_STRUCTURE_CHAIN_H
+#define _PRIME_VULKAN_STRUCTURE_CHAIN_H
+
+#include <vulkan/vulkan.h>
+
+#include <stddef.h>
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pr {
+namespace vk {
+
+/// `sType` of a struct that can go in a `StructureChain`.
+template<typename T>
+struct StructureType;
+
+#define PRIME_VULKAN_STRUCTURE_TYPE(type, s_type) \
+    template<> \
+    struct StructureType<::type> \
+    { \
+        static constexpr ::VkStructureType value = \
+            VK_STRUCTURE_TYPE_##s_type; \
+    };
+
+// Features, for `Device::CreateInfo` and `vkGetPhysicalDeviceFeatures2`.
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceFeatures2,
+    PHYSICAL_DEVICE_FEATURES_2)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceVulkan11Features,
+    PHYSICAL_DEVICE_VULKAN_1_1_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceVulkan12Features,
+    PHYSICAL_DEVICE_VULKAN_1_2_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceVulkan13Features,
+    PHYSICAL_DEVICE_VULKAN_1_3_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceDescriptorIndexingFeatures,
+    PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceTimelineSemaphoreFeatures,
+    PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceBufferDeviceAddressFeatures,
+    PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceDynamicRenderingFeatures,
+    PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceSynchronization2Features,
+    PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceMemoryPriorityFeaturesEXT,
+    PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT)
+
+// Properties, for `vkGetPhysicalDeviceProperties2`.
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceProperties2,
+    PHYSICAL_DEVICE_PROPERTIES_2)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceVulkan11Properties,
+    PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceVulkan12Properties,
+    PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceVulkan13Properties,
+    PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceDescriptorIndexingProperties,
+    PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceTimelineSemaphoreProperties,
+    PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_PROPERTIES)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPhysicalDeviceMemoryBudgetPropertiesEXT,
+    PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT)
+
+// Create infos.
+PRIME_VULKAN_STRUCTURE_TYPE(VkSemaphoreTypeCreateInfo,
+    SEMAPHORE_TYPE_CREATE_INFO)
+PRIME_VULKAN_STRUCTURE_TYPE(VkDescriptorSetLayoutBindingFlagsCreateInfo,
+    DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO)
+PRIME_VULKAN_STRUCTURE_TYPE(VkDescriptorSetVariableDescriptorCountAllocateInfo,
+    DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO)
+PRIME_VULKAN_STRUCTURE_TYPE(VkPipelineRenderingCreateInfo,
+    PIPELINE_RENDERING_CREATE_INFO)
+PRIME_VULKAN_STRUCTURE_TYPE(VkImageFormatListCreateInfo,
+    IMAGE_FORMAT_LIST_CREATE_INFO)
+
+// Memory.
+PRIME_VULKAN_STRUCTURE_TYPE(VkMemoryDedicatedAllocateInfo,
+    MEMORY_DEDICATED_ALLOCATE_INFO)
+PRIME_VULKAN_STRUCTURE_TYPE(VkMemoryAllocateFlagsInfo,
+    MEMORY_ALLOCATE_FLAGS_INFO)
+PRIME_VULKAN_STRUCTURE_TYPE(VkMemoryPriorityAllocateInfoEXT,
+    MEMORY_PRIORITY_ALLOCATE_INFO_EXT)
+
+// Submission.
+PRIME_VULKAN_STRUCTURE_TYPE(VkTimelineSemaphoreSubmitInfo,
+    TIMELINE_SEMAPHORE_SUBMIT_INFO)
+
+#undef PRIME_VULKAN_STRUCTURE_TYPE
+
+/// Extension structs linked through their `pNext`, stored inline.
+///
+///     StructureChain<::VkPhysicalDeviceFeatures2,
+///                    ::VkPhysicalDeviceVulkan12Features> features;
+///     features.get<::VkPhysicalDeviceVulkan12Features>()
+///         .timelineSemaphore = VK_TRUE;
+///
+///     Device::CreateInfo info;
+///     info.set_next(features);
+///
+/// Each struct is zeroed and has its `sType` set. Copies link their own
+/// structs. The chain must outlive the create info it is set to, which
+/// only keeps the pointer to its `head`.
+///
+/// Structs not valid for a device, such as those of a later API version,
+/// can be left out with `set_linked` and keep their values.
+///
+/// A struct type without a `StructureType` can be added with a
+/// specialization of it.
+template<typename... Ts>
+class StructureChain
+{
+    static_assert(sizeof...(Ts) > 0, "StructureChain needs a struct.");
+
+public:
+    StructureChain()
+        : _structs(),
+          _next(nullptr)
+    {
+        this->_linked.fill(true);
+        this->init(std::index_sequence_for<Ts...>());
+        this->link();
+    }
+
+    StructureChain(const StructureChain& other)
+        : _structs(other._structs),
+          _linked(other._linked),
+          _next(other._next)
+    {
+        this->link();
+    }
+
+    StructureChain& operator=(const StructureChain& other)
+    {
+        this->_structs = other._structs;
+        this->_linked = other._linked;
+        this->_next = other._next;
+        this->link();
+
+        return *this;
+    }
+
+    template<typename T>
+    T& get()
+    {
+        return std::get<T>(this->_structs);
+    }
+
+    template<typename T>
+    const T& get() const
+    {
+        return std::get<T>(this->_structs);
+    }
+
+    /// Whether `T` is in the chain. The head always is.
+    template<typename T>
+    void set_linked(bool linked)
+    {
+        static_assert(index_of<T>() > 0, "The head is always linked.");
+
+        this->_linked[index_of<T>()] = linked;
+        this->link();
+    }
+
+    /// Structs chained after the last linked one.
+    void set_next(const void *next)
+    {
+        this->_next = next;
+        this->link();
+    }
+
+    /// The first struct, for `set_next`.
+    const void* head() const
+    {
+        return &std::get<0>(this->_structs);
+    }
+
+    /// The first struct, for queries that fill the chain.
+    void* head()
+    {
+        return &std::get<0>(this->_structs);
+    }
+
+private:
+    template<size_t... Is>
+    void init(std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(this->_structs).sType = StructureType<Ts>::value), ...);
+    }
+
+    template<typename T>
+    static constexpr size_t index_of()
+    {
+        constexpr bool matches[] = { std::is_same<T, Ts>::value... };
+        for (size_t i = 0; i < sizeof...(Ts); ++i) {
+            if (matches[i]) {
+                return i;
+            }
+        }
+
+        return sizeof...(Ts);
+    }
+
+    void link()
+    {
+        // The query writes through `pNext`, the create infos only read.
+        this->link<sizeof...(Ts) - 1>(const_cast<void*>(this->_next));
+    }
+
+    /// Link struct `I` to `next`, and those before it to the first linked
+    /// one from `I` on.
+    template<size_t I>
+    void link(void *next)
+    {
+        auto& s = std::get<I>(this->_structs);
+        s.pNext = next;
+        if constexpr (I > 0) {
+            this->link<I - 1>(this->_linked[I] ? &s : next);
+        }
+    }
+
+private:
+    std::tuple<Ts...> _structs;
+    std::array<bool, sizeof...(Ts)> _linked;
+    const void *_next;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_STRUCTURE_CHAIN_H
@@ -4,6 +4,8 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_wayland.h>
 
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -24,6 +26,14 @@ public:
 
         WaylandSurfaceCreateInfo(struct wl_display*, struct wl_surface*);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkWaylandSurfaceCreateInfoKHR c_struct() const;
 
     private:
@@ -7,6 +7,13 @@
 
 #include <primer/vector.h>
 
+#include <prime-vulkan/arena.h>
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/structure-chain.h>
+
 namespace pr {
 namespace vk {
 
@@ -25,7 +32,9 @@ public:
     public:
         CreateInfo();
 
-        ~CreateInfo();
+        CreateInfo(const CreateInfo& other);
+
+        CreateInfo& operator=(const CreateInfo& other);
 
         /// Since raw pointers are used internally, the surface object must
         /// live longer than the create info.
@@ -61,12 +70,20 @@ public:
 
         void set_old_swapchain(/* TODO */);
 
+        void set_next(const void *next);
+
+        template<typename... Ts>
+        void set_next(const StructureChain<Ts...>& chain)
+        {
+            this->set_next(chain.head());
+        }
+
         ::VkSwapchainCreateInfoKHR c_struct() const;
 
     private:
         ::VkSwapchainCreateInfoKHR _info;
 
-        uint32_t *_indices;
+        Arena _arena;
     };
 
     class Deleter
@@ -74,18 +91,28 @@ public:
     public:
         Deleter() = delete;
 
-        Deleter(::VkDevice p_device)
+        Deleter(::VkDevice p_device,
+                DeletionQueue *deletion_queue = nullptr)
         {
             this->_p_device = p_device;
+            this->_deletion_queue = deletion_queue;
         }
 
         void operator()(CType *swapchain)
         {
-            vkDestroySwapchainKHR(this->_p_device, *swapchain, nullptr);
+            Statistics::object_destroyed(VK_OBJECT_TYPE_SWAPCHAIN_KHR);
+
+            if (this->_deletion_queue != nullptr) {
+                this->_deletion_queue->push(this->_p_device,
+                    VK_OBJECT_TYPE_SWAPCHAIN_KHR, *swapchain);
+            } else {
+                vkDestroySwapchainKHR(this->_p_device, *swapchain, nullptr);
+            }
         }
 
     private:
         ::VkDevice _p_device;
+        DeletionQueue *_deletion_queue;
     };
 
 public:
@@ -98,81 +125,8 @@ private:
     std::shared_ptr<CType> _swapchain;
 };
 
-
-class Image
-{
-    friend Device;
-public:
-    ::VkImage c_ptr() const;
-
-private:
-    Image();
-
-private:
-    ::VkImage _image;
-};
-
-
-class ImageView
-{
-    friend Device;
-public:
-    using CType = ::VkImageView;
-
-    class CreateInfo
-    {
-    public:
-        CreateInfo();
-
-        void set_image(const Image& image);
-
-        void set_view_type(::VkImageViewType type);
-
-        void set_format(::VkFormat format);
-
-        void set_components(::VkComponentSwizzle r,
-                            ::VkComponentSwizzle g,
-                            ::VkComponentSwizzle b,
-                            ::VkComponentSwizzle a);
-
-        void set_subresource_range(::VkImageSubresourceRange range);
-
-        ::VkImageViewCreateInfo c_struct() const;
-
-    private:
-        ::VkImageViewCreateInfo _info;
-    };
-
-    class Deleter
-    {
-    public:
-        Deleter() = delete;
-
-        Deleter(::VkDevice p_device)
-        {
-            this->_p_device = p_device;
-        }
-
-        void operator()(::VkImageView *image_view)
-        {
-            vkDestroyImageView(this->_p_device, *image_view, nullptr);
-        }
-
-    private:
-        ::VkDevice _p_device;
-    };
-
-public:
-    ~ImageView();
-
-    CType c_ptr() const;
-
-private:
-    ImageView();
-
-private:
-    std::shared_ptr<CType> _view;
-};
+using UniqueSwapchain = Unique<Swapchain>;
+using SwapchainRef = Ref<Swapchain>;
 
 } // namespace vk
 } // namespace pr
@@ -0,0 +1,181 @@
+#ifndef _PRIME_VULKAN_TEXTURE_STREAMER_H
+#define _PRIME_VULKAN_TEXTURE_STREAMER_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/memory.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/resource-state.h>
+#include <prime-vulkan/staging-uploader.h>
+
+namespace pr {
+namespace vk {
+
+/// Streams the mip chains of many textures under a per-frame upload
+/// budget and a memory budget.
+///
+/// A texture requested in a frame first gets its mip tail, the levels no
+/// larger than the tail extent, in one upload. Later frames refine it one
+/// level at a time, toward level 0. Smaller uploads go first across all
+/// the requested textures, so every texture becomes usable before any is
+/// sharp. When allocating a texture would exceed the memory budget, the
+/// least recently requested textures are evicted.
+///
+///     streamer.request(rock);
+///     streamer.update(graphics_commands, tracker, frame_index);
+///     // Clamp sampling to the resident levels.
+///     float min_lod = streamer.resident_level(rock);
+///
+/// Only uncompressed formats are supported. The textures are owned by one
+/// queue family, so record the update on a command buffer of the family
+/// that samples them, before the commands that do.
+class TextureStreamer
+{
+public:
+    using TextureId = uint32_t;
+
+    /// Returns the texels of a mip level, tightly packed. Called during
+    /// `update`; the data is copied before it returns.
+    using MipSource = std::function<const void*(uint32_t mip_level)>;
+
+    class CreateInfo
+    {
+        friend TextureStreamer;
+    public:
+        /// 16 MiB per frame, 256 MiB of textures, two frames in flight
+        /// and a 64 texel mip tail.
+        CreateInfo();
+
+        /// Bytes uploaded per frame, at most. One level larger than this
+        /// cannot be streamed.
+        void set_frame_budget(::VkDeviceSize bytes);
+
+        /// Device memory the textures may use.
+        void set_memory_budget(::VkDeviceSize bytes);
+
+        /// Frames recorded before the first one is done on the GPU.
+        void set_frames_in_flight(uint32_t count);
+
+        /// Levels whose width and height are at most `extent` form the
+        /// mip tail.
+        void set_tail_extent(uint32_t extent);
+
+        /// State the textures are left in after an update.
+        void set_final_state(const ResourceState& state);
+
+    private:
+        ::VkDeviceSize _frame_budget;
+        ::VkDeviceSize _memory_budget;
+        uint32_t _frames_in_flight;
+        uint32_t _tail_extent;
+        ResourceState _final_state;
+    };
+
+public:
+    TextureStreamer(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        const CreateInfo& info);
+
+    TextureStreamer(const TextureStreamer&) = delete;
+
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /// Register a 2D texture. Nothing is allocated until it is requested.
+    /// Throws `std::length_error` if level 0 exceeds the frame budget.
+    TextureId add_texture(::VkFormat format,
+                          ::VkExtent2D extent,
+                          uint32_t mip_levels,
+                          uint32_t texel_size,
+                          MipSource source);
+
+    /// Mark the texture as used in the current frame. Only requested
+    /// textures are streamed, and the least recently requested are
+    /// evicted first.
+    void request(TextureId texture);
+
+    /// Record this frame's uploads and move to the next frame.
+    /// `frame_index` selects the staging memory; the last frame recorded
+    /// with the same index modulo the frames in flight must be done. The
+    /// command buffer must be of the family that samples the textures.
+    void update(CommandBuffer& command_buffer,
+                ResourceStateTracker& tracker,
+                uint32_t frame_index);
+
+    /// Null while the texture is not resident.
+    ImageRef image(TextureId texture) const;
+
+    /// A view of all the levels. Null while the texture is not resident.
+    ImageViewRef image_view(TextureId texture) const;
+
+    /// The finest resident level, or the level count if none is.
+    uint32_t resident_level(TextureId texture) const;
+
+    /// Device memory used by the resident textures.
+    ::VkDeviceSize resident_memory() const;
+
+    /// Change the memory budget. Over it, the next update evicts the
+    /// least recently requested textures no frame in flight can sample.
+    void set_memory_budget(::VkDeviceSize bytes);
+
+    /// Number of updates so far.
+    uint64_t frame() const;
+
+private:
+    struct Texture
+    {
+        ::VkFormat format;
+        ::VkExtent2D extent;
+        uint32_t mip_levels;
+        uint32_t texel_size;
+        MipSource source;
+
+        UniqueImage image;
+        UniqueDeviceMemory memory;
+        UniqueImageView view;
+        ::VkDeviceSize memory_size;
+        uint32_t resident_level;
+        /// Frame of the last request, or -1.
+        int64_t last_use;
+    };
+
+    /// First level of the mip tail.
+    uint32_t tail_level(const Texture& texture) const;
+
+    ::VkDeviceSize level_size(const Texture& texture, uint32_t level) const;
+
+    /// Create the image and its memory, evicting others if needed.
+    /// Returns false if the memory budget cannot fit it. Throws
+    /// `VulkanError` when no memory type fits, before evicting.
+    bool make_resident(TextureId texture, ResourceStateTracker& tracker);
+
+    /// Evict the least recently requested textures no frame in flight
+    /// can still sample until at most `bytes` are resident. Returns false
+    /// if that is not possible.
+    bool evict_down_to(::VkDeviceSize bytes, ResourceStateTracker& tracker);
+
+    void evict(Texture& texture, ResourceStateTracker& tracker);
+
+private:
+    Device _device;
+    PhysicalDevice::MemoryProperties _memory_properties;
+    CreateInfo _info;
+    std::vector<std::unique_ptr<StagingUploader>> _uploaders;
+    std::vector<Texture> _textures;
+    ::VkDeviceSize _resident_memory;
+    int64_t _frame;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_TEXTURE_STREAMER_H
@@ -0,0 +1,126 @@
+#ifndef _PRIME_VULKAN_TRACER_H
+#define _PRIME_VULKAN_TRACER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace pr {
+namespace vk {
+
+/// Records CPU and GPU spans in a ring buffer and writes them as a Chrome
+/// trace, which chrome://tracing and the Perfetto UI both open.
+///
+/// With the `PRIME_VULKAN_TRACE` build option, off by default, the library
+/// records spans for its slow calls, like `Queue::submit`, `Queue::present`,
+/// `Device::acquire_next_image`, `Device::wait_for_fences` and pipeline
+/// creation, to the current tracer. `GpuProfiler` adds its scopes as GPU
+/// spans.
+///
+///     Tracer tracer;
+///     Tracer::set_current(&tracer);
+///     // Run frames.
+///     std::ofstream file("frames.json");
+///     tracer.write_chrome_trace(file);
+///
+/// Once full, new spans overwrite the oldest ones. All methods are
+/// thread-safe.
+class Tracer
+{
+public:
+    /// RAII CPU span on the current tracer, if any.
+    class Scope
+    {
+    public:
+        /// `name` must outlive the tracer, like a string literal.
+        explicit Scope(const char *name);
+
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Tracer *_tracer;
+        const char *_name;
+        uint64_t _start;
+    };
+
+public:
+    /// Room for `capacity` spans.
+    explicit Tracer(size_t capacity = 65536);
+
+    /// Unsets the tracer if it is the current one.
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+
+    Tracer& operator=(const Tracer&) = delete;
+
+    /// The tracer the library records to, or nullptr.
+    static Tracer* current();
+
+    /// Pass nullptr to stop recording. The tracer must outlive its use.
+    static void set_current(Tracer *tracer);
+
+    /// Monotonic clock in nanoseconds, the time base of all spans.
+    static uint64_t now();
+
+    /// Record a span of the calling thread.
+    void add_cpu_span(const char *name, uint64_t start, uint64_t end);
+
+    /// Record a span on the GPU track. `name` must outlive the tracer.
+    void add_gpu_span(const char *name, uint64_t start, uint64_t end);
+
+    /// Spans held, at most the capacity.
+    size_t size() const;
+
+    void clear();
+
+    /// Write the held spans, oldest first, in the Chrome trace event
+    /// format.
+    void write_chrome_trace(std::ostream& stream) const;
+
+private:
+    struct Span
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t end;
+        /// 0 for the GPU, then threads in the order they were seen.
+        uint32_t track;
+    };
+
+    void add(const char *name, uint64_t start, uint64_t end,
+             uint32_t track);
+
+    /// Track of the calling thread. Needs the lock.
+    uint32_t thread_track();
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<Span> _spans;
+    /// Index of the next span to write.
+    size_t _next;
+    bool _wrapped;
+    std::vector<std::thread::id> _threads;
+};
+
+} // namespace vk
+} // namespace pr
+
+/// Records a CPU span from here to the end of the enclosing block, if the
+/// library is built with tracing.
+#ifdef PRIME_VULKAN_TRACE
+#define PRIME_VULKAN_TRACE_SCOPE(name) \
+    ::pr::vk::Tracer::Scope _prime_vulkan_trace_scope(name)
+#else
+#define PRIME_VULKAN_TRACE_SCOPE(name)
+#endif
+
+#endif // _PRIME_VULKAN_TRACER_H
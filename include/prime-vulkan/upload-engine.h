@@ -0,0 +1,205 @@
+#ifndef _PRIME_VULKAN_UPLOAD_ENGINE_H
+#define _PRIME_VULKAN_UPLOAD_ENGINE_H
+
+#include <vulkan/vulkan.h>
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <primer/vector.h>
+
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/device.h>
+#include <prime-vulkan/physical-device.h>
+#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/image.h>
+#include <prime-vulkan/command-pool.h>
+#include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/queue.h>
+#include <prime-vulkan/semaphore.h>
+#include <prime-vulkan/fence.h>
+#include <prime-vulkan/resource-state.h>
+#include <prime-vulkan/staging-uploader.h>
+#include <prime-vulkan/queue-topology.h>
+
+namespace pr {
+namespace vk {
+
+/// Runs uploads on the transfer queue, overlapping rendering.
+///
+/// `release` hands the destinations over from the graphics side, from
+/// their states in the tracker. `submit` records the staged copies on the
+/// transfer queue and signals a semaphore. `acquire` records the other
+/// half on the graphics side. With a dedicated transfer family the
+/// destinations change queue family ownership both ways, otherwise
+/// `release` records plain barriers and `acquire` only updates the
+/// tracker.
+///
+///     engine.upload_image(ImageRef(texture), pixels, size, 4, { region },
+///         ResourceState::shader_read(
+///             VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT));
+///     if (engine.release(command_buffer, tracker)) {
+///         // Make the graphics submission signal
+///         // engine.release_semaphore().
+///     }
+///     // Submit the graphics command buffer, then:
+///     engine.submit();
+///     // Later, recording the graphics command buffer.
+///     if (engine.acquire(command_buffer, tracker)) {
+///         // Make the graphics submission wait for engine.semaphore()
+///         // at engine.wait_stages().
+///     }
+///
+/// Only the mip levels and array layers of the regions change layout.
+/// Images in the undefined layout need no release; the rest of their
+/// contents is discarded. Destinations must not be in use on another
+/// queue.
+class UploadEngine
+{
+public:
+    class CreateInfo
+    {
+        friend UploadEngine;
+    public:
+        /// 32 MiB of staging memory for each of two batches in flight.
+        CreateInfo();
+
+        /// Staging memory per batch, the most one batch can upload.
+        void set_staging_size(::VkDeviceSize size);
+
+        /// Batches submitted before the first one is done on the GPU.
+        void set_batches_in_flight(uint32_t count);
+
+    private:
+        ::VkDeviceSize _staging_size;
+        uint32_t _batches_in_flight;
+    };
+
+public:
+    UploadEngine(const Device& device,
+        const PhysicalDevice::MemoryProperties& memory_properties,
+        const QueueTopology& topology,
+        const CreateInfo& info);
+
+    /// Waits for the batches in flight.
+    ~UploadEngine();
+
+    UploadEngine(const UploadEngine&) = delete;
+
+    UploadEngine& operator=(const UploadEngine&) = delete;
+
+    /// Stage an upload for the next batch. Returns false without staging
+    /// anything if the batch is full; release and submit it and try
+    /// again. Throws `std::logic_error` if the batch was released.
+    bool upload_image(ImageRef image,
+        const void *data,
+        ::VkDeviceSize size,
+        uint32_t texel_size,
+        const pr::Vector<BufferImageCopy>& regions,
+        const ResourceState& final_state,
+        ::VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT);
+
+    bool upload_buffer(BufferRef buffer,
+        ::VkDeviceSize offset,
+        const void *data,
+        ::VkDeviceSize size,
+        const ResourceState& final_state);
+
+    /// Record into a graphics command buffer the barriers that hand the
+    /// staged destinations over to the transfer queue, from their states
+    /// in `tracker`. Returns whether the graphics submission of
+    /// `command_buffer` must signal `release_semaphore()`, which `submit`
+    /// then waits on. The graphics submission must come before `submit`.
+    bool release(CommandBuffer& command_buffer,
+                 ResourceStateTracker& tracker);
+
+    /// Signaled by the graphics submission when `release` returns true.
+    SemaphoreRef release_semaphore() const;
+
+    /// Submit the staged uploads to the transfer queue. Returns false if
+    /// nothing was staged. Throws `std::logic_error` if the batch was not
+    /// released, or if the previous batch was not acquired.
+    bool submit();
+
+    /// Record the acquire of the last submitted batch into a graphics
+    /// command buffer and set the final states in `tracker`. Returns
+    /// whether the submission of `command_buffer` must wait on
+    /// `semaphore()`.
+    bool acquire(CommandBuffer& command_buffer,
+                 ResourceStateTracker& tracker);
+
+    /// Signaled when the last submitted batch is done.
+    SemaphoreRef semaphore() const;
+
+    /// Stages the graphics submission waits on `semaphore()` at.
+    ::VkPipelineStageFlags wait_stages() const;
+
+    /// The transfer queue.
+    Queue& queue();
+
+    /// Wait until every submitted batch is done.
+    void wait_idle();
+
+private:
+    struct Destination
+    {
+        ImageRef image;
+        BufferRef buffer;
+        ResourceState final_state;
+        ::VkImageAspectFlags aspect_mask;
+        /// Mip levels of the regions, each with the span of their layers.
+        std::vector<::VkImageSubresourceRange> ranges;
+        /// Layout before the upload, from `release`.
+        ::VkImageLayout old_layout;
+    };
+
+    struct Batch
+    {
+        std::unique_ptr<StagingUploader> uploader;
+        UniqueFence fence;
+        UniqueSemaphore semaphore;
+        UniqueSemaphore release_semaphore;
+        std::vector<Destination> destinations;
+        /// Whether `release` was recorded.
+        bool released;
+        /// Whether `submit` waits on `release_semaphore`.
+        bool wait_release;
+    };
+
+    /// The batch being staged, once its previous submission is done.
+    Batch& staging_batch();
+
+    /// Image and buffer barriers from the transfer writes to the final
+    /// states, between the given queue families.
+    void final_barriers(const Batch& batch,
+        uint32_t src_family,
+        uint32_t dst_family,
+        bool release,
+        pr::Vector<::VkImageMemoryBarrier>& image_barriers,
+        pr::Vector<::VkBufferMemoryBarrier>& buffer_barriers) const;
+
+private:
+    Device _device;
+    uint32_t _transfer_family;
+    uint32_t _graphics_family;
+    Queue _queue;
+    UniqueCommandPool _command_pool;
+    std::vector<Batch> _batches;
+    std::vector<CommandBuffer> _command_buffers;
+    /// Index of the batch being staged.
+    uint32_t _current;
+    /// Whether the current batch's previous submission was waited for.
+    bool _ready;
+    /// Index of the last submitted batch, or -1.
+    int64_t _submitted;
+    /// Whether the last submitted batch still needs `acquire`.
+    bool _unacquired;
+    ::VkPipelineStageFlags _wait_stages;
+};
+
+} // namespace vk
+} // namespace pr
+
+#endif // _PRIME_VULKAN_UPLOAD_ENGINE_H
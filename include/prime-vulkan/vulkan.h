@@ -6,14 +6,42 @@
 #include <prime-vulkan/extension-properties.h>
 #include <prime-vulkan/physical-device.h>
 #include <prime-vulkan/device.h>
+#include <prime-vulkan/dispatch.h>
+#include <prime-vulkan/handle.h>
+#include <prime-vulkan/deletion-queue.h>
 #include <prime-vulkan/surface.h>
 #include <prime-vulkan/swapchain.h>
+#include <prime-vulkan/image.h>
 #include <prime-vulkan/shader-module.h>
 #include <prime-vulkan/pipeline.h>
 #include <prime-vulkan/render-pass.h>
 #include <prime-vulkan/framebuffer.h>
 #include <prime-vulkan/command-pool.h>
 #include <prime-vulkan/command-buffer.h>
+#include <prime-vulkan/resource-state.h>
+#include <prime-vulkan/render-graph.h>
+#include <prime-vulkan/offscreen-target.h>
+#include <prime-vulkan/readback-queue.h>
+#include <prime-vulkan/staging-uploader.h>
+#include <prime-vulkan/texture-streamer.h>
+#include <prime-vulkan/mipmap-generator.h>
+#include <prime-vulkan/queue-topology.h>
+#include <prime-vulkan/upload-engine.h>
+#include <prime-vulkan/async-compute.h>
+#include <prime-vulkan/indirect-draw-buffer.h>
+#include <prime-vulkan/gpu-culling.h>
+#include <prime-vulkan/query-pool.h>
+#include <prime-vulkan/gpu-profiler.h>
+#include <prime-vulkan/query-readback.h>
+#include <prime-vulkan/pipeline-statistics.h>
+#include <prime-vulkan/occlusion-queries.h>
+#include <prime-vulkan/tracer.h>
+#include <prime-vulkan/statistics.h>
+#include <prime-vulkan/memory-budget-monitor.h>
+#include <prime-vulkan/arena.h>
+#include <prime-vulkan/structure-chain.h>
+#include <prime-vulkan/device-features.h>
+#include <prime-vulkan/device-selector.h>
 #include <prime-vulkan/semaphore.h>
 #include <prime-vulkan/fence.h>
 #include <prime-vulkan/descriptor.h>
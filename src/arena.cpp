@@ -0,0 +1,94 @@
+#include <prime-vulkan/arena.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <new>
+
+namespace pr {
+namespace vk {
+
+Arena::Arena()
+{
+    this->_blocks = nullptr;
+    this->_cursor = this->_inline;
+    this->_end = this->_inline + inline_size;
+}
+
+Arena::~Arena()
+{
+    this->clear();
+}
+
+const char* Arena::copy_string(const char *string)
+{
+    if (string == nullptr) {
+        return nullptr;
+    }
+
+    return this->copy(string, strlen(string) + 1);
+}
+
+const char* const* Arena::copy_strings(const char* const *strings,
+                                       size_t count)
+{
+    const char **p = this->allocate<const char*>(count);
+    for (size_t i = 0; i < count; ++i) {
+        p[i] = this->copy_string(strings[i]);
+    }
+
+    return p;
+}
+
+void Arena::clear()
+{
+    while (this->_blocks != nullptr) {
+        Block *next = this->_blocks->next;
+        free(this->_blocks);
+        this->_blocks = next;
+    }
+
+    this->_cursor = this->_inline;
+    this->_end = this->_inline + inline_size;
+}
+
+void* Arena::allocate_bytes(size_t size, size_t alignment)
+{
+    auto align = [alignment](unsigned char *p) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(p);
+        address = (address + alignment - 1) & ~uintptr_t(alignment - 1);
+
+        return reinterpret_cast<unsigned char*>(address);
+    };
+
+    unsigned char *p = align(this->_cursor);
+    if (p + size > this->_end) {
+        size_t block_size = (this->_blocks != nullptr)
+            ? this->_blocks->size * 2
+            : inline_size * 2;
+        while (block_size < size + alignment) {
+            block_size *= 2;
+        }
+
+        // The header keeps the bytes aligned to `max_align_t`.
+        size_t header = (sizeof(Block) + alignof(max_align_t) - 1) &
+            ~(alignof(max_align_t) - 1);
+        Block *block = static_cast<Block*>(malloc(header + block_size));
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        block->next = this->_blocks;
+        block->size = block_size;
+        this->_blocks = block;
+
+        this->_cursor = reinterpret_cast<unsigned char*>(block) + header;
+        this->_end = this->_cursor + block_size;
+        p = align(this->_cursor);
+    }
+    this->_cursor = p + size;
+
+    return p;
+}
+
+} // namespace vk
+} // namespace pr
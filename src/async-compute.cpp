@@ -0,0 +1,146 @@
+#include <prime-vulkan/async-compute.h>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+AsyncCompute::AsyncCompute(const Device& device,
+                           const QueueTopology& topology,
+                           uint32_t frames_in_flight)
+    : _device(device),
+      _family(topology.compute_family()),
+      _graphics_family(topology.graphics_family()),
+      _queue(device.queue_for(topology.compute_family(), 0))
+{
+    CommandPool::CreateInfo pool_info;
+    pool_info.set_queue_family_index(this->_family);
+    pool_info.set_flags(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    this->_command_pool = this->_device.create_unique_command_pool(pool_info);
+
+    CommandBuffer::AllocateInfo allocate_info;
+    allocate_info.set_command_pool(this->_command_pool.ref());
+    allocate_info.set_level(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    allocate_info.set_command_buffer_count(1);
+
+    Fence::CreateInfo fence_info;
+    fence_info.set_flags(VK_FENCE_CREATE_SIGNALED_BIT);
+    Semaphore::CreateInfo semaphore_info;
+
+    for (uint32_t i = 0; i < frames_in_flight; ++i) {
+        Frame frame;
+        frame.fence = this->_device.create_unique_fence(fence_info);
+        frame.start = this->_device.create_unique_semaphore(semaphore_info);
+        frame.finished = this->_device.create_unique_semaphore(
+            semaphore_info);
+        this->_frames.push_back(std::move(frame));
+
+        this->_command_buffers.push_back(
+            this->_device.allocate_command_buffers(allocate_info));
+    }
+}
+
+AsyncCompute::~AsyncCompute()
+{
+    try {
+        this->wait_idle();
+    } catch (const VulkanError&) {
+        // Nothing left to do on a lost device.
+    }
+}
+
+bool AsyncCompute::is_async() const
+{
+    return this->_family != this->_graphics_family;
+}
+
+uint32_t AsyncCompute::queue_family() const
+{
+    return this->_family;
+}
+
+Queue& AsyncCompute::queue()
+{
+    return this->_queue;
+}
+
+::VkSharingMode AsyncCompute::sharing_mode() const
+{
+    return (this->is_async())
+        ? VK_SHARING_MODE_CONCURRENT
+        : VK_SHARING_MODE_EXCLUSIVE;
+}
+
+pr::Vector<uint32_t> AsyncCompute::sharing_families() const
+{
+    pr::Vector<uint32_t> families;
+    if (this->is_async()) {
+        families.push(this->_graphics_family);
+        families.push(this->_family);
+    }
+
+    return families;
+}
+
+CommandBuffer& AsyncCompute::begin(uint32_t frame_index)
+{
+    uint32_t index = this->slot(frame_index);
+    this->_device.wait_for_fences({ this->_frames[index].fence.ref() },
+        true, UINT64_MAX);
+
+    CommandBuffer::BeginInfo begin_info;
+    begin_info.set_flags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    auto& command_buffer = this->_command_buffers[index];
+    command_buffer.reset(0);
+    command_buffer.begin(begin_info);
+
+    return command_buffer;
+}
+
+void AsyncCompute::submit(uint32_t frame_index, bool wait_for_graphics)
+{
+    uint32_t index = this->slot(frame_index);
+    auto& frame = this->_frames[index];
+    auto& command_buffer = this->_command_buffers[index];
+    command_buffer.end();
+
+    this->_device.reset_fences({ frame.fence.ref() });
+
+    SubmitInfo submit;
+    if (wait_for_graphics) {
+        // Not only compute shaders: the command buffer can also clear or
+        // copy the buffers graphics hands over.
+        submit.set_wait_semaphores({ frame.start.ref() });
+        submit.set_wait_dst_stage_mask({
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT });
+    }
+    submit.set_command_buffers({ CommandBufferRef(command_buffer) });
+    submit.set_signal_semaphores({ frame.finished.ref() });
+    this->_queue.submit({ submit }, frame.fence.ref());
+}
+
+SemaphoreRef AsyncCompute::start_semaphore(uint32_t frame_index) const
+{
+    return this->_frames[this->slot(frame_index)].start.ref();
+}
+
+SemaphoreRef AsyncCompute::finished_semaphore(uint32_t frame_index) const
+{
+    return this->_frames[this->slot(frame_index)].finished.ref();
+}
+
+void AsyncCompute::wait_idle()
+{
+    for (auto& frame: this->_frames) {
+        this->_device.wait_for_fences({ frame.fence.ref() }, true,
+            UINT64_MAX);
+    }
+}
+
+uint32_t AsyncCompute::slot(uint32_t frame_index) const
+{
+    return frame_index % this->_frames.size();
+}
+
+} // namespace vk
+} // namespace pr
@@ -29,9 +29,29 @@ void Buffer::CreateInfo::set_sharing_mode(::VkSharingMode mode)
     this->_info.sharingMode = mode;
 }
 
+void Buffer::CreateInfo::set_queue_family_indices(
+    const pr::Vector<uint32_t>& indices)
+{
+    this->_queue_family_indices.clear();
+    for (auto index: indices) {
+        this->_queue_family_indices.push_back(index);
+    }
+}
+
+void Buffer::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Buffer::CreateInfo::c_struct() const -> CType
 {
-    return this->_info;
+    CType info = this->_info;
+    info.queueFamilyIndexCount = this->_queue_family_indices.size();
+    info.pQueueFamilyIndices = (info.queueFamilyIndexCount > 0)
+        ? this->_queue_family_indices.data()
+        : nullptr;
+
+    return info;
 }
 
 
@@ -52,6 +72,16 @@ BufferCopy::BufferCopy()
     this->_copy.dstOffset = 0;
 }
 
+void BufferCopy::set_src_offset(VkDeviceSize offset)
+{
+    this->_copy.srcOffset = offset;
+}
+
+void BufferCopy::set_dst_offset(VkDeviceSize offset)
+{
+    this->_copy.dstOffset = offset;
+}
+
 void BufferCopy::set_size(VkDeviceSize size)
 {
     this->_copy.size = size;
@@ -1,11 +1,14 @@
 #include <prime-vulkan/command-buffer.h>
 
+#include <assert.h>
+
+#include <stdexcept>
 #include <vector>
 
+#include <prime-vulkan/arena.h>
 #include <prime-vulkan/base.h>
 #include <prime-vulkan/command-pool.h>
-#include <prime-vulkan/pipeline.h>
-#include <prime-vulkan/buffer.h>
+#include <prime-vulkan/resource-state.h>
 
 namespace pr {
 namespace vk {
@@ -23,6 +26,12 @@ void CommandBuffer::AllocateInfo::set_command_pool(
     this->_info.commandPool = command_pool.c_ptr();
 }
 
+void CommandBuffer::AllocateInfo::set_command_pool(
+    CommandPoolRef command_pool)
+{
+    this->_info.commandPool = command_pool.c_ptr();
+}
+
 void CommandBuffer::AllocateInfo::set_level(::VkCommandBufferLevel level)
 {
     this->_info.level = level;
@@ -33,6 +42,11 @@ void CommandBuffer::AllocateInfo::set_command_buffer_count(uint32_t count)
     this->_info.commandBufferCount = count;
 }
 
+void CommandBuffer::AllocateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto CommandBuffer::AllocateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -54,6 +68,11 @@ void CommandBuffer::BeginInfo::set_flags(VkCommandBufferUsageFlags flags)
     this->_info.flags = flags;
 }
 
+void CommandBuffer::BeginInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto CommandBuffer::BeginInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -63,6 +82,7 @@ auto CommandBuffer::BeginInfo::c_struct() const -> CType
 CommandBuffer::CommandBuffer()
 {
     this->_command_buffer = nullptr;
+    this->_dispatch = DeviceDispatch::loader().get();
 }
 
 void CommandBuffer::begin(const CommandBuffer::BeginInfo& info)
@@ -70,7 +90,8 @@ void CommandBuffer::begin(const CommandBuffer::BeginInfo& info)
     ::VkResult result;
 
     BeginInfo::CType vk_info = info.c_struct();
-    result = vkBeginCommandBuffer(this->_command_buffer, &vk_info);
+    result = this->_dispatch->vkBeginCommandBuffer(this->_command_buffer,
+        &vk_info);
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
     }
@@ -80,7 +101,8 @@ void CommandBuffer::reset(::VkCommandBufferResetFlags flags)
 {
     ::VkResult result;
 
-    result = vkResetCommandBuffer(this->_command_buffer, flags);
+    result = this->_dispatch->vkResetCommandBuffer(this->_command_buffer,
+        flags);
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
     }
@@ -90,13 +112,22 @@ void CommandBuffer::begin_render_pass(const RenderPass::BeginInfo& info,
                                       ::VkSubpassContents contents)
 {
     auto vk_info = info.c_struct();
-    vkCmdBeginRenderPass(this->_command_buffer, &vk_info, contents);
+    this->_dispatch->vkCmdBeginRenderPass(this->_command_buffer,
+        &vk_info, contents);
 }
 
 void CommandBuffer::bind_pipeline(::VkPipelineBindPoint bind_point,
                                   const Pipeline& pipeline)
 {
-    vkCmdBindPipeline(this->_command_buffer,
+    this->_dispatch->vkCmdBindPipeline(this->_command_buffer,
+        bind_point,
+        pipeline.c_ptr());
+}
+
+void CommandBuffer::bind_pipeline(::VkPipelineBindPoint bind_point,
+                                  PipelineRef pipeline)
+{
+    this->_dispatch->vkCmdBindPipeline(this->_command_buffer,
         bind_point,
         pipeline.c_ptr());
 }
@@ -111,7 +142,7 @@ void CommandBuffer::set_viewport(uint32_t first_viewport,
         vk_viewports.push_back(viewport);
     }
 
-    vkCmdSetViewport(this->_command_buffer,
+    this->_dispatch->vkCmdSetViewport(this->_command_buffer,
         first_viewport, count, vk_viewports.data());
 }
 
@@ -125,7 +156,7 @@ void CommandBuffer::set_scissor(uint32_t first_scissor,
         vk_scissors.push_back(scissor);
     }
 
-    vkCmdSetScissor(this->_command_buffer,
+    this->_dispatch->vkCmdSetScissor(this->_command_buffer,
         first_scissor, count, vk_scissors.data());
 }
 
@@ -134,7 +165,7 @@ void CommandBuffer::draw(uint32_t vertex_count,
                          uint32_t first_vertex,
                          uint32_t first_instance)
 {
-    vkCmdDraw(this->_command_buffer,
+    this->_dispatch->vkCmdDraw(this->_command_buffer,
         vertex_count, instance_count, first_vertex, first_instance);
 }
 
@@ -144,11 +175,83 @@ void CommandBuffer::draw_indexed(uint32_t index_count,
                   int32_t vertex_offset,
                   uint32_t first_instance)
 {
-    vkCmdDrawIndexed(this->_command_buffer,
+    this->_dispatch->vkCmdDrawIndexed(this->_command_buffer,
         index_count, instance_count, first_index, vertex_offset,
         first_instance);
 }
 
+void CommandBuffer::draw_indirect(BufferRef buffer,
+                                  ::VkDeviceSize offset,
+                                  uint32_t draw_count,
+                                  uint32_t stride)
+{
+    this->_dispatch->vkCmdDrawIndirect(this->_command_buffer,
+        buffer.c_ptr(), offset, draw_count, stride);
+}
+
+void CommandBuffer::draw_indexed_indirect(BufferRef buffer,
+                                          ::VkDeviceSize offset,
+                                          uint32_t draw_count,
+                                          uint32_t stride)
+{
+    this->_dispatch->vkCmdDrawIndexedIndirect(this->_command_buffer,
+        buffer.c_ptr(), offset, draw_count, stride);
+}
+
+void CommandBuffer::draw_indirect_count(BufferRef buffer,
+                                        ::VkDeviceSize offset,
+                                        BufferRef count_buffer,
+                                        ::VkDeviceSize count_offset,
+                                        uint32_t max_draw_count,
+                                        uint32_t stride)
+{
+    if (!this->supports_draw_indirect_count()) {
+        throw std::logic_error("vkCmdDrawIndirectCount is not available.");
+    }
+
+    this->_dispatch->vkCmdDrawIndirectCount(this->_command_buffer,
+        buffer.c_ptr(), offset, count_buffer.c_ptr(), count_offset,
+        max_draw_count, stride);
+}
+
+void CommandBuffer::draw_indexed_indirect_count(BufferRef buffer,
+                                                ::VkDeviceSize offset,
+                                                BufferRef count_buffer,
+                                                ::VkDeviceSize count_offset,
+                                                uint32_t max_draw_count,
+                                                uint32_t stride)
+{
+    if (!this->supports_draw_indirect_count()) {
+        throw std::logic_error(
+            "vkCmdDrawIndexedIndirectCount is not available.");
+    }
+
+    this->_dispatch->vkCmdDrawIndexedIndirectCount(this->_command_buffer,
+        buffer.c_ptr(), offset, count_buffer.c_ptr(), count_offset,
+        max_draw_count, stride);
+}
+
+bool CommandBuffer::supports_draw_indirect_count() const
+{
+    return this->_dispatch->vkCmdDrawIndirectCount != nullptr &&
+        this->_dispatch->vkCmdDrawIndexedIndirectCount != nullptr;
+}
+
+void CommandBuffer::dispatch(uint32_t group_count_x,
+                             uint32_t group_count_y,
+                             uint32_t group_count_z)
+{
+    this->_dispatch->vkCmdDispatch(this->_command_buffer,
+        group_count_x, group_count_y, group_count_z);
+}
+
+void CommandBuffer::dispatch_indirect(BufferRef buffer,
+                                      ::VkDeviceSize offset)
+{
+    this->_dispatch->vkCmdDispatchIndirect(this->_command_buffer,
+        buffer.c_ptr(), offset);
+}
+
 void CommandBuffer::bind_vertex_buffers(uint32_t first_binding,
                                         const pr::Vector<Buffer>& buffers,
                                         const pr::Vector<VkDeviceSize>& offsets)
@@ -164,18 +267,58 @@ void CommandBuffer::bind_vertex_buffers(uint32_t first_binding,
         vk_offsets[i] = offsets[i];
     }
 
-    vkCmdBindVertexBuffers(this->_command_buffer,
+    this->_dispatch->vkCmdBindVertexBuffers(this->_command_buffer,
         first_binding, count, vk_buffers, vk_offsets);
 
     delete[] vk_offsets;
     delete[] vk_buffers;
 }
 
+void CommandBuffer::bind_vertex_buffers(uint32_t first_binding,
+    std::initializer_list<BufferRef> buffers,
+    std::initializer_list<VkDeviceSize> offsets)
+{
+    assert(buffers.size() == offsets.size());
+
+    this->_dispatch->vkCmdBindVertexBuffers(this->_command_buffer,
+        first_binding, buffers.size(), BufferRef::c_ptrs(buffers.begin()),
+        offsets.begin());
+}
+
 void CommandBuffer::bind_index_buffer(const Buffer& buffer, VkDeviceSize offset,
                                       VkIndexType index_type)
 {
-    vkCmdBindIndexBuffer(this->_command_buffer, buffer.c_ptr(), offset,
-        index_type);
+    this->_dispatch->vkCmdBindIndexBuffer(this->_command_buffer,
+        buffer.c_ptr(), offset, index_type);
+}
+
+void CommandBuffer::bind_index_buffer(BufferRef buffer, VkDeviceSize offset,
+                                      VkIndexType index_type)
+{
+    this->_dispatch->vkCmdBindIndexBuffer(this->_command_buffer,
+        buffer.c_ptr(), offset, index_type);
+}
+
+void CommandBuffer::bind_descriptor_sets(::VkPipelineBindPoint bind_point,
+    PipelineLayoutRef layout,
+    uint32_t first_set,
+    std::initializer_list<DescriptorSetRef> sets,
+    std::initializer_list<uint32_t> dynamic_offsets)
+{
+    this->_dispatch->vkCmdBindDescriptorSets(this->_command_buffer,
+        bind_point, layout.c_ptr(), first_set,
+        sets.size(), DescriptorSetRef::c_ptrs(sets.begin()),
+        dynamic_offsets.size(), dynamic_offsets.begin());
+}
+
+void CommandBuffer::push_constants(PipelineLayoutRef layout,
+                                   ::VkShaderStageFlags stage_flags,
+                                   uint32_t offset,
+                                   uint32_t size,
+                                   const void *values)
+{
+    this->_dispatch->vkCmdPushConstants(this->_command_buffer,
+        layout.c_ptr(), stage_flags, offset, size, values);
 }
 
 void CommandBuffer::copy_buffer(const Buffer& src, Buffer& dst,
@@ -188,18 +331,306 @@ void CommandBuffer::copy_buffer(const Buffer& src, Buffer& dst,
         vk_regions.push_back(regions[i].c_struct());
     }
 
-    vkCmdCopyBuffer(this->_command_buffer,
+    this->_dispatch->vkCmdCopyBuffer(this->_command_buffer,
         src.c_ptr(), dst.c_ptr(), count, vk_regions.data());
 }
 
+void CommandBuffer::copy_buffer(BufferRef src, BufferRef dst,
+                                const pr::Vector<BufferCopy>& regions)
+{
+    uint32_t count = regions.length();
+
+    Arena arena;
+    auto *vk_regions = arena.allocate<BufferCopy::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_regions[i] = regions[i].c_struct();
+    }
+
+    this->_dispatch->vkCmdCopyBuffer(this->_command_buffer,
+        src.c_ptr(), dst.c_ptr(), count, vk_regions);
+}
+
+void CommandBuffer::fill_buffer(BufferRef buffer,
+                                ::VkDeviceSize offset,
+                                ::VkDeviceSize size,
+                                uint32_t data)
+{
+    this->_dispatch->vkCmdFillBuffer(this->_command_buffer,
+        buffer.c_ptr(), offset, size, data);
+}
+
+void CommandBuffer::copy_buffer_to_image(BufferRef src,
+    ImageRef dst,
+    ::VkImageLayout dst_layout,
+    const pr::Vector<BufferImageCopy>& regions)
+{
+    uint32_t count = regions.length();
+
+    Arena arena;
+    auto *vk_regions = arena.allocate<BufferImageCopy::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_regions[i] = regions[i].c_struct();
+    }
+
+    this->_dispatch->vkCmdCopyBufferToImage(this->_command_buffer,
+        src.c_ptr(), dst.c_ptr(), dst_layout, count, vk_regions);
+}
+
+void CommandBuffer::copy_image_to_buffer(ImageRef src,
+    ::VkImageLayout src_layout,
+    BufferRef dst,
+    const pr::Vector<BufferImageCopy>& regions)
+{
+    uint32_t count = regions.length();
+
+    Arena arena;
+    auto *vk_regions = arena.allocate<BufferImageCopy::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_regions[i] = regions[i].c_struct();
+    }
+
+    this->_dispatch->vkCmdCopyImageToBuffer(this->_command_buffer,
+        src.c_ptr(), src_layout, dst.c_ptr(), count, vk_regions);
+}
+
+void CommandBuffer::blit_image(ImageRef src, ::VkImageLayout src_layout,
+    ImageRef dst, ::VkImageLayout dst_layout,
+    const pr::Vector<::VkImageBlit>& regions,
+    ::VkFilter filter)
+{
+    uint32_t count = regions.length();
+
+    Arena arena;
+    auto *vk_regions = arena.allocate<::VkImageBlit>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_regions[i] = regions[i];
+    }
+
+    this->_dispatch->vkCmdBlitImage(this->_command_buffer,
+        src.c_ptr(), src_layout, dst.c_ptr(), dst_layout,
+        count, vk_regions, filter);
+}
+
+void CommandBuffer::generate_mipmaps(ImageRef image,
+    ::VkExtent2D extent,
+    uint32_t mip_levels,
+    uint32_t layer_count,
+    ::VkFilter filter)
+{
+    ::VkImageMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.c_ptr();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = layer_count;
+
+    int32_t width = extent.width;
+    int32_t height = extent.height;
+    for (uint32_t level = 1; level <= mip_levels; ++level) {
+        // The previous level is done being written; read from it.
+        barrier.subresourceRange.baseMipLevel = level - 1;
+        this->pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {}, {}, { barrier });
+        if (level == mip_levels) {
+            break;
+        }
+
+        ::VkImageBlit blit;
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = layer_count;
+        blit.srcOffsets[0] = { 0, 0, 0 };
+        blit.srcOffsets[1] = { width, height, 1 };
+        width = (width > 1) ? width / 2 : 1;
+        height = (height > 1) ? height / 2 : 1;
+        blit.dstSubresource = blit.srcSubresource;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstOffsets[0] = { 0, 0, 0 };
+        blit.dstOffsets[1] = { width, height, 1 };
+
+        this->blit_image(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, { blit }, filter);
+    }
+}
+
 void CommandBuffer::end_render_pass()
 {
-    vkCmdEndRenderPass(this->_command_buffer);
+    this->_dispatch->vkCmdEndRenderPass(this->_command_buffer);
+}
+
+void CommandBuffer::pipeline_barrier(::VkPipelineStageFlags src_stage_mask,
+    ::VkPipelineStageFlags dst_stage_mask,
+    ::VkDependencyFlags dependency_flags,
+    const pr::Vector<::VkMemoryBarrier>& memory_barriers,
+    const pr::Vector<::VkBufferMemoryBarrier>& buffer_memory_barriers,
+    const pr::Vector<::VkImageMemoryBarrier>& image_memory_barriers)
+{
+    std::vector<::VkMemoryBarrier> vk_memory_barriers;
+    for (auto& barrier: memory_barriers) {
+        vk_memory_barriers.push_back(barrier);
+    }
+    std::vector<::VkBufferMemoryBarrier> vk_buffer_barriers;
+    for (auto& barrier: buffer_memory_barriers) {
+        vk_buffer_barriers.push_back(barrier);
+    }
+    std::vector<::VkImageMemoryBarrier> vk_image_barriers;
+    for (auto& barrier: image_memory_barriers) {
+        vk_image_barriers.push_back(barrier);
+    }
+
+    this->_dispatch->vkCmdPipelineBarrier(this->_command_buffer,
+        src_stage_mask, dst_stage_mask, dependency_flags,
+        vk_memory_barriers.size(), vk_memory_barriers.data(),
+        vk_buffer_barriers.size(), vk_buffer_barriers.data(),
+        vk_image_barriers.size(), vk_image_barriers.data());
+}
+
+void CommandBuffer::pipeline_barrier2(
+    const ::VkDependencyInfo& dependency_info)
+{
+    if (this->_dispatch->vkCmdPipelineBarrier2 != nullptr) {
+        this->_dispatch->vkCmdPipelineBarrier2(this->_command_buffer,
+            &dependency_info);
+        return;
+    }
+
+    // A legacy barrier has one pair of stage masks for all its barriers.
+    ::VkPipelineStageFlags2 src_stages = 0;
+    ::VkPipelineStageFlags2 dst_stages = 0;
+
+    std::vector<::VkMemoryBarrier> memory_barriers;
+    for (uint32_t i = 0; i < dependency_info.memoryBarrierCount; ++i) {
+        auto& barrier = dependency_info.pMemoryBarriers[i];
+        src_stages |= barrier.srcStageMask;
+        dst_stages |= barrier.dstStageMask;
+
+        ::VkMemoryBarrier vk_barrier;
+        vk_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        vk_barrier.pNext = nullptr;
+        vk_barrier.srcAccessMask =
+            ResourceState::legacy_access(barrier.srcAccessMask);
+        vk_barrier.dstAccessMask =
+            ResourceState::legacy_access(barrier.dstAccessMask);
+        memory_barriers.push_back(vk_barrier);
+    }
+
+    std::vector<::VkBufferMemoryBarrier> buffer_barriers;
+    for (uint32_t i = 0; i < dependency_info.bufferMemoryBarrierCount; ++i) {
+        auto& barrier = dependency_info.pBufferMemoryBarriers[i];
+        src_stages |= barrier.srcStageMask;
+        dst_stages |= barrier.dstStageMask;
+
+        ::VkBufferMemoryBarrier vk_barrier;
+        vk_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        vk_barrier.pNext = nullptr;
+        vk_barrier.srcAccessMask =
+            ResourceState::legacy_access(barrier.srcAccessMask);
+        vk_barrier.dstAccessMask =
+            ResourceState::legacy_access(barrier.dstAccessMask);
+        vk_barrier.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+        vk_barrier.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+        vk_barrier.buffer = barrier.buffer;
+        vk_barrier.offset = barrier.offset;
+        vk_barrier.size = barrier.size;
+        buffer_barriers.push_back(vk_barrier);
+    }
+
+    std::vector<::VkImageMemoryBarrier> image_barriers;
+    for (uint32_t i = 0; i < dependency_info.imageMemoryBarrierCount; ++i) {
+        auto& barrier = dependency_info.pImageMemoryBarriers[i];
+        src_stages |= barrier.srcStageMask;
+        dst_stages |= barrier.dstStageMask;
+
+        ::VkImageMemoryBarrier vk_barrier;
+        vk_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        vk_barrier.pNext = nullptr;
+        vk_barrier.srcAccessMask =
+            ResourceState::legacy_access(barrier.srcAccessMask);
+        vk_barrier.dstAccessMask =
+            ResourceState::legacy_access(barrier.dstAccessMask);
+        vk_barrier.oldLayout = barrier.oldLayout;
+        vk_barrier.newLayout = barrier.newLayout;
+        vk_barrier.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+        vk_barrier.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+        vk_barrier.image = barrier.image;
+        vk_barrier.subresourceRange = barrier.subresourceRange;
+        image_barriers.push_back(vk_barrier);
+    }
+
+    ::VkPipelineStageFlags src_stage_mask = ResourceState::legacy_stages(
+        src_stages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    ::VkPipelineStageFlags dst_stage_mask = ResourceState::legacy_stages(
+        dst_stages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    this->_dispatch->vkCmdPipelineBarrier(this->_command_buffer,
+        src_stage_mask, dst_stage_mask,
+        dependency_info.dependencyFlags,
+        memory_barriers.size(), memory_barriers.data(),
+        buffer_barriers.size(), buffer_barriers.data(),
+        image_barriers.size(), image_barriers.data());
+}
+
+bool CommandBuffer::supports_synchronization2() const
+{
+    return this->_dispatch->vkCmdPipelineBarrier2 != nullptr;
+}
+
+void CommandBuffer::reset_query_pool(QueryPoolRef pool,
+                                     uint32_t first_query,
+                                     uint32_t query_count)
+{
+    this->_dispatch->vkCmdResetQueryPool(this->_command_buffer,
+        pool.c_ptr(), first_query, query_count);
+}
+
+void CommandBuffer::write_timestamp(::VkPipelineStageFlagBits stage,
+                                    QueryPoolRef pool,
+                                    uint32_t query)
+{
+    this->_dispatch->vkCmdWriteTimestamp(this->_command_buffer,
+        stage, pool.c_ptr(), query);
+}
+
+void CommandBuffer::begin_query(QueryPoolRef pool,
+                                uint32_t query,
+                                ::VkQueryControlFlags flags)
+{
+    this->_dispatch->vkCmdBeginQuery(this->_command_buffer,
+        pool.c_ptr(), query, flags);
+}
+
+void CommandBuffer::end_query(QueryPoolRef pool, uint32_t query)
+{
+    this->_dispatch->vkCmdEndQuery(this->_command_buffer,
+        pool.c_ptr(), query);
+}
+
+void CommandBuffer::copy_query_pool_results(QueryPoolRef pool,
+                                            uint32_t first_query,
+                                            uint32_t query_count,
+                                            BufferRef dst,
+                                            ::VkDeviceSize dst_offset,
+                                            ::VkDeviceSize stride,
+                                            ::VkQueryResultFlags flags)
+{
+    this->_dispatch->vkCmdCopyQueryPoolResults(this->_command_buffer,
+        pool.c_ptr(), first_query, query_count, dst.c_ptr(), dst_offset,
+        stride, flags);
 }
 
 void CommandBuffer::end()
 {
-    ::VkResult result = vkEndCommandBuffer(this->_command_buffer);
+    ::VkResult result =
+        this->_dispatch->vkEndCommandBuffer(this->_command_buffer);
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
     }
@@ -21,6 +21,11 @@ void CommandPool::CreateInfo::set_flags(::VkCommandPoolCreateFlags flags)
     this->_info.flags = flags;
 }
 
+void CommandPool::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto CommandPool::CreateInfo::c_struct() const -> CType
 {
     return this->_info;
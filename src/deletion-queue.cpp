@@ -0,0 +1,158 @@
+#include <prime-vulkan/deletion-queue.h>
+
+#include <vector>
+
+namespace pr {
+namespace vk {
+
+// Handles are stored as uint64_t. Cast back to the handle type.
+template<typename Handle>
+static Handle to_handle(uint64_t handle)
+{
+    return reinterpret_cast<Handle>(handle);
+}
+
+DeletionQueue::DeletionQueue()
+{
+    this->_frame = 0;
+}
+
+DeletionQueue::~DeletionQueue()
+{
+    this->flush();
+}
+
+void DeletionQueue::set_frame(uint64_t frame)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_frame = frame;
+}
+
+uint64_t DeletionQueue::frame() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_frame;
+}
+
+void DeletionQueue::push_handle(::VkDevice device,
+                                ::VkObjectType type,
+                                uint64_t handle)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_entries.push_back(Entry { this->_frame, device, type, handle });
+}
+
+void DeletionQueue::collect(uint64_t completed_frame)
+{
+    std::vector<Entry> expired;
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        // Frames never decrease, so expired entries are at the front.
+        while (!this->_entries.empty() &&
+                this->_entries.front().frame <= completed_frame) {
+            expired.push_back(this->_entries.front());
+            this->_entries.pop_front();
+        }
+    }
+
+    // Destroy outside the lock, deleters may push from other threads.
+    for (auto& entry: expired) {
+        DeletionQueue::destroy(entry);
+    }
+}
+
+void DeletionQueue::flush()
+{
+    std::deque<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        entries.swap(this->_entries);
+    }
+
+    for (auto& entry: entries) {
+        DeletionQueue::destroy(entry);
+    }
+}
+
+uint64_t DeletionQueue::size() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_entries.size();
+}
+
+void DeletionQueue::destroy(const Entry& entry)
+{
+    ::VkDevice device = entry.device;
+    uint64_t handle = entry.handle;
+
+    switch (entry.type) {
+    case VK_OBJECT_TYPE_BUFFER:
+        vkDestroyBuffer(device, to_handle<::VkBuffer>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_DEVICE_MEMORY:
+        vkFreeMemory(device, to_handle<::VkDeviceMemory>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_IMAGE:
+        vkDestroyImage(device, to_handle<::VkImage>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_IMAGE_VIEW:
+        vkDestroyImageView(device, to_handle<::VkImageView>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+        vkDestroySwapchainKHR(device,
+            to_handle<::VkSwapchainKHR>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_SHADER_MODULE:
+        vkDestroyShaderModule(device,
+            to_handle<::VkShaderModule>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_PIPELINE:
+        vkDestroyPipeline(device, to_handle<::VkPipeline>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+        vkDestroyPipelineLayout(device,
+            to_handle<::VkPipelineLayout>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_RENDER_PASS:
+        vkDestroyRenderPass(device,
+            to_handle<::VkRenderPass>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_FRAMEBUFFER:
+        vkDestroyFramebuffer(device,
+            to_handle<::VkFramebuffer>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_COMMAND_POOL:
+        vkDestroyCommandPool(device,
+            to_handle<::VkCommandPool>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_SEMAPHORE:
+        vkDestroySemaphore(device, to_handle<::VkSemaphore>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_FENCE:
+        vkDestroyFence(device, to_handle<::VkFence>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:
+        vkDestroyDescriptorSetLayout(device,
+            to_handle<::VkDescriptorSetLayout>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+        vkDestroyDescriptorPool(device,
+            to_handle<::VkDescriptorPool>(handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_QUERY_POOL:
+        vkDestroyQueryPool(device,
+            to_handle<::VkQueryPool>(handle), nullptr);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace vk
+} // namespace pr
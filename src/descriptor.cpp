@@ -52,6 +52,11 @@ void DescriptorSetLayout::CreateInfo::set_bindings(
     this->_info.pBindings = this->_bindings.c_ptr();
 }
 
+void DescriptorSetLayout::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto DescriptorSetLayout::CreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -119,6 +124,11 @@ void DescriptorPool::CreateInfo::set_max_sets(uint32_t sets)
     this->_info.maxSets = sets;
 }
 
+void DescriptorPool::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto DescriptorPool::CreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -149,6 +159,12 @@ void DescriptorSet::AllocateInfo::set_descriptor_pool(
     this->_info.descriptorPool = pool.c_ptr();
 }
 
+void DescriptorSet::AllocateInfo::set_descriptor_pool(
+    DescriptorPoolRef pool)
+{
+    this->_info.descriptorPool = pool.c_ptr();
+}
+
 void DescriptorSet::AllocateInfo::set_descriptor_set_count(uint32_t count)
 {
     this->_info.descriptorSetCount = count;
@@ -163,6 +179,20 @@ void DescriptorSet::AllocateInfo::set_set_layouts(
     this->_info.pSetLayouts = this->_set_layouts.c_ptr();
 }
 
+void DescriptorSet::AllocateInfo::set_set_layouts(
+    std::initializer_list<DescriptorSetLayoutRef> layouts)
+{
+    for (auto& layout: layouts) {
+        this->_set_layouts.push(layout.c_ptr());
+    }
+    this->_info.pSetLayouts = this->_set_layouts.c_ptr();
+}
+
+void DescriptorSet::AllocateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto DescriptorSet::AllocateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -179,5 +209,80 @@ auto DescriptorSet::c_ptr() const -> CType
     return *(this->_set);
 }
 
+
+
+WriteDescriptorSet::WriteDescriptorSet()
+{
+    this->_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    this->_write.pNext = nullptr;
+
+    this->_write.dstSet = VK_NULL_HANDLE;
+    this->_write.dstBinding = 0;
+    this->_write.dstArrayElement = 0;
+    this->_write.descriptorCount = 0;
+    this->_write.pImageInfo = nullptr;
+    this->_write.pBufferInfo = nullptr;
+    this->_write.pTexelBufferView = nullptr;
+}
+
+void WriteDescriptorSet::set_dst_set(DescriptorSetRef set)
+{
+    this->_write.dstSet = set.c_ptr();
+}
+
+void WriteDescriptorSet::set_dst_binding(uint32_t binding)
+{
+    this->_write.dstBinding = binding;
+}
+
+void WriteDescriptorSet::set_dst_array_element(uint32_t element)
+{
+    this->_write.dstArrayElement = element;
+}
+
+void WriteDescriptorSet::set_descriptor_type(VkDescriptorType type)
+{
+    this->_write.descriptorType = type;
+}
+
+void WriteDescriptorSet::set_buffer_infos(
+    const pr::Vector<VkDescriptorBufferInfo>& infos)
+{
+    this->_buffer_infos.clear();
+    for (auto& info: infos) {
+        this->_buffer_infos.push_back(info);
+    }
+    this->_write.descriptorCount = this->_buffer_infos.size();
+}
+
+void WriteDescriptorSet::set_image_infos(
+    const pr::Vector<VkDescriptorImageInfo>& infos)
+{
+    this->_image_infos.clear();
+    for (auto& info: infos) {
+        this->_image_infos.push_back(info);
+    }
+    this->_write.descriptorCount = this->_image_infos.size();
+}
+
+void WriteDescriptorSet::set_next(const void *next)
+{
+    this->_write.pNext = next;
+}
+
+auto WriteDescriptorSet::c_struct() const -> CType
+{
+    // Point at this object's copies, wherever it was copied to.
+    CType write = this->_write;
+    write.pBufferInfo = (this->_buffer_infos.empty())
+        ? nullptr
+        : this->_buffer_infos.data();
+    write.pImageInfo = (this->_image_infos.empty())
+        ? nullptr
+        : this->_image_infos.data();
+
+    return write;
+}
+
 } // namespace vk
 } // namespace pr
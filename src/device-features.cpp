@@ -0,0 +1,88 @@
+#include <prime-vulkan/device-features.h>
+
+namespace pr {
+namespace vk {
+
+DeviceFeatures::DeviceFeatures()
+    : DeviceFeatures(VK_API_VERSION_1_3)
+{
+}
+
+DeviceFeatures::DeviceFeatures(uint32_t api_version)
+{
+    this->set_api_version(api_version);
+}
+
+uint32_t DeviceFeatures::api_version() const
+{
+    return this->_api_version;
+}
+
+void DeviceFeatures::set_api_version(uint32_t api_version)
+{
+    this->_api_version = api_version;
+
+    bool vulkan12 = api_version >= VK_API_VERSION_1_2;
+    this->_chain.set_linked<::VkPhysicalDeviceVulkan11Features>(vulkan12);
+    this->_chain.set_linked<::VkPhysicalDeviceVulkan12Features>(vulkan12);
+    this->_chain.set_linked<::VkPhysicalDeviceVulkan13Features>(
+        api_version >= VK_API_VERSION_1_3);
+}
+
+::VkPhysicalDeviceFeatures& DeviceFeatures::core()
+{
+    return this->_chain.get<::VkPhysicalDeviceFeatures2>().features;
+}
+
+const ::VkPhysicalDeviceFeatures& DeviceFeatures::core() const
+{
+    return this->_chain.get<::VkPhysicalDeviceFeatures2>().features;
+}
+
+::VkPhysicalDeviceVulkan11Features& DeviceFeatures::vulkan11()
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan11Features>();
+}
+
+const ::VkPhysicalDeviceVulkan11Features& DeviceFeatures::vulkan11() const
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan11Features>();
+}
+
+::VkPhysicalDeviceVulkan12Features& DeviceFeatures::vulkan12()
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan12Features>();
+}
+
+const ::VkPhysicalDeviceVulkan12Features& DeviceFeatures::vulkan12() const
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan12Features>();
+}
+
+::VkPhysicalDeviceVulkan13Features& DeviceFeatures::vulkan13()
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan13Features>();
+}
+
+const ::VkPhysicalDeviceVulkan13Features& DeviceFeatures::vulkan13() const
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan13Features>();
+}
+
+void DeviceFeatures::set_next(const void *next)
+{
+    this->_chain.set_next(next);
+}
+
+void* DeviceFeatures::head()
+{
+    return this->_chain.head();
+}
+
+const void* DeviceFeatures::head() const
+{
+    return this->_chain.head();
+}
+
+} // namespace vk
+} // namespace pr
@@ -0,0 +1,328 @@
+#include <prime-vulkan/device-selector.h>
+
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include <prime-vulkan/instance.h>
+
+namespace pr {
+namespace vk {
+
+// Whether `supported` has every `VkBool32` set in `required`, after the
+// `sType` and `pNext` of the feature structs.
+template<typename T>
+static bool has_features(const T& required, const T& supported)
+{
+    size_t offset = offsetof(T, pNext) + sizeof(void*);
+    size_t count = (sizeof(T) - offset) / sizeof(::VkBool32);
+
+    auto r = reinterpret_cast<const ::VkBool32*>(
+        reinterpret_cast<const char*>(&required) + offset);
+    auto s = reinterpret_cast<const ::VkBool32*>(
+        reinterpret_cast<const char*>(&supported) + offset);
+    for (size_t i = 0; i < count; ++i) {
+        if (r[i] == VK_TRUE && s[i] != VK_TRUE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool has_features(const ::VkPhysicalDeviceFeatures& required,
+                         const ::VkPhysicalDeviceFeatures& supported)
+{
+    size_t count = sizeof(required) / sizeof(::VkBool32);
+
+    auto r = reinterpret_cast<const ::VkBool32*>(&required);
+    auto s = reinterpret_cast<const ::VkBool32*>(&supported);
+    for (size_t i = 0; i < count; ++i) {
+        if (r[i] == VK_TRUE && s[i] != VK_TRUE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Whether any `VkBool32` of the feature struct is set.
+template<typename T>
+static bool requires_features(const T& required)
+{
+    T none;
+    memset(&none, 0, sizeof(none));
+
+    return !has_features(required, none);
+}
+
+static bool has_extension(
+    const pr::Vector<::VkExtensionProperties>& extensions,
+    const pr::String& name)
+{
+    for (uint32_t i = 0; i < extensions.length(); ++i) {
+        if (strcmp(extensions[i].extensionName, name.c_str()) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint32_t type_rank(::VkPhysicalDeviceType type,
+                          ::VkPhysicalDeviceType preferred)
+{
+    if (type == preferred) {
+        return 5;
+    }
+
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+        return 4;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+        return 3;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+        return 2;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+
+DeviceSelector::CreateInfo::CreateInfo()
+{
+    this->_preferred_type = VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+    this->_api_version = VK_API_VERSION_1_0;
+    this->_surface = nullptr;
+}
+
+void DeviceSelector::CreateInfo::set_preferred_type(
+    ::VkPhysicalDeviceType type)
+{
+    this->_preferred_type = type;
+}
+
+void DeviceSelector::CreateInfo::set_api_version(uint32_t version)
+{
+    this->_api_version = version;
+}
+
+void DeviceSelector::CreateInfo::set_required_extensions(
+    const pr::Vector<pr::String>& names)
+{
+    this->_required_extensions = names;
+}
+
+void DeviceSelector::CreateInfo::set_optional_extensions(
+    const pr::Vector<pr::String>& names)
+{
+    this->_optional_extensions = names;
+}
+
+void DeviceSelector::CreateInfo::set_required_features(
+    const DeviceFeatures& features)
+{
+    this->_features = features;
+}
+
+void DeviceSelector::CreateInfo::set_surface(const Surface& surface)
+{
+    this->_surface = &surface;
+}
+
+
+DeviceSelector::DeviceSelector(const Instance& instance,
+                               const CreateInfo& info)
+    : _info(info)
+{
+    if (this->_info._surface != nullptr) {
+        pr::String swapchain(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        bool listed = false;
+        for (auto& name: this->_info._required_extensions) {
+            listed = listed || strcmp(name.c_str(), swapchain.c_str()) == 0;
+        }
+        if (!listed) {
+            this->_info._required_extensions.push(swapchain);
+        }
+    }
+
+    auto physical_devices = PhysicalDevice::enumerate(instance);
+    for (auto& physical_device: physical_devices) {
+        this->consider(physical_device);
+    }
+    // Not needed anymore, and may not outlive the selector.
+    this->_info._surface = nullptr;
+
+    // Best first. Sorted by index, as the handles are not assignable.
+    const auto& candidates = this->_candidates;
+    std::vector<size_t> order(candidates.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [&candidates](size_t i, size_t j) {
+            const Candidate& a = candidates[i];
+            const Candidate& b = candidates[j];
+
+            return std::tie(a.type_rank, a.dedicated_families,
+                    a.device_local_size, a.optional_extensions) >
+                std::tie(b.type_rank, b.dedicated_families,
+                    b.device_local_size, b.optional_extensions);
+        });
+
+    std::vector<Candidate> sorted;
+    sorted.reserve(order.size());
+    for (size_t i: order) {
+        sorted.push_back(candidates[i]);
+    }
+    this->_candidates.swap(sorted);
+}
+
+pr::Vector<PhysicalDevice> DeviceSelector::candidates() const
+{
+    pr::Vector<PhysicalDevice> v;
+    for (auto& candidate: this->_candidates) {
+        v.push(candidate.physical_device);
+    }
+
+    return v;
+}
+
+auto DeviceSelector::select() const -> Selection
+{
+    if (this->_candidates.empty()) {
+        throw std::runtime_error("No suitable Vulkan device.");
+    }
+    const Candidate& best = this->_candidates[0];
+    const QueueTopology& topology = best.topology;
+
+    auto queue_infos = topology.queue_create_infos();
+    uint32_t present = best.present_family;
+    if (present != topology.graphics_family() &&
+            present != topology.compute_family() &&
+            present != topology.transfer_family()) {
+        Device::QueueCreateInfo queue_info;
+        queue_info.set_queue_family_index(present);
+        queue_info.set_queue_count(1);
+        queue_info.set_queue_priorities({ 1.0f });
+        queue_infos.push(queue_info);
+    }
+
+    Device::CreateInfo device_info;
+    device_info.set_queue_create_infos(queue_infos);
+    const DeviceFeatures& required = this->_info._features;
+    if (requires_features(required.vulkan11()) ||
+            requires_features(required.vulkan12()) ||
+            requires_features(required.vulkan13())) {
+        // Only chain the feature structs the device can be used with.
+        DeviceFeatures features = required;
+        features.set_api_version(best.physical_device.api_version());
+        device_info.set_enabled_features(features);
+    } else {
+        device_info.set_enabled_features(required.core());
+    }
+    device_info.set_enabled_extension_names(best.extensions);
+    Device device = best.physical_device.create_device(device_info);
+
+    return Selection {
+        best.physical_device,
+        device,
+        topology,
+        present,
+        device.queue_for(topology.graphics_family(), 0),
+        device.queue_for(topology.compute_family(), 0),
+        device.queue_for(topology.transfer_family(), 0),
+        device.queue_for(present, 0),
+        best.extensions,
+    };
+}
+
+void DeviceSelector::consider(const PhysicalDevice& physical_device)
+{
+    const auto& properties = physical_device.properties2();
+    if (physical_device.api_version() < this->_info._api_version) {
+        return;
+    }
+
+    const DeviceFeatures& required = this->_info._features;
+    const DeviceFeatures& supported = physical_device.features2();
+    if (!has_features(required.core(), supported.core()) ||
+            !has_features(required.vulkan11(), supported.vulkan11()) ||
+            !has_features(required.vulkan12(), supported.vulkan12()) ||
+            !has_features(required.vulkan13(), supported.vulkan13())) {
+        return;
+    }
+
+    auto available = physical_device.extension_properties();
+    pr::Vector<pr::String> extensions;
+    for (auto& name: this->_info._required_extensions) {
+        if (!has_extension(available, name)) {
+            return;
+        }
+        extensions.push(name);
+    }
+    uint32_t optional_extensions = 0;
+    for (auto& name: this->_info._optional_extensions) {
+        if (has_extension(available, name)) {
+            extensions.push(name);
+            ++optional_extensions;
+        }
+    }
+
+    auto families = physical_device.queue_family_properties();
+    bool has_graphics = false;
+    for (auto& family: families) {
+        has_graphics = has_graphics || (family.queue_count() > 0 &&
+            (family.queue_flags() & VK_QUEUE_GRAPHICS_BIT) != 0);
+    }
+    if (!has_graphics) {
+        return;
+    }
+    QueueTopology topology(families);
+
+    // Presenting from the graphics family saves an ownership transfer.
+    uint32_t present_family = topology.graphics_family();
+    const Surface *surface = this->_info._surface;
+    if (surface != nullptr &&
+            !physical_device.surface_support_for(present_family,
+                *surface)) {
+        present_family = families.length();
+        for (uint32_t i = 0; i < families.length(); ++i) {
+            if (physical_device.surface_support_for(i, *surface)) {
+                present_family = i;
+                break;
+            }
+        }
+        if (present_family == families.length()) {
+            return;
+        }
+    }
+
+    ::VkDeviceSize device_local_size = 0;
+    auto memory = physical_device.memory_properties().c_struct();
+    for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+        if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            device_local_size += memory.memoryHeaps[i].size;
+        }
+    }
+
+    this->_candidates.push_back(Candidate {
+        physical_device,
+        topology,
+        present_family,
+        extensions,
+        type_rank(properties.core().deviceType, this->_info._preferred_type),
+        uint32_t(topology.has_async_compute()) +
+            uint32_t(topology.has_dedicated_transfer()),
+        device_local_size,
+        optional_extensions,
+    });
+}
+
+} // namespace vk
+} // namespace pr
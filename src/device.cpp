@@ -1,10 +1,31 @@
 #include <prime-vulkan/device.h>
 
 #include <prime-vulkan/base.h>
+#include <prime-vulkan/tracer.h>
 
 namespace pr {
 namespace vk {
 
+/// Call a `vkCreate*` style function, throw on failure and count the
+/// object in the statistics.
+template<typename T, typename PFN, typename Info>
+static typename T::CType create_handle(::VkObjectType type,
+                                       PFN create,
+                                       ::VkDevice device,
+                                       const Info& info)
+{
+    auto vk_info = info.c_struct();
+    typename T::CType handle;
+    ::VkResult result = create(device, &vk_info, nullptr, &handle);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+    Statistics::object_created(type);
+
+    return handle;
+}
+
 Device::QueueCreateInfo::QueueCreateInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -14,26 +35,28 @@ Device::QueueCreateInfo::QueueCreateInfo()
     this->_info.queueCount = 0;
     this->_info.queueFamilyIndex = 0;
 
-    this->_priorities = nullptr;
+    this->_priority_count = 0;
 }
 
 Device::QueueCreateInfo::QueueCreateInfo(const QueueCreateInfo& other)
 {
-    this->_info = other._info;
-
-    this->_priorities = new float[this->_info.queueCount];
-    for (uint32_t i = 0; i < this->_info.queueCount; ++i) {
-        this->_priorities[i] = other._priorities[i];
-    }
-
-    this->_info.pQueuePriorities = this->_priorities;
+    *this = other;
 }
 
-Device::QueueCreateInfo::~QueueCreateInfo()
+auto Device::QueueCreateInfo::operator=(const QueueCreateInfo& other)
+    -> QueueCreateInfo&
 {
-    if (this->_priorities != nullptr) {
-        delete[] this->_priorities;
+    if (this == &other) {
+        return *this;
     }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_priority_count = other._priority_count;
+    this->_info.pQueuePriorities = this->_arena.copy(
+        other._info.pQueuePriorities, other._priority_count);
+
+    return *this;
 }
 
 void Device::QueueCreateInfo::set_queue_count(uint32_t count)
@@ -48,16 +71,19 @@ void Device::QueueCreateInfo::set_queue_family_index(uint32_t index)
 
 void Device::QueueCreateInfo::set_queue_priorities(const Vector<float>& priorities)
 {
-    if (this->_priorities != nullptr) {
-        delete[] this->_priorities;
-    }
+    this->_priority_count = priorities.length();
 
-    this->_priorities = new float[priorities.length()];
-    for (uint64_t i = 0; i < priorities.length(); ++i) {
-        this->_priorities[i] = priorities[i];
+    float *p = this->_arena.allocate<float>(this->_priority_count);
+    for (uint32_t i = 0; i < this->_priority_count; ++i) {
+        p[i] = priorities[i];
     }
 
-    this->_info.pQueuePriorities = this->_priorities;
+    this->_info.pQueuePriorities = p;
+}
+
+void Device::QueueCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 ::VkDeviceQueueCreateInfo Device::QueueCreateInfo::c_struct() const
@@ -73,6 +99,8 @@ Device::CreateInfo::CreateInfo()
     this->_info.pQueueCreateInfos = nullptr;
 
     this->_info.pEnabledFeatures = nullptr;
+    this->_chain_features = false;
+    this->_next = nullptr;
 
     this->_info.enabledExtensionCount = 0;
     this->_info.ppEnabledExtensionNames = nullptr;
@@ -82,32 +110,62 @@ Device::CreateInfo::CreateInfo()
     this->_info.ppEnabledLayerNames = nullptr;
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
+}
 
-    this->_queue_create_infos = nullptr;
-    this->_pp_enabled_extension_names = nullptr;
+Device::CreateInfo::CreateInfo(const CreateInfo& other)
+{
+    *this = other;
 }
 
-Device::CreateInfo::~CreateInfo()
+auto Device::CreateInfo::operator=(const CreateInfo& other) -> CreateInfo&
 {
-    if (this->_queue_create_infos != nullptr) {
-        delete[] this->_queue_create_infos;
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_enabled_features = other._enabled_features;
+    if (other._info.pEnabledFeatures != nullptr) {
+        this->_info.pEnabledFeatures = &(this->_enabled_features);
+    }
+    this->_features = other._features;
+    this->_chain_features = other._chain_features;
+    this->_next = other._next;
+    if (this->_chain_features) {
+        this->_info.pNext = this->_features.head();
     }
-    if (this->_pp_enabled_extension_names != nullptr) {
-        delete[] this->_pp_enabled_extension_names;
+
+    uint32_t count = other._info.queueCreateInfoCount;
+    auto *infos = this->_arena.copy(other._info.pQueueCreateInfos, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        infos[i].pQueuePriorities = this->_arena.copy(
+            infos[i].pQueuePriorities, infos[i].queueCount);
     }
+    this->_info.pQueueCreateInfos = infos;
+
+    this->_info.ppEnabledExtensionNames = this->_arena.copy_strings(
+        other._info.ppEnabledExtensionNames,
+        other._info.enabledExtensionCount);
+
+    return *this;
 }
 
 void Device::CreateInfo::set_queue_create_infos(
     const Vector<QueueCreateInfo>& infos)
 {
-    this->_info.queueCreateInfoCount = infos.length();
+    uint32_t count = infos.length();
 
-    this->_queue_create_infos = new ::VkDeviceQueueCreateInfo[infos.length()];
-    for (uint64_t i = 0; i < infos.length(); ++i) {
-        this->_queue_create_infos[i] = infos[i].c_struct();
+    auto *vk_infos = this->_arena.allocate<::VkDeviceQueueCreateInfo>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_infos[i] = infos[i].c_struct();
+        // The priorities belong to `infos`.
+        vk_infos[i].pQueuePriorities = this->_arena.copy(
+            vk_infos[i].pQueuePriorities, vk_infos[i].queueCount);
     }
 
-    this->_info.pQueueCreateInfos = this->_queue_create_infos;
+    this->_info.queueCreateInfoCount = count;
+    this->_info.pQueueCreateInfos = vk_infos;
 }
 
 void Device::CreateInfo::set_enabled_features(
@@ -116,21 +174,48 @@ void Device::CreateInfo::set_enabled_features(
     this->_enabled_features = features;
 
     this->_info.pEnabledFeatures = &(this->_enabled_features);
+    this->_chain_features = false;
+    this->_info.pNext = this->_next;
+}
+
+void Device::CreateInfo::set_enabled_features(const DeviceFeatures& features)
+{
+    // No `VkPhysicalDeviceFeatures2` before Vulkan 1.1.
+    if (features.api_version() < VK_API_VERSION_1_1) {
+        this->set_enabled_features(features.core());
+        return;
+    }
+
+    this->_features = features;
+    this->_features.set_next(this->_next);
+
+    this->_info.pEnabledFeatures = nullptr;
+    this->_chain_features = true;
+    this->_info.pNext = this->_features.head();
 }
 
 void Device::CreateInfo::set_enabled_extension_names(
     const Vector<String>& names)
 {
-    this->_info.enabledExtensionCount = names.length();
+    uint32_t count = names.length();
 
-    this->_enabled_extension_names = names;
-    this->_pp_enabled_extension_names = new const char*[names.length()];
-    for (uint64_t i = 0; i < names.length(); ++i) {
-        this->_pp_enabled_extension_names[i] = names[i].c_str();
-        // TODO: not name[i] but this->_enabled_extension_names[i].
+    const char **p = this->_arena.allocate<const char*>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = this->_arena.copy_string(names[i].c_str());
     }
 
-    this->_info.ppEnabledExtensionNames = this->_pp_enabled_extension_names;
+    this->_info.enabledExtensionCount = count;
+    this->_info.ppEnabledExtensionNames = p;
+}
+
+void Device::CreateInfo::set_next(const void *next)
+{
+    this->_next = next;
+    this->_features.set_next(next);
+
+    this->_info.pNext = (this->_chain_features)
+        ? this->_features.head()
+        : next;
 }
 
 ::VkDeviceCreateInfo Device::CreateInfo::c_struct() const
@@ -138,24 +223,47 @@ void Device::CreateInfo::set_enabled_extension_names(
     return this->_info;
 }
 
+void Device::CreateInfo::limit_api_version(uint32_t api_version)
+{
+    if (!this->_chain_features ||
+            this->_features.api_version() <= api_version) {
+        return;
+    }
+
+    DeviceFeatures features = this->_features;
+    features.set_api_version(api_version);
+    this->set_enabled_features(features);
+}
+
 
 Device::Device()
 {
+    this->_dispatch = DeviceDispatch::loader();
+    this->_deletion_queue = nullptr;
+    this->_memory_type_count = 0;
 }
 
 Device::Device(const Device& other)
 {
     this->_device = other._device;
+    this->_dispatch = other._dispatch;
+    this->_deletion_queue = other._deletion_queue;
+    this->_memory_type_count = other._memory_type_count;
+    for (uint32_t i = 0; i < other._memory_type_count; ++i) {
+        this->_memory_heaps[i] = other._memory_heaps[i];
+    }
 }
 
 Queue Device::queue_for(uint32_t queue_family_index,
                           uint32_t queue_index) const
 {
     ::VkQueue queue;
-    vkGetDeviceQueue(this->_device, queue_family_index, queue_index, &queue);
+    this->_dispatch->vkGetDeviceQueue(this->_device,
+        queue_family_index, queue_index, &queue);
 
     Queue ret;
     ret._queue = queue;
+    ret._dispatch = this->_dispatch.get();
 
     return ret;
 }
@@ -167,7 +275,7 @@ Swapchain Device::create_swapchain(
     ::VkSwapchainKHR vk_swapchain;
 
     auto create_info = info.c_struct();
-    result = vkCreateSwapchainKHR(this->_device, &create_info,
+    result = this->_dispatch->vkCreateSwapchainKHR(this->_device, &create_info,
         nullptr, &vk_swapchain);
 
     if (result != VK_SUCCESS) {
@@ -176,7 +284,8 @@ Swapchain Device::create_swapchain(
     Swapchain swapchain;
     swapchain._swapchain = std::shared_ptr<Swapchain::CType>(
         new Swapchain::CType(vk_swapchain),
-        Swapchain::Deleter(this->_device));
+        Swapchain::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_SWAPCHAIN_KHR);
 
     return swapchain;
 }
@@ -190,7 +299,7 @@ Vector<Image> Device::images_for(const Swapchain& swapchain) const
     uint32_t count;
     ::VkImage *vk_images;
 
-    result = vkGetSwapchainImagesKHR(this->_device,
+    result = this->_dispatch->vkGetSwapchainImagesKHR(this->_device,
         swapchain.c_ptr(), &count,
         nullptr);
 
@@ -200,7 +309,7 @@ Vector<Image> Device::images_for(const Swapchain& swapchain) const
 
     vk_images = new ::VkImage[count];
 
-    result = vkGetSwapchainImagesKHR(this->_device,
+    result = this->_dispatch->vkGetSwapchainImagesKHR(this->_device,
         swapchain.c_ptr(), &count, vk_images);
 
     if (result != VK_SUCCESS) {
@@ -209,7 +318,7 @@ Vector<Image> Device::images_for(const Swapchain& swapchain) const
     } else {
         for (uint64_t i = 0; i < count; ++i) {
             Image image;
-            image._image = vk_images[i];
+            image._image = std::make_shared<::VkImage>(vk_images[i]);
             v.push(image);
         }
 
@@ -219,6 +328,28 @@ Vector<Image> Device::images_for(const Swapchain& swapchain) const
     return v;
 }
 
+Image Device::create_image(const Image::CreateInfo& info) const
+{
+    ::VkResult result;
+
+    Image::CreateInfo::CType vk_info = info.c_struct();
+    Image::CType vk_image;
+    result = this->_dispatch->vkCreateImage(this->_device,
+        &vk_info, nullptr, &vk_image);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    Image image;
+    image._image = std::shared_ptr<Image::CType>(
+        new Image::CType(vk_image),
+        Image::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_IMAGE);
+
+    return image;
+}
+
 ImageView Device::create_image_view(
     const ImageView::CreateInfo& info) const
 {
@@ -226,7 +357,8 @@ ImageView Device::create_image_view(
 
     ::VkImageViewCreateInfo vk_info = info.c_struct();
     ::VkImageView view;
-    result = vkCreateImageView(this->_device, &vk_info, nullptr, &view);
+    result = this->_dispatch->vkCreateImageView(this->_device,
+        &vk_info, nullptr, &view);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -234,7 +366,9 @@ ImageView Device::create_image_view(
 
     ImageView image_view;
     image_view._view = std::shared_ptr<::VkImageView>(
-        new ::VkImageView(view), ImageView::Deleter(this->_device));
+        new ::VkImageView(view),
+        ImageView::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_IMAGE_VIEW);
 
     return image_view;
 }
@@ -246,7 +380,8 @@ ShaderModule Device::create_shader_module(
 
     ::VkShaderModuleCreateInfo vk_info = info.c_struct();
     ::VkShaderModule module;
-    result = vkCreateShaderModule(this->_device, &vk_info, nullptr, &module);
+    result = this->_dispatch->vkCreateShaderModule(this->_device,
+        &vk_info, nullptr, &module);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -254,7 +389,9 @@ ShaderModule Device::create_shader_module(
 
     ShaderModule shader_module;
     shader_module._shader_module = std::shared_ptr<::VkShaderModule>(
-        new ::VkShaderModule(module), ShaderModule::Deleter(this->_device));
+        new ::VkShaderModule(module),
+        ShaderModule::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_SHADER_MODULE);
 
     return shader_module;
 }
@@ -266,7 +403,7 @@ PipelineLayout Device::create_pipeline_layout(
 
     ::VkPipelineLayoutCreateInfo vk_info = info.c_struct();
     ::VkPipelineLayout c_layout;
-    result = vkCreatePipelineLayout(this->_device,
+    result = this->_dispatch->vkCreatePipelineLayout(this->_device,
         &vk_info, nullptr, &c_layout);
 
     if (result != VK_SUCCESS) {
@@ -276,7 +413,8 @@ PipelineLayout Device::create_pipeline_layout(
     PipelineLayout layout;
     layout._layout = std::shared_ptr<::VkPipelineLayout>(
         new ::VkPipelineLayout(c_layout),
-        PipelineLayout::Deleter(this->_device));
+        PipelineLayout::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_PIPELINE_LAYOUT);
 
     return layout;
 }
@@ -284,6 +422,8 @@ PipelineLayout Device::create_pipeline_layout(
 pr::Vector<Pipeline> Device::create_graphics_pipelines(
     const pr::Vector<GraphicsPipelineCreateInfo>& infos) const
 {
+    PRIME_VULKAN_TRACE_SCOPE("Device::create_graphics_pipelines");
+
     pr::Vector<Pipeline> v;
     uint32_t count = infos.length();
     GraphicsPipelineCreateInfo::CType *vk_infos =
@@ -293,8 +433,8 @@ pr::Vector<Pipeline> Device::create_graphics_pipelines(
     }
 
     Pipeline::CType *vk_pipelines = new Pipeline::CType[count];
-    ::VkResult result = vkCreateGraphicsPipelines(this->_device,
-        nullptr, count, vk_infos, nullptr, vk_pipelines);
+    ::VkResult result = this->_dispatch->vkCreateGraphicsPipelines(
+        this->_device, nullptr, count, vk_infos, nullptr, vk_pipelines);
 
     if (result != VK_SUCCESS) {
         // Free memories.
@@ -307,7 +447,9 @@ pr::Vector<Pipeline> Device::create_graphics_pipelines(
     for (uint32_t i = 0; i < count; ++i) {
         Pipeline pipeline;
         pipeline._pipeline = std::shared_ptr<Pipeline::CType>(
-            new Pipeline::CType(vk_pipelines[i]));
+            new Pipeline::CType(vk_pipelines[i]),
+            Pipeline::Deleter(this->_device, this->_deletion_queue));
+        Statistics::object_created(VK_OBJECT_TYPE_PIPELINE);
         v.push(pipeline);
     }
     delete[] vk_pipelines;
@@ -316,6 +458,39 @@ pr::Vector<Pipeline> Device::create_graphics_pipelines(
     return v;
 }
 
+pr::Vector<Pipeline> Device::create_compute_pipelines(
+    const pr::Vector<ComputePipelineCreateInfo>& infos) const
+{
+    PRIME_VULKAN_TRACE_SCOPE("Device::create_compute_pipelines");
+
+    uint32_t count = infos.length();
+    std::vector<ComputePipelineCreateInfo::CType> vk_infos;
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_infos.push_back(infos[i].c_struct());
+    }
+
+    std::vector<Pipeline::CType> vk_pipelines(count);
+    ::VkResult result = this->_dispatch->vkCreateComputePipelines(
+        this->_device, nullptr, count, vk_infos.data(), nullptr,
+        vk_pipelines.data());
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    pr::Vector<Pipeline> v;
+    for (uint32_t i = 0; i < count; ++i) {
+        Pipeline pipeline;
+        pipeline._pipeline = std::shared_ptr<Pipeline::CType>(
+            new Pipeline::CType(vk_pipelines[i]),
+            Pipeline::Deleter(this->_device, this->_deletion_queue));
+        Statistics::object_created(VK_OBJECT_TYPE_PIPELINE);
+        v.push(pipeline);
+    }
+
+    return v;
+}
+
 RenderPass Device::create_render_pass(
     const RenderPass::CreateInfo& info) const
 {
@@ -323,8 +498,8 @@ RenderPass Device::create_render_pass(
 
     RenderPass::CreateInfo::CType vk_info = info.c_struct();
     RenderPass::CType c_render_pass;
-    result = vkCreateRenderPass(this->_device, &vk_info, nullptr,
-        &c_render_pass);
+    result = this->_dispatch->vkCreateRenderPass(this->_device,
+        &vk_info, nullptr, &c_render_pass);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -333,7 +508,8 @@ RenderPass Device::create_render_pass(
     RenderPass render_pass;
     render_pass._render_pass = std::shared_ptr<RenderPass::CType>(
         new RenderPass::CType(c_render_pass),
-        RenderPass::Deleter(this->_device));
+        RenderPass::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_RENDER_PASS);
 
     return render_pass;
 }
@@ -345,8 +521,8 @@ Framebuffer Device::create_framebuffer(
 
     Framebuffer::CreateInfo::CType vk_info = info.c_struct();
     Framebuffer::CType c_framebuffer;
-    result = vkCreateFramebuffer(this->_device, &vk_info, nullptr,
-        &c_framebuffer);
+    result = this->_dispatch->vkCreateFramebuffer(this->_device,
+        &vk_info, nullptr, &c_framebuffer);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -355,7 +531,8 @@ Framebuffer Device::create_framebuffer(
     Framebuffer framebuffer;
     framebuffer._framebuffer = std::shared_ptr<Framebuffer::CType>(
         new Framebuffer::CType(c_framebuffer),
-        Framebuffer::Deleter(this->_device));
+        Framebuffer::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_FRAMEBUFFER);
 
     return framebuffer;
 }
@@ -367,8 +544,8 @@ CommandPool Device::create_command_pool(
 
     CommandPool::CreateInfo::CType vk_info = info.c_struct();
     CommandPool::CType c_command_pool;
-    result = vkCreateCommandPool(this->_device, &vk_info, nullptr,
-        &c_command_pool);
+    result = this->_dispatch->vkCreateCommandPool(this->_device,
+        &vk_info, nullptr, &c_command_pool);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -377,7 +554,8 @@ CommandPool Device::create_command_pool(
     CommandPool command_pool;
     command_pool._command_pool = std::shared_ptr<CommandPool::CType>(
         new CommandPool::CType(c_command_pool),
-        CommandPool::Deleter(this->_device));
+        CommandPool::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_COMMAND_POOL);
 
     return command_pool;
 }
@@ -389,16 +567,19 @@ CommandBuffer Device::allocate_command_buffers(
 
     CommandBuffer::AllocateInfo::CType vk_info = info.c_struct();
     CommandBuffer::CType c_command_buffer;
-    result = vkAllocateCommandBuffers(this->_device, &vk_info,
+    result = this->_dispatch->vkAllocateCommandBuffers(this->_device, &vk_info,
         &c_command_buffer);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
     }
 
+    Statistics::object_created(VK_OBJECT_TYPE_COMMAND_BUFFER);
+
     CommandBuffer command_buffer;
     // TODO: shared_ptr with custom deleter, should I?
     command_buffer._command_buffer = c_command_buffer;
+    command_buffer._dispatch = this->_dispatch.get();
 
     return command_buffer;
 }
@@ -409,7 +590,8 @@ Semaphore Device::create_semaphore(const Semaphore::CreateInfo& info) const
 
     Semaphore::CreateInfo::CType vk_info = info.c_struct();
     Semaphore::CType c_semaphore;
-    result = vkCreateSemaphore(this->_device, &vk_info, nullptr, &c_semaphore);
+    result = this->_dispatch->vkCreateSemaphore(this->_device,
+        &vk_info, nullptr, &c_semaphore);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -418,7 +600,8 @@ Semaphore Device::create_semaphore(const Semaphore::CreateInfo& info) const
     Semaphore semaphore;
     semaphore._semaphore = std::shared_ptr<Semaphore::CType>(
         new Semaphore::CType(c_semaphore),
-        Semaphore::Deleter(this->_device));
+        Semaphore::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_SEMAPHORE);
 
     return semaphore;
 }
@@ -429,7 +612,8 @@ Fence Device::create_fence(const Fence::CreateInfo& info) const
 
     Fence::CreateInfo::CType vk_info = info.c_struct();
     Fence::CType c_fence;
-    result = vkCreateFence(this->_device, &vk_info, nullptr, &c_fence);
+    result = this->_dispatch->vkCreateFence(this->_device,
+        &vk_info, nullptr, &c_fence);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -438,7 +622,8 @@ Fence Device::create_fence(const Fence::CreateInfo& info) const
     Fence fence;
     fence._fence = std::shared_ptr<Fence::CType>(
         new Fence::CType(c_fence),
-        Fence::Deleter(this->_device));
+        Fence::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_FENCE);
 
     return fence;
 }
@@ -449,7 +634,8 @@ Buffer Device::create_buffer(const Buffer::CreateInfo& info) const
 
     Buffer::CreateInfo::CType vk_info = info.c_struct();
     Buffer::CType vk_buffer;
-    result = vkCreateBuffer(this->_device, &vk_info, nullptr, &vk_buffer);
+    result = this->_dispatch->vkCreateBuffer(this->_device,
+        &vk_info, nullptr, &vk_buffer);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -458,7 +644,8 @@ Buffer Device::create_buffer(const Buffer::CreateInfo& info) const
     Buffer buffer;
     buffer._buffer = std::shared_ptr<Buffer::CType>(
         new Buffer::CType(vk_buffer),
-        Buffer::Deleter(this->_device));
+        Buffer::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_BUFFER);
 
     return buffer;
 }
@@ -470,8 +657,8 @@ DescriptorSetLayout Device::create_descriptor_set_layout(
 
     DescriptorSetLayout::CreateInfo::CType vk_info = info.c_struct();
     DescriptorSetLayout::CType vk_layout;
-    result = vkCreateDescriptorSetLayout(this->_device, &vk_info, nullptr,
-        &vk_layout);
+    result = this->_dispatch->vkCreateDescriptorSetLayout(this->_device,
+        &vk_info, nullptr, &vk_layout);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -480,7 +667,8 @@ DescriptorSetLayout Device::create_descriptor_set_layout(
     DescriptorSetLayout layout;
     layout._layout = std::shared_ptr<DescriptorSetLayout::CType>(
         new DescriptorSetLayout::CType(vk_layout),
-        DescriptorSetLayout::Deleter(this->_device));
+        DescriptorSetLayout::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
 
     return layout;
 }
@@ -492,8 +680,8 @@ DescriptorPool Device::create_descriptor_pool(
 
     DescriptorPool::CreateInfo::CType vk_info = info.c_struct();
     DescriptorPool::CType vk_pool;
-    result = vkCreateDescriptorPool(this->_device, &vk_info, nullptr,
-        &vk_pool);
+    result = this->_dispatch->vkCreateDescriptorPool(this->_device,
+        &vk_info, nullptr, &vk_pool);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -502,7 +690,8 @@ DescriptorPool Device::create_descriptor_pool(
     DescriptorPool pool;
     pool._pool = std::shared_ptr<DescriptorPool::CType>(
         new DescriptorPool::CType(vk_pool),
-        DescriptorPool::Deleter(this->_device));
+        DescriptorPool::Deleter(this->_device, this->_deletion_queue));
+    Statistics::object_created(VK_OBJECT_TYPE_DESCRIPTOR_POOL);
 
     return pool;
 }
@@ -517,7 +706,8 @@ pr::Vector<DescriptorSet> Device::allocate_descriptor_sets(
     DescriptorSet::AllocateInfo::CType vk_info = info.c_struct();
     DescriptorSet::CType *vk_sets =
         new DescriptorSet::CType[vk_info.descriptorSetCount];
-    result = vkAllocateDescriptorSets(this->_device, &vk_info, vk_sets);
+    result = this->_dispatch->vkAllocateDescriptorSets(this->_device,
+        &vk_info, vk_sets);
 
     if (result != VK_SUCCESS) {
         delete[] vk_sets;
@@ -529,6 +719,8 @@ pr::Vector<DescriptorSet> Device::allocate_descriptor_sets(
         set._set = std::make_shared<DescriptorSet::CType>(vk_sets[i]);
         sets.push(set);
     }
+    Statistics::object_created(VK_OBJECT_TYPE_DESCRIPTOR_SET,
+        vk_info.descriptorSetCount);
 
     delete[] vk_sets;
 
@@ -539,6 +731,8 @@ void Device::wait_for_fences(const Vector<Fence>& fences,
                                bool wait_all,
                                uint64_t timeout) const
 {
+    PRIME_VULKAN_TRACE_SCOPE("Device::wait_for_fences");
+
     ::VkResult result;
 
     uint64_t count = fences.length();
@@ -549,7 +743,7 @@ void Device::wait_for_fences(const Vector<Fence>& fences,
 
     ::VkBool32 vk_wait_all = (wait_all) ? VK_TRUE : VK_FALSE;
 
-    result = vkWaitForFences(this->_device,
+    result = this->_dispatch->vkWaitForFences(this->_device,
         count, vk_fences, vk_wait_all, timeout);
 
     delete[] vk_fences;
@@ -569,7 +763,7 @@ void Device::reset_fences(const Vector<Fence>& fences) const
         vk_fences[i] = fences[i].c_ptr();
     }
 
-    result = vkResetFences(this->_device, count, vk_fences);
+    result = this->_dispatch->vkResetFences(this->_device, count, vk_fences);
 
     delete[] vk_fences;
 
@@ -582,11 +776,13 @@ uint32_t Device::acquire_next_image(const Swapchain& swapchain,
                                       uint64_t timeout,
                                       const Semaphore& semaphore) const
 {
+    PRIME_VULKAN_TRACE_SCOPE("Device::acquire_next_image");
+
     ::VkResult result;
     uint32_t index;
 
-    result = vkAcquireNextImageKHR(this->_device, swapchain.c_ptr(), timeout,
-        semaphore.c_ptr(), nullptr, &index);
+    result = this->_dispatch->vkAcquireNextImageKHR(this->_device,
+        swapchain.c_ptr(), timeout, semaphore.c_ptr(), nullptr, &index);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -599,7 +795,20 @@ MemoryRequirements Device::memory_requirements_for(const Buffer& buffer) const
 {
     MemoryRequirements::CType vk_requirements;
     Buffer::CType vk_buffer = buffer.c_ptr();
-    vkGetBufferMemoryRequirements(this->_device, vk_buffer, &vk_requirements);
+    this->_dispatch->vkGetBufferMemoryRequirements(this->_device,
+        vk_buffer, &vk_requirements);
+
+    MemoryRequirements requirements;
+    requirements._requirements = vk_requirements;
+
+    return requirements;
+}
+
+MemoryRequirements Device::memory_requirements_for(const Image& image) const
+{
+    MemoryRequirements::CType vk_requirements;
+    this->_dispatch->vkGetImageMemoryRequirements(this->_device,
+        image.c_ptr(), &vk_requirements);
 
     MemoryRequirements requirements;
     requirements._requirements = vk_requirements;
@@ -613,7 +822,8 @@ DeviceMemory Device::allocate_memory(const MemoryAllocateInfo& info) const
     MemoryAllocateInfo::CType vk_info = info.c_struct();
     DeviceMemory::CType vk_memory;
 
-    result = vkAllocateMemory(this->_device, &vk_info, nullptr, &vk_memory);
+    result = this->_dispatch->vkAllocateMemory(this->_device,
+        &vk_info, nullptr, &vk_memory);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -622,7 +832,11 @@ DeviceMemory Device::allocate_memory(const MemoryAllocateInfo& info) const
     DeviceMemory memory;
     memory._memory = std::shared_ptr<DeviceMemory::CType>(
         new DeviceMemory::CType(vk_memory),
-        DeviceMemory::Deleter(this->_device));
+        DeviceMemory::Deleter(this->_device, this->_deletion_queue,
+            vk_info.memoryTypeIndex, vk_info.allocationSize));
+    Statistics::object_created(VK_OBJECT_TYPE_DEVICE_MEMORY);
+    Statistics::memory_allocated(vk_info.memoryTypeIndex,
+        vk_info.allocationSize);
 
     return memory;
 }
@@ -633,7 +847,7 @@ void Device::bind_buffer_memory(Buffer& buffer,
 {
     ::VkResult result;
 
-    result = vkBindBufferMemory(this->_device,
+    result = this->_dispatch->vkBindBufferMemory(this->_device,
         buffer.c_ptr(), memory.c_ptr(), offset);
 
     if (result != VK_SUCCESS) {
@@ -646,6 +860,20 @@ void Device::bind_memory_to_buffer(Buffer& b, DeviceMemory& m, ::VkDeviceSize s)
     this->bind_buffer_memory(b, m, s);
 }
 
+void Device::bind_image_memory(Image& image,
+                               DeviceMemory& memory,
+                               ::VkDeviceSize offset)
+{
+    ::VkResult result;
+
+    result = this->_dispatch->vkBindImageMemory(this->_device,
+        image.c_ptr(), memory.c_ptr(), offset);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
 void Device::map_memory(DeviceMemory& memory,
                         ::VkDeviceSize offset,
                         ::VkDeviceSize size,
@@ -654,25 +882,442 @@ void Device::map_memory(DeviceMemory& memory,
 {
     ::VkResult result;
 
-    result = vkMapMemory(this->_device,
+    result = this->_dispatch->vkMapMemory(this->_device,
         memory.c_ptr(), offset, size, flags, data);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
     }
+    Statistics::memory_mapped();
 }
 
 void Device::unmap_memory(DeviceMemory& memory)
 {
-    vkUnmapMemory(this->_device, memory.c_ptr());
+    this->_dispatch->vkUnmapMemory(this->_device, memory.c_ptr());
+    Statistics::memory_unmapped();
+}
+
+UniqueSwapchain Device::create_unique_swapchain(
+    const Swapchain::CreateInfo& info) const
+{
+    return UniqueSwapchain(
+        create_handle<Swapchain>(VK_OBJECT_TYPE_SWAPCHAIN_KHR,
+            this->_dispatch->vkCreateSwapchainKHR, this->_device, info),
+        Swapchain::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueImage Device::create_unique_image(const Image::CreateInfo& info) const
+{
+    return UniqueImage(
+        create_handle<Image>(VK_OBJECT_TYPE_IMAGE,
+            this->_dispatch->vkCreateImage, this->_device, info),
+        Image::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueImageView Device::create_unique_image_view(
+    const ImageView::CreateInfo& info) const
+{
+    return UniqueImageView(
+        create_handle<ImageView>(VK_OBJECT_TYPE_IMAGE_VIEW,
+            this->_dispatch->vkCreateImageView, this->_device, info),
+        ImageView::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueShaderModule Device::create_unique_shader_module(
+    const ShaderModule::CreateInfo& info) const
+{
+    return UniqueShaderModule(
+        create_handle<ShaderModule>(VK_OBJECT_TYPE_SHADER_MODULE,
+            this->_dispatch->vkCreateShaderModule, this->_device, info),
+        ShaderModule::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniquePipelineLayout Device::create_unique_pipeline_layout(
+    const PipelineLayout::CreateInfo& info) const
+{
+    return UniquePipelineLayout(
+        create_handle<PipelineLayout>(VK_OBJECT_TYPE_PIPELINE_LAYOUT,
+            this->_dispatch->vkCreatePipelineLayout, this->_device, info),
+        PipelineLayout::Deleter(this->_device, this->_deletion_queue));
+}
+
+std::vector<UniquePipeline> Device::create_unique_graphics_pipelines(
+    const pr::Vector<GraphicsPipelineCreateInfo>& infos) const
+{
+    PRIME_VULKAN_TRACE_SCOPE("Device::create_graphics_pipelines");
+
+    uint32_t count = infos.length();
+    std::vector<GraphicsPipelineCreateInfo::CType> vk_infos;
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_infos.push_back(infos[i].c_struct());
+    }
+
+    std::vector<Pipeline::CType> vk_pipelines(count);
+    ::VkResult result = this->_dispatch->vkCreateGraphicsPipelines(
+        this->_device, nullptr, count, vk_infos.data(), nullptr,
+        vk_pipelines.data());
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    std::vector<UniquePipeline> v;
+    v.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        v.emplace_back(vk_pipelines[i],
+            Pipeline::Deleter(this->_device, this->_deletion_queue));
+    }
+    Statistics::object_created(VK_OBJECT_TYPE_PIPELINE, count);
+
+    return v;
+}
+
+std::vector<UniquePipeline> Device::create_unique_compute_pipelines(
+    const pr::Vector<ComputePipelineCreateInfo>& infos) const
+{
+    PRIME_VULKAN_TRACE_SCOPE("Device::create_compute_pipelines");
+
+    uint32_t count = infos.length();
+    std::vector<ComputePipelineCreateInfo::CType> vk_infos;
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_infos.push_back(infos[i].c_struct());
+    }
+
+    std::vector<Pipeline::CType> vk_pipelines(count);
+    ::VkResult result = this->_dispatch->vkCreateComputePipelines(
+        this->_device, nullptr, count, vk_infos.data(), nullptr,
+        vk_pipelines.data());
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    std::vector<UniquePipeline> v;
+    v.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        v.emplace_back(vk_pipelines[i],
+            Pipeline::Deleter(this->_device, this->_deletion_queue));
+    }
+    Statistics::object_created(VK_OBJECT_TYPE_PIPELINE, count);
+
+    return v;
+}
+
+UniqueRenderPass Device::create_unique_render_pass(
+    const RenderPass::CreateInfo& info) const
+{
+    return UniqueRenderPass(
+        create_handle<RenderPass>(VK_OBJECT_TYPE_RENDER_PASS,
+            this->_dispatch->vkCreateRenderPass, this->_device, info),
+        RenderPass::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueFramebuffer Device::create_unique_framebuffer(
+    const Framebuffer::CreateInfo& info) const
+{
+    return UniqueFramebuffer(
+        create_handle<Framebuffer>(VK_OBJECT_TYPE_FRAMEBUFFER,
+            this->_dispatch->vkCreateFramebuffer, this->_device, info),
+        Framebuffer::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueCommandPool Device::create_unique_command_pool(
+    const CommandPool::CreateInfo& info) const
+{
+    return UniqueCommandPool(
+        create_handle<CommandPool>(VK_OBJECT_TYPE_COMMAND_POOL,
+            this->_dispatch->vkCreateCommandPool, this->_device, info),
+        CommandPool::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueSemaphore Device::create_unique_semaphore(
+    const Semaphore::CreateInfo& info) const
+{
+    return UniqueSemaphore(
+        create_handle<Semaphore>(VK_OBJECT_TYPE_SEMAPHORE,
+            this->_dispatch->vkCreateSemaphore, this->_device, info),
+        Semaphore::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueFence Device::create_unique_fence(const Fence::CreateInfo& info) const
+{
+    return UniqueFence(
+        create_handle<Fence>(VK_OBJECT_TYPE_FENCE,
+            this->_dispatch->vkCreateFence, this->_device, info),
+        Fence::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueBuffer Device::create_unique_buffer(const Buffer::CreateInfo& info) const
+{
+    return UniqueBuffer(
+        create_handle<Buffer>(VK_OBJECT_TYPE_BUFFER,
+            this->_dispatch->vkCreateBuffer, this->_device, info),
+        Buffer::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueDescriptorSetLayout Device::create_unique_descriptor_set_layout(
+    const DescriptorSetLayout::CreateInfo& info) const
+{
+    return UniqueDescriptorSetLayout(
+        create_handle<DescriptorSetLayout>(
+            VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT,
+            this->_dispatch->vkCreateDescriptorSetLayout, this->_device, info),
+        DescriptorSetLayout::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueDescriptorPool Device::create_unique_descriptor_pool(
+    const DescriptorPool::CreateInfo& info) const
+{
+    return UniqueDescriptorPool(
+        create_handle<DescriptorPool>(VK_OBJECT_TYPE_DESCRIPTOR_POOL,
+            this->_dispatch->vkCreateDescriptorPool, this->_device, info),
+        DescriptorPool::Deleter(this->_device, this->_deletion_queue));
+}
+
+UniqueDeviceMemory Device::allocate_unique_memory(
+    const MemoryAllocateInfo& info) const
+{
+    auto handle = create_handle<DeviceMemory>(VK_OBJECT_TYPE_DEVICE_MEMORY,
+        this->_dispatch->vkAllocateMemory, this->_device, info);
+    auto vk_info = info.c_struct();
+    Statistics::memory_allocated(vk_info.memoryTypeIndex,
+        vk_info.allocationSize);
+
+    return UniqueDeviceMemory(handle,
+        DeviceMemory::Deleter(this->_device, this->_deletion_queue,
+            vk_info.memoryTypeIndex, vk_info.allocationSize));
+}
+
+UniqueQueryPool Device::create_unique_query_pool(
+    const QueryPool::CreateInfo& info) const
+{
+    return UniqueQueryPool(
+        create_handle<QueryPool>(VK_OBJECT_TYPE_QUERY_POOL,
+            this->_dispatch->vkCreateQueryPool, this->_device, info),
+        QueryPool::Deleter(this->_device, this->_deletion_queue));
+}
+
+void Device::wait_for_fences(std::initializer_list<FenceRef> fences,
+                             bool wait_all,
+                             uint64_t timeout) const
+{
+    PRIME_VULKAN_TRACE_SCOPE("Device::wait_for_fences");
+
+    ::VkBool32 vk_wait_all = (wait_all) ? VK_TRUE : VK_FALSE;
+
+    ::VkResult result = this->_dispatch->vkWaitForFences(this->_device,
+        fences.size(), FenceRef::c_ptrs(fences.begin()), vk_wait_all,
+        timeout);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+void Device::reset_fences(std::initializer_list<FenceRef> fences) const
+{
+    ::VkResult result = this->_dispatch->vkResetFences(this->_device,
+        fences.size(), FenceRef::c_ptrs(fences.begin()));
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+bool Device::get_fence_status(FenceRef fence) const
+{
+    ::VkResult result = this->_dispatch->vkGetFenceStatus(this->_device,
+        fence.c_ptr());
+
+    if (result == VK_NOT_READY) {
+        return false;
+    }
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    return true;
+}
+
+bool Device::get_query_pool_results(QueryPoolRef pool,
+                                    uint32_t first_query,
+                                    uint32_t query_count,
+                                    size_t data_size,
+                                    void *data,
+                                    ::VkDeviceSize stride,
+                                    ::VkQueryResultFlags flags) const
+{
+    ::VkResult result = this->_dispatch->vkGetQueryPoolResults(
+        this->_device, pool.c_ptr(), first_query, query_count,
+        data_size, data, stride, flags);
+
+    if (result == VK_NOT_READY) {
+        return false;
+    }
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    return true;
+}
+
+uint32_t Device::acquire_next_image(SwapchainRef swapchain,
+                                    uint64_t timeout,
+                                    SemaphoreRef semaphore) const
+{
+    PRIME_VULKAN_TRACE_SCOPE("Device::acquire_next_image");
+
+    uint32_t index;
+
+    ::VkResult result = this->_dispatch->vkAcquireNextImageKHR(this->_device,
+        swapchain.c_ptr(), timeout, semaphore.c_ptr(), nullptr, &index);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    return index;
+}
+
+MemoryRequirements Device::memory_requirements_for(BufferRef buffer) const
+{
+    MemoryRequirements requirements;
+    this->_dispatch->vkGetBufferMemoryRequirements(this->_device,
+        buffer.c_ptr(), &requirements._requirements);
+
+    return requirements;
+}
+
+MemoryRequirements Device::memory_requirements_for(ImageRef image) const
+{
+    MemoryRequirements requirements;
+    this->_dispatch->vkGetImageMemoryRequirements(this->_device,
+        image.c_ptr(), &requirements._requirements);
+
+    return requirements;
+}
+
+void Device::bind_buffer_memory(BufferRef buffer,
+                                DeviceMemoryRef memory,
+                                ::VkDeviceSize offset)
+{
+    ::VkResult result = this->_dispatch->vkBindBufferMemory(this->_device,
+        buffer.c_ptr(), memory.c_ptr(), offset);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+void Device::bind_image_memory(ImageRef image,
+                               DeviceMemoryRef memory,
+                               ::VkDeviceSize offset)
+{
+    ::VkResult result = this->_dispatch->vkBindImageMemory(this->_device,
+        image.c_ptr(), memory.c_ptr(), offset);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+void Device::map_memory(DeviceMemoryRef memory,
+                        ::VkDeviceSize offset,
+                        ::VkDeviceSize size,
+                        ::VkMemoryMapFlags flags,
+                        void **data)
+{
+    ::VkResult result = this->_dispatch->vkMapMemory(this->_device,
+        memory.c_ptr(), offset, size, flags, data);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+    Statistics::memory_mapped();
+}
+
+void Device::unmap_memory(DeviceMemoryRef memory)
+{
+    this->_dispatch->vkUnmapMemory(this->_device, memory.c_ptr());
+    Statistics::memory_unmapped();
+}
+
+void Device::flush_mapped_memory(DeviceMemoryRef memory,
+                                 ::VkDeviceSize offset,
+                                 ::VkDeviceSize size) const
+{
+    ::VkMappedMemoryRange range;
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = memory.c_ptr();
+    range.offset = offset;
+    range.size = size;
+    range.pNext = nullptr;
+
+    ::VkResult result = this->_dispatch->vkFlushMappedMemoryRanges(
+        this->_device, 1, &range);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+void Device::invalidate_mapped_memory(DeviceMemoryRef memory,
+                                      ::VkDeviceSize offset,
+                                      ::VkDeviceSize size) const
+{
+    ::VkMappedMemoryRange range;
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = memory.c_ptr();
+    range.offset = offset;
+    range.size = size;
+    range.pNext = nullptr;
+
+    ::VkResult result = this->_dispatch->vkInvalidateMappedMemoryRanges(
+        this->_device, 1, &range);
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+void Device::update_descriptor_sets(
+    const pr::Vector<WriteDescriptorSet>& writes) const
+{
+    std::vector<::VkWriteDescriptorSet> vk_writes;
+    for (auto& write: writes) {
+        vk_writes.push_back(write.c_struct());
+    }
+
+    this->_dispatch->vkUpdateDescriptorSets(this->_device,
+        vk_writes.size(), vk_writes.data(), 0, nullptr);
 }
 
 void Device::wait_idle()
 {
-    vkDeviceWaitIdle(this->_device);
+    this->_dispatch->vkDeviceWaitIdle(this->_device);
     // TODO: Throw exception.
 }
 
+void Device::set_deletion_queue(DeletionQueue *deletion_queue)
+{
+    this->_deletion_queue = deletion_queue;
+}
+
+DeletionQueue* Device::deletion_queue() const
+{
+    return this->_deletion_queue;
+}
+
+Statistics Device::statistics() const
+{
+    return Statistics(this->_memory_heaps, this->_memory_type_count);
+}
+
+auto Device::dispatch() const -> const DeviceDispatch&
+{
+    return *(this->_dispatch);
+}
+
 auto Device::c_ptr() -> CType
 {
     return this->_device;
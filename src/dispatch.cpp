@@ -0,0 +1,212 @@
+#include <prime-vulkan/dispatch.h>
+
+#include <string.h>
+
+// Every function in the table. Keep in sync with dispatch.h.
+#define PRIME_VULKAN_DEVICE_FUNCTIONS(X) \
+    X(vkGetDeviceQueue) \
+    X(vkDeviceWaitIdle) \
+    X(vkCreateSwapchainKHR) \
+    X(vkGetSwapchainImagesKHR) \
+    X(vkAcquireNextImageKHR) \
+    X(vkCreateImage) \
+    X(vkGetImageMemoryRequirements) \
+    X(vkBindImageMemory) \
+    X(vkCreateImageView) \
+    X(vkCreateShaderModule) \
+    X(vkCreatePipelineLayout) \
+    X(vkCreateGraphicsPipelines) \
+    X(vkCreateComputePipelines) \
+    X(vkCreateRenderPass) \
+    X(vkCreateFramebuffer) \
+    X(vkCreateCommandPool) \
+    X(vkAllocateCommandBuffers) \
+    X(vkCreateSemaphore) \
+    X(vkCreateFence) \
+    X(vkWaitForFences) \
+    X(vkResetFences) \
+    X(vkGetFenceStatus) \
+    X(vkCreateQueryPool) \
+    X(vkGetQueryPoolResults) \
+    X(vkCreateBuffer) \
+    X(vkGetBufferMemoryRequirements) \
+    X(vkAllocateMemory) \
+    X(vkBindBufferMemory) \
+    X(vkMapMemory) \
+    X(vkUnmapMemory) \
+    X(vkFlushMappedMemoryRanges) \
+    X(vkInvalidateMappedMemoryRanges) \
+    X(vkCreateDescriptorSetLayout) \
+    X(vkCreateDescriptorPool) \
+    X(vkAllocateDescriptorSets) \
+    X(vkUpdateDescriptorSets) \
+    X(vkQueueSubmit) \
+    X(vkQueuePresentKHR) \
+    X(vkQueueWaitIdle) \
+    X(vkBeginCommandBuffer) \
+    X(vkResetCommandBuffer) \
+    X(vkEndCommandBuffer) \
+    X(vkCmdBeginRenderPass) \
+    X(vkCmdEndRenderPass) \
+    X(vkCmdBindPipeline) \
+    X(vkCmdSetViewport) \
+    X(vkCmdSetScissor) \
+    X(vkCmdBindVertexBuffers) \
+    X(vkCmdBindIndexBuffer) \
+    X(vkCmdBindDescriptorSets) \
+    X(vkCmdPushConstants) \
+    X(vkCmdDraw) \
+    X(vkCmdDrawIndexed) \
+    X(vkCmdDrawIndirect) \
+    X(vkCmdDrawIndexedIndirect) \
+    X(vkCmdDispatch) \
+    X(vkCmdDispatchIndirect) \
+    X(vkCmdCopyBuffer) \
+    X(vkCmdFillBuffer) \
+    X(vkCmdCopyBufferToImage) \
+    X(vkCmdBlitImage) \
+    X(vkCmdCopyImageToBuffer) \
+    X(vkCmdPipelineBarrier) \
+    X(vkCmdResetQueryPool) \
+    X(vkCmdWriteTimestamp) \
+    X(vkCmdBeginQuery) \
+    X(vkCmdEndQuery) \
+    X(vkCmdCopyQueryPoolResults)
+
+namespace pr {
+namespace vk {
+
+template<typename PFN>
+static PFN device_proc_addr(::VkDevice device, const char *name, PFN fallback)
+{
+    PFN fn = reinterpret_cast<PFN>(::vkGetDeviceProcAddr(device, name));
+
+    return (fn != nullptr) ? fn : fallback;
+}
+
+// Whether synchronization2 is enabled through Vulkan 1.3 features or
+// VK_KHR_synchronization2 features in the pNext chain.
+static bool synchronization2_enabled(const ::VkDeviceCreateInfo& info)
+{
+    auto next = static_cast<const ::VkBaseInStructure*>(info.pNext);
+    for (; next != nullptr; next = next->pNext) {
+        if (next->sType ==
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES) {
+            auto features =
+                reinterpret_cast<const ::VkPhysicalDeviceVulkan13Features*>(
+                    next);
+            if (features->synchronization2 == VK_TRUE) {
+                return true;
+            }
+        } else if (next->sType ==
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES) {
+            auto features = reinterpret_cast<
+                const ::VkPhysicalDeviceSynchronization2Features*>(next);
+            if (features->synchronization2 == VK_TRUE) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Whether the Vulkan 1.2 drawIndirectCount feature is enabled in the
+// pNext chain.
+static bool draw_indirect_count_enabled(const ::VkDeviceCreateInfo& info)
+{
+    auto next = static_cast<const ::VkBaseInStructure*>(info.pNext);
+    for (; next != nullptr; next = next->pNext) {
+        if (next->sType ==
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES) {
+            auto features =
+                reinterpret_cast<const ::VkPhysicalDeviceVulkan12Features*>(
+                    next);
+            if (features->drawIndirectCount == VK_TRUE) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static bool extension_enabled(const ::VkDeviceCreateInfo& info,
+                              const char *name)
+{
+    for (uint32_t i = 0; i < info.enabledExtensionCount; ++i) {
+        if (strcmp(info.ppEnabledExtensionNames[i], name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+DeviceDispatch::DeviceDispatch()
+{
+#define PRIME_VULKAN_LOADER_FUNCTION(name) this->name = ::name;
+    PRIME_VULKAN_DEVICE_FUNCTIONS(PRIME_VULKAN_LOADER_FUNCTION)
+#undef PRIME_VULKAN_LOADER_FUNCTION
+
+    this->vkCmdPipelineBarrier2 = nullptr;
+    this->vkCmdDrawIndirectCount = nullptr;
+    this->vkCmdDrawIndexedIndirectCount = nullptr;
+}
+
+std::shared_ptr<const DeviceDispatch> DeviceDispatch::load(::VkDevice device,
+    const ::VkDeviceCreateInfo& info)
+{
+    DeviceDispatch *table = new DeviceDispatch();
+
+#ifdef PRIME_VULKAN_DEVICE_DISPATCH
+#define PRIME_VULKAN_DEVICE_FUNCTION(name) \
+    table->name = device_proc_addr(device, #name, table->name);
+    PRIME_VULKAN_DEVICE_FUNCTIONS(PRIME_VULKAN_DEVICE_FUNCTION)
+#undef PRIME_VULKAN_DEVICE_FUNCTION
+#endif
+
+    if (synchronization2_enabled(info)) {
+        // Core in 1.3, the KHR name before that.
+        table->vkCmdPipelineBarrier2 = device_proc_addr(device,
+            "vkCmdPipelineBarrier2", table->vkCmdPipelineBarrier2);
+        if (table->vkCmdPipelineBarrier2 == nullptr) {
+            table->vkCmdPipelineBarrier2 = device_proc_addr(device,
+                "vkCmdPipelineBarrier2KHR", table->vkCmdPipelineBarrier2);
+        }
+    }
+
+    // A feature of 1.2, VK_KHR_draw_indirect_count before that. The
+    // functions can be exported without either being enabled.
+    if (draw_indirect_count_enabled(info)) {
+        table->vkCmdDrawIndirectCount = device_proc_addr(device,
+            "vkCmdDrawIndirectCount", table->vkCmdDrawIndirectCount);
+        table->vkCmdDrawIndexedIndirectCount = device_proc_addr(device,
+            "vkCmdDrawIndexedIndirectCount",
+            table->vkCmdDrawIndexedIndirectCount);
+    }
+    if (extension_enabled(info, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)) {
+        if (table->vkCmdDrawIndirectCount == nullptr) {
+            table->vkCmdDrawIndirectCount = device_proc_addr(device,
+                "vkCmdDrawIndirectCountKHR", table->vkCmdDrawIndirectCount);
+        }
+        if (table->vkCmdDrawIndexedIndirectCount == nullptr) {
+            table->vkCmdDrawIndexedIndirectCount = device_proc_addr(device,
+                "vkCmdDrawIndexedIndirectCountKHR",
+                table->vkCmdDrawIndexedIndirectCount);
+        }
+    }
+
+    return std::shared_ptr<const DeviceDispatch>(table);
+}
+
+std::shared_ptr<const DeviceDispatch> DeviceDispatch::loader()
+{
+    static const std::shared_ptr<const DeviceDispatch> table(
+        new DeviceDispatch());
+
+    return table;
+}
+
+} // namespace vk
+} // namespace pr
@@ -16,6 +16,11 @@ void Fence::CreateInfo::set_flags(::VkFenceCreateFlags flags)
     this->_info.flags = flags;
 }
 
+void Fence::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Fence::CreateInfo::c_struct() const -> CType
 {
     return this->_info;
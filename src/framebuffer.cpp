@@ -19,6 +19,11 @@ void Framebuffer::CreateInfo::set_render_pass(const RenderPass& render_pass)
     this->_info.renderPass = render_pass.c_ptr();
 }
 
+void Framebuffer::CreateInfo::set_render_pass(RenderPassRef render_pass)
+{
+    this->_info.renderPass = render_pass.c_ptr();
+}
+
 void Framebuffer::CreateInfo::set_attachments(
     const pr::Vector<ImageView>& attachments)
 {
@@ -31,6 +36,16 @@ void Framebuffer::CreateInfo::set_attachments(
     this->_info.pAttachments = this->_attachments.data();
 }
 
+void Framebuffer::CreateInfo::set_attachments(
+    std::initializer_list<ImageViewRef> views)
+{
+    const ImageView::CType *p = ImageViewRef::c_ptrs(views.begin());
+    this->_attachments.assign(p, p + views.size());
+
+    this->_info.attachmentCount = views.size();
+    this->_info.pAttachments = this->_attachments.data();
+}
+
 void Framebuffer::CreateInfo::set_width(uint32_t width)
 {
     this->_info.width = width;
@@ -46,6 +61,11 @@ void Framebuffer::CreateInfo::set_layers(uint32_t layers)
     this->_info.layers = layers;
 }
 
+void Framebuffer::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Framebuffer::CreateInfo::c_struct() const -> CType
 {
     return this->_info;
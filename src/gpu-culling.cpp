@@ -0,0 +1,298 @@
+#include <prime-vulkan/gpu-culling.h>
+
+#include <math.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+static_assert(sizeof(GpuCulling::Instance) == 48,
+    "GpuCulling::Instance must match the std430 layout of the shader.");
+
+// Invocations per workgroup, local_size_x of the shader.
+static const uint32_t group_size = 64;
+
+// The largest minStorageBufferOffsetAlignment the spec allows, so every
+// frame region can be bound as a storage buffer.
+static const ::VkDeviceSize region_alignment = 256;
+
+// The smallest maxDrawIndirectCount the spec allows with the
+// multiDrawIndirect feature, so every multi-draw call is within it.
+static const uint32_t multi_draw_count = 65535;
+
+// The push constant block of the shader.
+struct CullingParameters
+{
+    GpuCulling::Frustum frustum;
+    uint32_t instance_count;
+};
+
+auto GpuCulling::Frustum::from_view_projection(const float matrix[16])
+    -> Frustum
+{
+    // Gribb and Hartmann. Row i of the matrix is (m[i], m[4 + i], ...).
+    auto row = [matrix](int i, int j) {
+        return matrix[4 * j + i];
+    };
+
+    Frustum frustum;
+    for (int j = 0; j < 4; ++j) {
+        frustum.planes[0][j] = row(3, j) + row(0, j); // Left.
+        frustum.planes[1][j] = row(3, j) - row(0, j); // Right.
+        frustum.planes[2][j] = row(3, j) + row(1, j); // Bottom.
+        frustum.planes[3][j] = row(3, j) - row(1, j); // Top.
+        frustum.planes[4][j] = row(2, j);             // Near.
+        frustum.planes[5][j] = row(3, j) - row(2, j); // Far.
+    }
+
+    for (auto& plane: frustum.planes) {
+        float length = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] +
+            plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (auto& value: plane) {
+                value /= length;
+            }
+        }
+    }
+
+    return frustum;
+}
+
+
+GpuCulling::GpuCulling(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    const ShaderModule& shader,
+    uint32_t max_instances,
+    uint32_t frames_in_flight)
+    : _device(device)
+{
+    this->_max_instances = max_instances;
+    this->_frames_in_flight = frames_in_flight;
+    this->_frame = 0;
+    this->_draw_count = false;
+
+    ::VkDeviceSize size =
+        sizeof(::VkDrawIndexedIndirectCommand) * max_instances;
+    this->_draw_region_size = (size + region_alignment - 1) &
+        ~(region_alignment - 1);
+
+    this->create_buffer(this->_draw_region_size * frames_in_flight,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        memory_properties, this->_draws, this->_draws_memory);
+    this->create_buffer(region_alignment * frames_in_flight,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        memory_properties, this->_counts, this->_counts_memory);
+
+    // Instances, draws and the count.
+    pr::Vector<DescriptorSetLayout::Binding> bindings;
+    for (uint32_t i = 0; i < 3; ++i) {
+        DescriptorSetLayout::Binding binding;
+        binding.set_binding(i);
+        binding.set_descriptor_type(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        binding.set_descriptor_count(1);
+        binding.set_stage_flags(VK_SHADER_STAGE_COMPUTE_BIT);
+        bindings.push(binding);
+    }
+    DescriptorSetLayout::CreateInfo set_layout_info;
+    set_layout_info.set_bindings(bindings);
+    this->_set_layout = this->_device.create_unique_descriptor_set_layout(
+        set_layout_info);
+
+    DescriptorPool::Size pool_size;
+    pool_size.set_type(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    pool_size.set_descriptor_count(3 * frames_in_flight);
+    DescriptorPool::CreateInfo pool_info;
+    pool_info.set_pool_sizes({ pool_size });
+    pool_info.set_max_sets(frames_in_flight);
+    this->_descriptor_pool = this->_device.create_unique_descriptor_pool(
+        pool_info);
+
+    DescriptorSet::AllocateInfo allocate_info;
+    allocate_info.set_descriptor_pool(this->_descriptor_pool.ref());
+    allocate_info.set_descriptor_set_count(1);
+    allocate_info.set_set_layouts({ this->_set_layout.ref() });
+    for (uint32_t i = 0; i < frames_in_flight; ++i) {
+        this->_sets.push_back(
+            this->_device.allocate_descriptor_sets(allocate_info)[0]);
+    }
+
+    ::VkPushConstantRange push_constant_range;
+    push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    push_constant_range.offset = 0;
+    push_constant_range.size = sizeof(CullingParameters);
+    PipelineLayout::CreateInfo layout_info;
+    layout_info.set_set_layouts(
+        pr::Vector<::VkDescriptorSetLayout>{ this->_set_layout.c_ptr() });
+    layout_info.set_push_constant_range({ push_constant_range });
+    this->_pipeline_layout = this->_device.create_unique_pipeline_layout(
+        layout_info);
+
+    Pipeline::ShaderStageCreateInfo stage;
+    stage.set_stage(VK_SHADER_STAGE_COMPUTE_BIT);
+    stage.set_module(shader);
+    stage.set_name("main"_S);
+    ComputePipelineCreateInfo pipeline_info;
+    pipeline_info.set_stage(stage);
+    pipeline_info.set_layout(this->_pipeline_layout.ref());
+    auto pipelines = this->_device.create_unique_compute_pipelines(
+        { pipeline_info });
+    this->_pipeline = std::move(pipelines[0]);
+}
+
+void GpuCulling::record(CommandBuffer& command_buffer,
+                        ResourceStateTracker& tracker,
+                        uint32_t frame_index,
+                        BufferRef instances,
+                        uint32_t instance_count,
+                        const Frustum& frustum)
+{
+    if (instance_count > this->_max_instances) {
+        throw std::length_error("More instances than max_instances.");
+    }
+
+    this->_frame = frame_index % this->_frames_in_flight;
+    this->_draw_count = command_buffer.supports_draw_indirect_count();
+    DescriptorSetRef set(this->_sets[this->_frame]);
+
+    ::VkDescriptorBufferInfo buffer_infos[3] = {
+        { instances.c_ptr(), 0, VK_WHOLE_SIZE },
+        { this->_draws.c_ptr(), this->draw_offset(),
+            this->_draw_region_size },
+        { this->_counts.c_ptr(), this->count_offset(), sizeof(uint32_t) },
+    };
+    pr::Vector<WriteDescriptorSet> writes;
+    for (uint32_t i = 0; i < 3; ++i) {
+        WriteDescriptorSet write;
+        write.set_dst_set(set);
+        write.set_dst_binding(i);
+        write.set_descriptor_type(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        write.set_buffer_infos({ buffer_infos[i] });
+        writes.push(write);
+    }
+    this->_device.update_descriptor_sets(writes);
+
+    // Zero the count, and without a count buffer the commands the shader
+    // does not overwrite.
+    tracker.use_buffer(this->_counts.ref(), ResourceState::transfer_write());
+    if (!this->_draw_count) {
+        tracker.use_buffer(this->_draws.ref(),
+            ResourceState::transfer_write());
+    }
+    tracker.flush(command_buffer);
+    command_buffer.fill_buffer(this->_counts.ref(), this->count_offset(),
+        sizeof(uint32_t), 0);
+    if (!this->_draw_count) {
+        command_buffer.fill_buffer(this->_draws.ref(), this->draw_offset(),
+            this->_draw_region_size, 0);
+    }
+
+    auto compute = ResourceState::shader_write(
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    tracker.use_buffer(instances, ResourceState::shader_read(
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT));
+    tracker.use_buffer(this->_draws.ref(), compute);
+    tracker.use_buffer(this->_counts.ref(), compute);
+    tracker.flush(command_buffer);
+
+    CullingParameters parameters;
+    parameters.frustum = frustum;
+    parameters.instance_count = instance_count;
+
+    command_buffer.bind_pipeline(VK_PIPELINE_BIND_POINT_COMPUTE,
+        this->_pipeline.ref());
+    command_buffer.bind_descriptor_sets(VK_PIPELINE_BIND_POINT_COMPUTE,
+        this->_pipeline_layout.ref(), 0, { set });
+    command_buffer.push_constants(this->_pipeline_layout.ref(),
+        VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(parameters), &parameters);
+    command_buffer.dispatch((instance_count + group_size - 1) / group_size,
+        1, 1);
+
+    tracker.use_buffer(this->_draws.ref(), ResourceState::indirect_buffer());
+    tracker.use_buffer(this->_counts.ref(),
+        ResourceState::indirect_buffer());
+    tracker.flush(command_buffer);
+}
+
+void GpuCulling::draw(CommandBuffer& command_buffer, bool multi_draw) const
+{
+    const uint32_t stride = sizeof(::VkDrawIndexedIndirectCommand);
+    if (this->_draw_count) {
+        command_buffer.draw_indexed_indirect_count(this->_draws.ref(),
+            this->draw_offset(), this->_counts.ref(), this->count_offset(),
+            this->_max_instances, stride);
+        return;
+    }
+
+    uint32_t per_call = multi_draw ? multi_draw_count : 1;
+    for (uint32_t i = 0; i < this->_max_instances; i += per_call) {
+        uint32_t count = std::min(per_call, this->_max_instances - i);
+        command_buffer.draw_indexed_indirect(this->_draws.ref(),
+            this->draw_offset() + ::VkDeviceSize(stride) * i, count, stride);
+    }
+}
+
+
+BufferRef GpuCulling::draw_buffer() const
+{
+    return this->_draws.ref();
+}
+
+::VkDeviceSize GpuCulling::draw_offset() const
+{
+    return this->_draw_region_size * this->_frame;
+}
+
+BufferRef GpuCulling::count_buffer() const
+{
+    return this->_counts.ref();
+}
+
+::VkDeviceSize GpuCulling::count_offset() const
+{
+    return region_alignment * this->_frame;
+}
+
+uint32_t GpuCulling::max_instances() const
+{
+    return this->_max_instances;
+}
+
+void GpuCulling::create_buffer(::VkDeviceSize size,
+    ::VkBufferUsageFlags usage,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    UniqueBuffer& buffer,
+    UniqueDeviceMemory& memory)
+{
+    Buffer::CreateInfo buffer_info;
+    buffer_info.set_size(size);
+    buffer_info.set_usage(usage);
+    buffer_info.set_sharing_mode(VK_SHARING_MODE_EXCLUSIVE);
+    buffer = this->_device.create_unique_buffer(buffer_info);
+
+    auto requirements = this->_device.memory_requirements_for(buffer.ref());
+    int32_t type_index = memory_properties.find_memory_type(
+        requirements.memory_type_bits(),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (type_index < 0) {
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(), 0);
+    }
+
+    MemoryAllocateInfo allocate_info;
+    allocate_info.set_allocation_size(requirements.size());
+    allocate_info.set_memory_type_index(type_index);
+    memory = this->_device.allocate_unique_memory(allocate_info);
+
+    this->_device.bind_buffer_memory(buffer.ref(), memory.ref(), 0);
+}
+
+} // namespace vk
+} // namespace pr
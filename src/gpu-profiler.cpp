@@ -0,0 +1,183 @@
+#include <prime-vulkan/gpu-profiler.h>
+
+#include <stdexcept>
+
+#include <prime-vulkan/base.h>
+#include <prime-vulkan/tracer.h>
+
+namespace pr {
+namespace vk {
+
+// Placeholder in the open scope stack for a scope over `max_scopes`.
+static const uint32_t dropped_scope = UINT32_MAX;
+
+GpuProfiler::CreateInfo::CreateInfo()
+{
+    this->_timestamp_period = 1.0f;
+    this->_timestamp_valid_bits = 64;
+    this->_max_scopes = 64;
+    this->_frame_latency = 3;
+}
+
+void GpuProfiler::CreateInfo::set_timestamp_period(float period)
+{
+    this->_timestamp_period = period;
+}
+
+void GpuProfiler::CreateInfo::set_timestamp_valid_bits(uint32_t bits)
+{
+    this->_timestamp_valid_bits = bits;
+}
+
+void GpuProfiler::CreateInfo::set_max_scopes(uint32_t count)
+{
+    this->_max_scopes = count;
+}
+
+void GpuProfiler::CreateInfo::set_frame_latency(uint32_t frames)
+{
+    this->_frame_latency = frames;
+}
+
+
+GpuProfiler::GpuProfiler(const Device& device, const CreateInfo& info)
+    : _device(device)
+{
+    this->_timestamp_period = info._timestamp_period;
+    this->_timestamp_mask = (info._timestamp_valid_bits >= 64)
+        ? UINT64_MAX
+        : (uint64_t(1) << info._timestamp_valid_bits) - 1;
+    this->_max_scopes = info._max_scopes;
+    this->_frame = 0;
+
+    QueryPool::CreateInfo pool_info;
+    pool_info.set_query_type(VK_QUERY_TYPE_TIMESTAMP);
+    pool_info.set_query_count(2 * info._max_scopes * info._frame_latency);
+    this->_pool = this->_device.create_unique_query_pool(pool_info);
+
+    this->_frames.resize(info._frame_latency);
+    for (auto& frame: this->_frames) {
+        frame.pending = false;
+        frame.cpu_time = 0;
+    }
+    this->_timestamps.resize(2 * info._max_scopes);
+}
+
+void GpuProfiler::begin_frame(CommandBuffer& command_buffer)
+{
+    this->_frame += 1;
+
+    auto& frame = this->_frames[(this->_frame - 1) % this->_frames.size()];
+    if (frame.pending) {
+        this->resolve(frame, this->first_query());
+    }
+    frame.scopes.clear();
+    frame.pending = false;
+    frame.cpu_time = Tracer::now();
+    this->_open.clear();
+
+    command_buffer.reset_query_pool(this->_pool.ref(), this->first_query(),
+        2 * this->_max_scopes);
+}
+
+void GpuProfiler::end_frame()
+{
+    if (!this->_open.empty()) {
+        throw std::logic_error("GPU profiler scope left open.");
+    }
+
+    auto& frame = this->_frames[(this->_frame - 1) % this->_frames.size()];
+    frame.pending = !frame.scopes.empty();
+}
+
+void GpuProfiler::begin_scope(CommandBuffer& command_buffer,
+                              const char *name,
+                              ::VkPipelineStageFlagBits stage)
+{
+    auto& frame = this->_frames[(this->_frame - 1) % this->_frames.size()];
+    if (frame.scopes.size() == this->_max_scopes) {
+        this->_open.push_back(dropped_scope);
+        return;
+    }
+
+    uint32_t index = frame.scopes.size();
+    frame.scopes.push_back(Scope { name, uint32_t(this->_open.size()) });
+    this->_open.push_back(index);
+
+    command_buffer.write_timestamp(stage, this->_pool.ref(),
+        this->first_query() + 2 * index);
+}
+
+void GpuProfiler::end_scope(CommandBuffer& command_buffer,
+                            ::VkPipelineStageFlagBits stage)
+{
+    if (this->_open.empty()) {
+        throw std::logic_error("No GPU profiler scope to end.");
+    }
+
+    uint32_t index = this->_open.back();
+    this->_open.pop_back();
+    if (index == dropped_scope) {
+        return;
+    }
+
+    command_buffer.write_timestamp(stage, this->_pool.ref(),
+        this->first_query() + 2 * index + 1);
+}
+
+auto GpuProfiler::results() const -> const std::vector<Timing>&
+{
+    return this->_results;
+}
+
+uint64_t GpuProfiler::frame() const
+{
+    return this->_frame;
+}
+
+uint32_t GpuProfiler::first_query() const
+{
+    return 2 * this->_max_scopes *
+        ((this->_frame - 1) % this->_frames.size());
+}
+
+void GpuProfiler::resolve(Frame& frame, uint32_t first_query)
+{
+    uint32_t count = 2 * frame.scopes.size();
+    bool ready = this->_device.get_query_pool_results(this->_pool.ref(),
+        first_query, count, sizeof(uint64_t) * count,
+        this->_timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (!ready) {
+        return;
+    }
+
+    Tracer *tracer = Tracer::current();
+    uint64_t first = this->_timestamps[0];
+
+    this->_results.clear();
+    for (uint32_t i = 0; i < frame.scopes.size(); ++i) {
+        // Masking keeps the differences right across a wrap of the clock.
+        uint64_t offset = (this->_timestamps[2 * i] - first) &
+            this->_timestamp_mask;
+        uint64_t ticks = (this->_timestamps[2 * i + 1] -
+            this->_timestamps[2 * i]) & this->_timestamp_mask;
+
+        Timing timing;
+        timing.name = frame.scopes[i].name;
+        timing.depth = frame.scopes[i].depth;
+        timing.start_milliseconds =
+            offset * this->_timestamp_period / 1000000.0;
+        timing.milliseconds = ticks * this->_timestamp_period / 1000000.0;
+        this->_results.push_back(timing);
+
+        if (tracer != nullptr) {
+            uint64_t start = frame.cpu_time +
+                uint64_t(offset * this->_timestamp_period);
+            tracer->add_gpu_span(timing.name, start,
+                start + uint64_t(ticks * this->_timestamp_period));
+        }
+    }
+}
+
+} // namespace vk
+} // namespace pr
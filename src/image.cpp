@@ -0,0 +1,242 @@
+#include <prime-vulkan/image.h>
+
+namespace pr {
+namespace vk {
+
+Image::CreateInfo::CreateInfo()
+{
+    this->_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+
+    this->_info.imageType = VK_IMAGE_TYPE_2D;
+    this->_info.mipLevels = 1;
+    this->_info.arrayLayers = 1;
+    this->_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    this->_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    this->_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    this->_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    this->_info.queueFamilyIndexCount = 0;
+    this->_info.pQueueFamilyIndices = nullptr;
+
+    this->_info.flags = 0;
+    this->_info.pNext = nullptr;
+}
+
+void Image::CreateInfo::set_flags(::VkImageCreateFlags flags)
+{
+    this->_info.flags = flags;
+}
+
+void Image::CreateInfo::set_image_type(::VkImageType type)
+{
+    this->_info.imageType = type;
+}
+
+void Image::CreateInfo::set_format(::VkFormat format)
+{
+    this->_info.format = format;
+}
+
+void Image::CreateInfo::set_extent(::VkExtent3D extent)
+{
+    this->_info.extent = extent;
+}
+
+void Image::CreateInfo::set_mip_levels(uint32_t levels)
+{
+    this->_info.mipLevels = levels;
+}
+
+void Image::CreateInfo::set_array_layers(uint32_t layers)
+{
+    this->_info.arrayLayers = layers;
+}
+
+void Image::CreateInfo::set_samples(::VkSampleCountFlagBits samples)
+{
+    this->_info.samples = samples;
+}
+
+void Image::CreateInfo::set_tiling(::VkImageTiling tiling)
+{
+    this->_info.tiling = tiling;
+}
+
+void Image::CreateInfo::set_usage(::VkImageUsageFlags usage)
+{
+    this->_info.usage = usage;
+}
+
+void Image::CreateInfo::set_sharing_mode(::VkSharingMode mode)
+{
+    this->_info.sharingMode = mode;
+}
+
+void Image::CreateInfo::set_initial_layout(::VkImageLayout layout)
+{
+    this->_info.initialLayout = layout;
+}
+
+void Image::CreateInfo::set_queue_family_indices(
+    const pr::Vector<uint32_t>& indices)
+{
+    this->_queue_family_indices.clear();
+    for (auto index: indices) {
+        this->_queue_family_indices.push_back(index);
+    }
+}
+
+void Image::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
+auto Image::CreateInfo::c_struct() const -> CType
+{
+    CType info = this->_info;
+    info.queueFamilyIndexCount = this->_queue_family_indices.size();
+    info.pQueueFamilyIndices = (info.queueFamilyIndexCount > 0)
+        ? this->_queue_family_indices.data()
+        : nullptr;
+
+    return info;
+}
+
+
+Image::Image()
+{
+    this->_image = nullptr;
+}
+
+::VkImage Image::c_ptr() const
+{
+    return *(this->_image);
+}
+
+
+ImageView::CreateInfo::CreateInfo()
+{
+    this->_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+
+    this->_info.flags = 0;
+    this->_info.pNext = nullptr;
+}
+
+void ImageView::CreateInfo::set_image(const Image& image)
+{
+    this->_info.image = image.c_ptr();
+}
+
+void ImageView::CreateInfo::set_image(ImageRef image)
+{
+    this->_info.image = image.c_ptr();
+}
+
+void ImageView::CreateInfo::set_view_type(::VkImageViewType type)
+{
+    this->_info.viewType = type;
+}
+
+void ImageView::CreateInfo::set_format(::VkFormat format)
+{
+    this->_info.format = format;
+}
+
+void ImageView::CreateInfo::set_components(::VkComponentSwizzle r,
+                                             ::VkComponentSwizzle g,
+                                             ::VkComponentSwizzle b,
+                                             ::VkComponentSwizzle a)
+{
+    this->_info.components.r = r;
+    this->_info.components.g = g;
+    this->_info.components.b = b;
+    this->_info.components.a = a;
+}
+
+void ImageView::CreateInfo::set_subresource_range(::VkImageSubresourceRange range)
+{
+    this->_info.subresourceRange = range;
+}
+
+void ImageView::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
+::VkImageViewCreateInfo ImageView::CreateInfo::c_struct() const
+{
+    return this->_info;
+}
+
+
+ImageView::ImageView()
+{
+    this->_view = nullptr;
+}
+
+ImageView::~ImageView()
+{
+}
+
+::VkImageView ImageView::c_ptr() const
+{
+    return *(this->_view);
+}
+
+
+BufferImageCopy::BufferImageCopy()
+{
+    this->_copy.bufferOffset = 0;
+    this->_copy.bufferRowLength = 0;
+    this->_copy.bufferImageHeight = 0;
+    this->_copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    this->_copy.imageSubresource.mipLevel = 0;
+    this->_copy.imageSubresource.baseArrayLayer = 0;
+    this->_copy.imageSubresource.layerCount = 1;
+    this->_copy.imageOffset = { 0, 0, 0 };
+    this->_copy.imageExtent = { 0, 0, 0 };
+}
+
+void BufferImageCopy::set_buffer_offset(::VkDeviceSize offset)
+{
+    this->_copy.bufferOffset = offset;
+}
+
+void BufferImageCopy::set_buffer_row_length(uint32_t length)
+{
+    this->_copy.bufferRowLength = length;
+}
+
+void BufferImageCopy::set_buffer_image_height(uint32_t height)
+{
+    this->_copy.bufferImageHeight = height;
+}
+
+void BufferImageCopy::set_image_subresource(::VkImageAspectFlags aspect_mask,
+                                            uint32_t mip_level,
+                                            uint32_t base_array_layer,
+                                            uint32_t layer_count)
+{
+    this->_copy.imageSubresource.aspectMask = aspect_mask;
+    this->_copy.imageSubresource.mipLevel = mip_level;
+    this->_copy.imageSubresource.baseArrayLayer = base_array_layer;
+    this->_copy.imageSubresource.layerCount = layer_count;
+}
+
+void BufferImageCopy::set_image_offset(::VkOffset3D offset)
+{
+    this->_copy.imageOffset = offset;
+}
+
+void BufferImageCopy::set_image_extent(::VkExtent3D extent)
+{
+    this->_copy.imageExtent = extent;
+}
+
+auto BufferImageCopy::c_struct() const -> CType
+{
+    return this->_copy;
+}
+
+} // namespace vk
+} // namespace pr
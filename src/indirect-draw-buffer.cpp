@@ -0,0 +1,160 @@
+#include <prime-vulkan/indirect-draw-buffer.h>
+
+#include <string.h>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+// The largest minStorageBufferOffsetAlignment the spec allows, so every
+// region can be bound as a storage buffer.
+static const ::VkDeviceSize region_alignment = 256;
+
+IndirectDrawBuffer::IndirectDrawBuffer(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    uint32_t capacity,
+    uint32_t frames_in_flight)
+    : _device(device)
+{
+    this->_capacity = capacity;
+    this->_frames_in_flight = frames_in_flight;
+    this->_count = 0;
+    this->_offset = 0;
+
+    ::VkDeviceSize size = sizeof(::VkDrawIndexedIndirectCommand) * capacity;
+    this->_region_size = (size + region_alignment - 1) &
+        ~(region_alignment - 1);
+
+    Buffer::CreateInfo buffer_info;
+    buffer_info.set_size(this->_region_size * frames_in_flight);
+    buffer_info.set_usage(VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    buffer_info.set_sharing_mode(VK_SHARING_MODE_EXCLUSIVE);
+    this->_buffer = this->_device.create_unique_buffer(buffer_info);
+
+    // Device local and host visible memory saves the GPU reading the
+    // commands over the bus, where there is any.
+    auto requirements = this->_device.memory_requirements_for(
+        this->_buffer.ref());
+    int32_t type_index = memory_properties.find_memory_type(
+        requirements.memory_type_bits(),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (type_index < 0) {
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(),
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+    if (type_index < 0) {
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(),
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    }
+    if (type_index < 0) {
+        throw VulkanError(VK_ERROR_FEATURE_NOT_PRESENT);
+    }
+    auto flags = memory_properties.c_struct()
+        .memoryTypes[type_index].propertyFlags;
+    this->_coherent = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    MemoryAllocateInfo allocate_info;
+    allocate_info.set_allocation_size(requirements.size());
+    allocate_info.set_memory_type_index(type_index);
+    this->_memory = this->_device.allocate_unique_memory(allocate_info);
+
+    this->_device.bind_buffer_memory(this->_buffer.ref(),
+        this->_memory.ref(), 0);
+
+    // Stays mapped until the memory is freed.
+    void *data;
+    this->_device.map_memory(this->_memory.ref(), 0, VK_WHOLE_SIZE, 0,
+        &data);
+    this->_data = static_cast<uint8_t*>(data);
+}
+
+void IndirectDrawBuffer::begin(uint32_t frame_index)
+{
+    this->_offset = (frame_index % this->_frames_in_flight) *
+        this->_region_size;
+    this->_count = 0;
+}
+
+bool IndirectDrawBuffer::push(const ::VkDrawIndexedIndirectCommand& command)
+{
+    if (this->_count == this->_capacity) {
+        return false;
+    }
+
+    memcpy(this->_data + this->_offset +
+        sizeof(::VkDrawIndexedIndirectCommand) * this->_count,
+        &command, sizeof(::VkDrawIndexedIndirectCommand));
+    this->_count += 1;
+
+    return true;
+}
+
+bool IndirectDrawBuffer::push(uint32_t index_count,
+                              uint32_t instance_count,
+                              uint32_t first_index,
+                              int32_t vertex_offset,
+                              uint32_t first_instance)
+{
+    ::VkDrawIndexedIndirectCommand command;
+    command.indexCount = index_count;
+    command.instanceCount = instance_count;
+    command.firstIndex = first_index;
+    command.vertexOffset = vertex_offset;
+    command.firstInstance = first_instance;
+
+    return this->push(command);
+}
+
+void IndirectDrawBuffer::draw(CommandBuffer& command_buffer,
+                              bool multi_draw)
+{
+    if (this->_count == 0) {
+        return;
+    }
+
+    if (!this->_coherent) {
+        this->_device.flush_mapped_memory(this->_memory.ref(),
+            this->_offset, this->_region_size);
+    }
+
+    const uint32_t stride = sizeof(::VkDrawIndexedIndirectCommand);
+    if (multi_draw) {
+        command_buffer.draw_indexed_indirect(this->_buffer.ref(),
+            this->_offset, this->_count, stride);
+        return;
+    }
+    for (uint32_t i = 0; i < this->_count; ++i) {
+        command_buffer.draw_indexed_indirect(this->_buffer.ref(),
+            this->_offset + stride * i, 1, stride);
+    }
+}
+
+uint32_t IndirectDrawBuffer::count() const
+{
+    return this->_count;
+}
+
+uint32_t IndirectDrawBuffer::capacity() const
+{
+    return this->_capacity;
+}
+
+BufferRef IndirectDrawBuffer::buffer() const
+{
+    return this->_buffer.ref();
+}
+
+::VkDeviceSize IndirectDrawBuffer::offset() const
+{
+    return this->_offset;
+}
+
+} // namespace vk
+} // namespace pr
@@ -0,0 +1,112 @@
+#include <prime-vulkan/memory-budget-monitor.h>
+
+namespace pr {
+namespace vk {
+
+MemoryBudgetMonitor::CreateInfo::CreateInfo()
+{
+    this->_threshold = 0.9f;
+    this->_poll_interval = 30;
+}
+
+void MemoryBudgetMonitor::CreateInfo::set_threshold(float fraction)
+{
+    this->_threshold = fraction;
+}
+
+void MemoryBudgetMonitor::CreateInfo::set_poll_interval(uint32_t frames)
+{
+    this->_poll_interval = (frames > 0) ? frames : 1;
+}
+
+
+MemoryBudgetMonitor::MemoryBudgetMonitor(
+    const PhysicalDevice& physical_device,
+    const Device& device,
+    const CreateInfo& info)
+    : _physical_device(physical_device),
+      _device(device),
+      _info(info)
+{
+    this->_estimate = true;
+    this->_frame = 0;
+
+    auto memory = physical_device.memory_properties().c_struct();
+    for (uint32_t i = 0; i < memory.memoryTypeCount; ++i) {
+        this->_memory_heaps.push_back(memory.memoryTypes[i].heapIndex);
+    }
+    for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+        Heap heap;
+        heap.index = i;
+        heap.flags = memory.memoryHeaps[i].flags;
+        heap.size = memory.memoryHeaps[i].size;
+        heap.budget = 0;
+        heap.usage = 0;
+        heap.excess = 0;
+        this->_heaps.push_back(heap);
+    }
+
+    this->poll();
+}
+
+void MemoryBudgetMonitor::set_eviction_hook(EvictionHook hook)
+{
+    this->_hook = hook;
+}
+
+void MemoryBudgetMonitor::update()
+{
+    this->_frame += 1;
+    if (this->_frame % this->_info._poll_interval == 0) {
+        this->poll();
+    }
+}
+
+void MemoryBudgetMonitor::poll()
+{
+    auto budget = this->_physical_device.memory_budget();
+    this->_estimate = budget.is_estimate();
+
+    Statistics statistics = this->_device.statistics();
+    for (auto& heap: this->_heaps) {
+        heap.budget = budget.heap_budget(heap.index);
+        heap.usage = (this->_estimate)
+            ? statistics.heap_bytes(heap.index)
+            : budget.heap_usage(heap.index);
+
+        auto threshold = ::VkDeviceSize(
+            heap.budget * double(this->_info._threshold));
+        heap.excess = (heap.usage > threshold) ? heap.usage - threshold : 0;
+    }
+
+    if (!this->_hook) {
+        return;
+    }
+    for (auto& heap: this->_heaps) {
+        if (heap.excess > 0) {
+            this->_hook(heap);
+        }
+    }
+}
+
+auto MemoryBudgetMonitor::heaps() const -> const std::vector<Heap>&
+{
+    return this->_heaps;
+}
+
+::VkDeviceSize MemoryBudgetMonitor::available(uint32_t memory_type) const
+{
+    auto& heap = this->_heaps[this->_memory_heaps[memory_type]];
+    auto threshold = ::VkDeviceSize(
+        heap.budget * double(this->_info._threshold));
+
+    return (threshold > heap.usage) ? threshold - heap.usage : 0;
+}
+
+bool MemoryBudgetMonitor::is_estimate() const
+{
+    return this->_estimate;
+}
+
+} // namespace vk
+} // namespace pr
@@ -45,6 +45,11 @@ void MemoryAllocateInfo::set_memory_type_index(uint32_t index)
     this->_info.memoryTypeIndex = index;
 }
 
+void MemoryAllocateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto MemoryAllocateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -0,0 +1,136 @@
+#include <prime-vulkan/mipmap-generator.h>
+
+#include <algorithm>
+
+#include <primer/vector.h>
+
+namespace pr {
+namespace vk {
+
+static int32_t mip_extent(uint32_t extent, uint32_t level)
+{
+    return std::max(extent >> level, 1u);
+}
+
+MipmapGenerator::MipmapGenerator(const PhysicalDevice& physical_device)
+    : _physical_device(physical_device)
+{
+}
+
+bool MipmapGenerator::supports_linear_filter(::VkFormat format)
+{
+    auto found = this->_linear_filter.find(format);
+    if (found != this->_linear_filter.end()) {
+        return found->second;
+    }
+
+    auto properties = this->_physical_device.format_properties(format);
+    bool supported = (properties.optimalTilingFeatures &
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0;
+    this->_linear_filter[format] = supported;
+
+    return supported;
+}
+
+void MipmapGenerator::add(ImageRef image,
+                          ::VkFormat format,
+                          ::VkExtent2D extent,
+                          uint32_t mip_levels,
+                          uint32_t layer_count)
+{
+    Pending pending;
+    pending.image = image;
+    pending.extent = extent;
+    pending.mip_levels = mip_levels;
+    pending.layer_count = layer_count;
+    pending.filter = this->supports_linear_filter(format)
+        ? VK_FILTER_LINEAR
+        : VK_FILTER_NEAREST;
+
+    this->_pending.push_back(pending);
+}
+
+void MipmapGenerator::record(CommandBuffer& command_buffer,
+                             ResourceStateTracker& tracker,
+                             const ResourceState& final_state)
+{
+    uint32_t max_levels = 0;
+    for (auto& pending: this->_pending) {
+        tracker.use_image(pending.image, ResourceState::transfer_write());
+        max_levels = std::max(max_levels, pending.mip_levels);
+    }
+    tracker.flush(command_buffer);
+
+    ::VkImageMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+
+    for (uint32_t level = 1; level <= max_levels; ++level) {
+        // One barrier for the previous level of every image.
+        pr::Vector<::VkImageMemoryBarrier> barriers;
+        for (auto& pending: this->_pending) {
+            if (level > pending.mip_levels) {
+                continue;
+            }
+            barrier.image = pending.image.c_ptr();
+            barrier.subresourceRange.baseMipLevel = level - 1;
+            barrier.subresourceRange.layerCount = pending.layer_count;
+            barriers.push(barrier);
+        }
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {}, {}, barriers);
+
+        for (auto& pending: this->_pending) {
+            if (level >= pending.mip_levels) {
+                continue;
+            }
+
+            ::VkImageBlit blit;
+            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.srcSubresource.mipLevel = level - 1;
+            blit.srcSubresource.baseArrayLayer = 0;
+            blit.srcSubresource.layerCount = pending.layer_count;
+            blit.srcOffsets[0] = { 0, 0, 0 };
+            blit.srcOffsets[1] = {
+                mip_extent(pending.extent.width, level - 1),
+                mip_extent(pending.extent.height, level - 1),
+                1,
+            };
+            blit.dstSubresource = blit.srcSubresource;
+            blit.dstSubresource.mipLevel = level;
+            blit.dstOffsets[0] = { 0, 0, 0 };
+            blit.dstOffsets[1] = {
+                mip_extent(pending.extent.width, level),
+                mip_extent(pending.extent.height, level),
+                1,
+            };
+
+            command_buffer.blit_image(pending.image,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                pending.image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                { blit }, pending.filter);
+        }
+    }
+
+    // Every level is in the transfer source layout now.
+    for (auto& pending: this->_pending) {
+        tracker.set_image_state(pending.image, ResourceState::transfer_read());
+        tracker.use_image(pending.image, final_state);
+    }
+    tracker.flush(command_buffer);
+
+    this->_pending.clear();
+}
+
+} // namespace vk
+} // namespace pr
@@ -0,0 +1,57 @@
+#include <prime-vulkan/occlusion-queries.h>
+
+namespace pr {
+namespace vk {
+
+OcclusionQueries::OcclusionQueries(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    uint32_t max_queries,
+    uint32_t frame_latency,
+    bool precise)
+    : _readback(device, memory_properties, VK_QUERY_TYPE_OCCLUSION, 0,
+          max_queries, frame_latency)
+{
+    this->_flags = (precise) ? VK_QUERY_CONTROL_PRECISE_BIT : 0;
+}
+
+void OcclusionQueries::begin_frame(CommandBuffer& command_buffer)
+{
+    this->_readback.begin_frame(command_buffer);
+}
+
+void OcclusionQueries::begin(CommandBuffer& command_buffer, uint32_t index)
+{
+    command_buffer.begin_query(this->_readback.pool(),
+        this->_readback.use(index), this->_flags);
+}
+
+void OcclusionQueries::end(CommandBuffer& command_buffer, uint32_t index)
+{
+    command_buffer.end_query(this->_readback.pool(),
+        this->_readback.query(index));
+}
+
+void OcclusionQueries::end_frame(CommandBuffer& command_buffer)
+{
+    this->_readback.end_frame(command_buffer);
+}
+
+int64_t OcclusionQueries::samples(uint32_t index) const
+{
+    const uint64_t *values = this->_readback.values(index);
+
+    return (values != nullptr) ? int64_t(values[0]) : -1;
+}
+
+bool OcclusionQueries::visible(uint32_t index) const
+{
+    return this->samples(index) != 0;
+}
+
+uint32_t OcclusionQueries::max_queries() const
+{
+    return this->_readback.queries_per_frame();
+}
+
+} // namespace vk
+} // namespace pr
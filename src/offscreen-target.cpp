@@ -0,0 +1,247 @@
+#include <prime-vulkan/offscreen-target.h>
+
+#include <assert.h>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+static ::VkImageAspectFlags depth_aspect_mask(::VkFormat format)
+{
+    switch (format) {
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    default:
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+}
+
+OffscreenTarget::CreateInfo::CreateInfo()
+{
+    this->_image_count = 2;
+    this->_extent.width = 0;
+    this->_extent.height = 0;
+    this->_color_format = VK_FORMAT_R8G8B8A8_UNORM;
+    this->_color_usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    this->_depth_format = VK_FORMAT_UNDEFINED;
+}
+
+void OffscreenTarget::CreateInfo::set_image_count(uint32_t count)
+{
+    this->_image_count = count;
+}
+
+void OffscreenTarget::CreateInfo::set_extent(::VkExtent2D extent)
+{
+    this->_extent = extent;
+}
+
+void OffscreenTarget::CreateInfo::set_color_format(::VkFormat format)
+{
+    this->_color_format = format;
+}
+
+void OffscreenTarget::CreateInfo::set_color_usage(::VkImageUsageFlags usage)
+{
+    this->_color_usage = usage;
+}
+
+void OffscreenTarget::CreateInfo::set_depth_format(::VkFormat format)
+{
+    this->_depth_format = format;
+}
+
+
+OffscreenTarget::OffscreenTarget(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    const CreateInfo& info)
+    : _device(device),
+      _info(info)
+{
+    this->_next_image = 0;
+
+    Fence::CreateInfo fence_info;
+    fence_info.set_flags(VK_FENCE_CREATE_SIGNALED_BIT);
+
+    for (uint32_t i = 0; i < info._image_count; ++i) {
+        this->_colors.push_back(this->create_attachment(memory_properties,
+            info._color_format, info._color_usage,
+            VK_IMAGE_ASPECT_COLOR_BIT));
+
+        if (info._depth_format != VK_FORMAT_UNDEFINED) {
+            this->_depths.push_back(this->create_attachment(
+                memory_properties,
+                info._depth_format,
+                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                depth_aspect_mask(info._depth_format)));
+        }
+
+        this->_fences.push_back(
+            this->_device.create_unique_fence(fence_info));
+    }
+}
+
+OffscreenTarget::~OffscreenTarget()
+{
+    try {
+        this->wait_idle();
+    } catch (const VulkanError&) {
+        // Nothing left to do on a lost device.
+    }
+}
+
+uint32_t OffscreenTarget::acquire_next_image(Queue& queue,
+                                             uint64_t timeout,
+                                             SemaphoreRef semaphore)
+{
+    uint32_t index = this->_next_image;
+
+    this->_device.wait_for_fences({ this->_fences[index].ref() },
+        true, timeout);
+
+    // Nothing to wait for on the GPU, but the frame loop waits on the
+    // semaphore as it would for a swapchain image.
+    SubmitInfo submit;
+    submit.set_signal_semaphores({ semaphore });
+    queue.submit({ submit });
+
+    this->_next_image = (index + 1) % this->_info._image_count;
+
+    return index;
+}
+
+void OffscreenTarget::present(Queue& queue,
+    uint32_t image_index,
+    std::initializer_list<SemaphoreRef> wait_semaphores)
+{
+    assert(image_index < this->_info._image_count);
+
+    FenceRef fence = this->_fences[image_index].ref();
+    this->_device.reset_fences({ fence });
+
+    pr::Vector<::VkPipelineStageFlags> stages;
+    for (uint32_t i = 0; i < wait_semaphores.size(); ++i) {
+        stages.push(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
+
+    SubmitInfo submit;
+    submit.set_wait_semaphores(wait_semaphores);
+    submit.set_wait_dst_stage_mask(stages);
+    queue.submit({ submit }, fence);
+}
+
+uint32_t OffscreenTarget::image_count() const
+{
+    return this->_info._image_count;
+}
+
+::VkExtent2D OffscreenTarget::extent() const
+{
+    return this->_info._extent;
+}
+
+::VkFormat OffscreenTarget::color_format() const
+{
+    return this->_info._color_format;
+}
+
+::VkFormat OffscreenTarget::depth_format() const
+{
+    return this->_info._depth_format;
+}
+
+ImageRef OffscreenTarget::color_image(uint32_t index) const
+{
+    return this->_colors[index].image.ref();
+}
+
+ImageViewRef OffscreenTarget::color_view(uint32_t index) const
+{
+    return this->_colors[index].view.ref();
+}
+
+ImageRef OffscreenTarget::depth_image(uint32_t index) const
+{
+    if (this->_depths.empty()) {
+        return ImageRef();
+    }
+
+    return this->_depths[index].image.ref();
+}
+
+ImageViewRef OffscreenTarget::depth_view(uint32_t index) const
+{
+    if (this->_depths.empty()) {
+        return ImageViewRef();
+    }
+
+    return this->_depths[index].view.ref();
+}
+
+void OffscreenTarget::wait_idle()
+{
+    for (auto& fence: this->_fences) {
+        this->_device.wait_for_fences({ fence.ref() }, true, UINT64_MAX);
+    }
+}
+
+auto OffscreenTarget::create_attachment(
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    ::VkFormat format,
+    ::VkImageUsageFlags usage,
+    ::VkImageAspectFlags aspect_mask) -> Attachment
+{
+    Attachment attachment;
+
+    Image::CreateInfo image_info;
+    image_info.set_format(format);
+    image_info.set_extent(::VkExtent3D {
+        this->_info._extent.width, this->_info._extent.height, 1 });
+    image_info.set_usage(usage);
+    attachment.image = this->_device.create_unique_image(image_info);
+
+    auto requirements = this->_device.memory_requirements_for(
+        attachment.image.ref());
+    int32_t type_index = memory_properties.find_memory_type(
+        requirements.memory_type_bits(), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (type_index < 0) {
+        // CPU drivers may not report device local memory.
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(), 0);
+    }
+
+    MemoryAllocateInfo allocate_info;
+    allocate_info.set_allocation_size(requirements.size());
+    allocate_info.set_memory_type_index(type_index);
+    attachment.memory = this->_device.allocate_unique_memory(allocate_info);
+
+    this->_device.bind_image_memory(attachment.image.ref(),
+        attachment.memory.ref(), 0);
+
+    ::VkImageSubresourceRange range;
+    range.aspectMask = aspect_mask;
+    range.baseMipLevel = 0;
+    range.levelCount = 1;
+    range.baseArrayLayer = 0;
+    range.layerCount = 1;
+
+    ImageView::CreateInfo view_info;
+    view_info.set_image(attachment.image.ref());
+    view_info.set_view_type(VK_IMAGE_VIEW_TYPE_2D);
+    view_info.set_format(format);
+    view_info.set_components(VK_COMPONENT_SWIZZLE_IDENTITY,
+                             VK_COMPONENT_SWIZZLE_IDENTITY,
+                             VK_COMPONENT_SWIZZLE_IDENTITY,
+                             VK_COMPONENT_SWIZZLE_IDENTITY);
+    view_info.set_subresource_range(range);
+    attachment.view = this->_device.create_unique_image_view(view_info);
+
+    return attachment;
+}
+
+} // namespace vk
+} // namespace pr
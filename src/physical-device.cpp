@@ -1,5 +1,10 @@
 #include <prime-vulkan/physical-device.h>
 
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
 #include <prime-vulkan/base.h>
 #include <prime-vulkan/instance.h>
 
@@ -20,6 +25,11 @@ uint32_t QueueFamilyProperties::queue_count() const
     return this->_properties.queueCount;
 }
 
+uint32_t QueueFamilyProperties::timestamp_valid_bits() const
+{
+    return this->_properties.timestampValidBits;
+}
+
 
 PhysicalDevice::MemoryProperties::MemoryProperties()
 {
@@ -49,45 +59,140 @@ PhysicalDevice::MemoryProperties::memory_types() const
     return v;
 }
 
+int32_t PhysicalDevice::MemoryProperties::find_memory_type(uint32_t type_bits,
+    ::VkMemoryPropertyFlags properties) const
+{
+    for (uint32_t i = 0; i < this->_properties.memoryTypeCount; ++i) {
+        auto flags = this->_properties.memoryTypes[i].propertyFlags;
+        if ((type_bits & (1u << i)) && (flags & properties) == properties) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
 auto PhysicalDevice::MemoryProperties::c_struct() const -> CType
 {
     return this->_properties;
 }
 
 
+PhysicalDevice::Properties::Properties()
+{
+}
+
+auto PhysicalDevice::Properties::core() const
+    -> const ::VkPhysicalDeviceProperties&
+{
+    return this->_chain.get<::VkPhysicalDeviceProperties2>().properties;
+}
+
+auto PhysicalDevice::Properties::limits() const
+    -> const ::VkPhysicalDeviceLimits&
+{
+    return this->core().limits;
+}
+
+auto PhysicalDevice::Properties::vulkan11() const
+    -> const ::VkPhysicalDeviceVulkan11Properties&
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan11Properties>();
+}
+
+auto PhysicalDevice::Properties::vulkan12() const
+    -> const ::VkPhysicalDeviceVulkan12Properties&
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan12Properties>();
+}
+
+auto PhysicalDevice::Properties::vulkan13() const
+    -> const ::VkPhysicalDeviceVulkan13Properties&
+{
+    return this->_chain.get<::VkPhysicalDeviceVulkan13Properties>();
+}
+
+
+PhysicalDevice::MemoryBudget::MemoryBudget()
+{
+    this->_heap_count = 0;
+    this->_estimate = true;
+}
+
+uint32_t PhysicalDevice::MemoryBudget::heap_count() const
+{
+    return this->_heap_count;
+}
+
+::VkDeviceSize PhysicalDevice::MemoryBudget::heap_size(uint32_t heap) const
+{
+    return this->_heap_sizes[heap];
+}
+
+::VkDeviceSize PhysicalDevice::MemoryBudget::heap_budget(uint32_t heap) const
+{
+    return this->_heap_budgets[heap];
+}
+
+::VkDeviceSize PhysicalDevice::MemoryBudget::heap_usage(uint32_t heap) const
+{
+    return this->_heap_usages[heap];
+}
+
+bool PhysicalDevice::MemoryBudget::is_estimate() const
+{
+    return this->_estimate;
+}
+
+
 PhysicalDevice::PhysicalDevice()
 {
     this->_device = nullptr;
+    this->_instance_api_version = VK_API_VERSION_1_0;
+    this->_memory_budget = false;
 }
 
 PhysicalDevice::PhysicalDevice(const PhysicalDevice& other)
 {
     this->_device = other._device;
+    this->_instance_api_version = other._instance_api_version;
+    this->_properties = other._properties;
+    this->_features = other._features;
+    this->_memory_budget = other._memory_budget;
 }
 
 Vector<PhysicalDevice> PhysicalDevice::enumerate(const Instance& instance)
 {
     Vector<PhysicalDevice> v;
 
+    ::VkResult result;
+
     uint32_t count;
-    vkEnumeratePhysicalDevices(
+    result = vkEnumeratePhysicalDevices(
         const_cast<Instance&>(instance).c_ptr(),
         &count,
         NULL
     );
-    if (count == 0) {
-        fprintf(stderr, "No GPUs with Vulkan support!\n");
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
     }
 
     ::VkPhysicalDevice *devices = new ::VkPhysicalDevice[count];
 
-    vkEnumeratePhysicalDevices(
+    result = vkEnumeratePhysicalDevices(
         const_cast<Instance&>(instance).c_ptr(), &count, devices);
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        delete[] devices;
+
+        throw VulkanError(result);
+    }
 
     for (uint32_t i = 0; i < count; ++i) {
         ::VkPhysicalDevice device = devices[i];
         PhysicalDevice physical_device;
         physical_device._device = device;
+        physical_device._instance_api_version = instance.api_version();
+        physical_device.query();
         v.push(physical_device);
     }
 
@@ -132,13 +237,138 @@ PhysicalDevice::MemoryProperties PhysicalDevice::memory_properties() const
     return props;
 }
 
+PhysicalDevice::MemoryBudget PhysicalDevice::memory_budget() const
+{
+    MemoryBudget budget;
+
+    ::VkPhysicalDeviceMemoryBudgetPropertiesEXT vk_budget;
+    vk_budget.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    vk_budget.pNext = nullptr;
+
+    ::VkPhysicalDeviceMemoryProperties2 vk_props;
+    vk_props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    vk_props.pNext = nullptr;
+
+    // Physical device functions of Vulkan 1.1 need both the device and
+    // the instance to support it.
+    if (this->api_version() >= VK_API_VERSION_1_1) {
+        if (this->_memory_budget) {
+            vk_props.pNext = &vk_budget;
+            budget._estimate = false;
+        }
+        vkGetPhysicalDeviceMemoryProperties2(this->_device, &vk_props);
+    } else {
+        vkGetPhysicalDeviceMemoryProperties(this->_device,
+            &vk_props.memoryProperties);
+    }
+
+    auto& memory = vk_props.memoryProperties;
+    budget._heap_count = memory.memoryHeapCount;
+    for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+        budget._heap_sizes[i] = memory.memoryHeaps[i].size;
+        if (budget._estimate) {
+            budget._heap_budgets[i] = memory.memoryHeaps[i].size / 5 * 4;
+            budget._heap_usages[i] = 0;
+        } else {
+            budget._heap_budgets[i] = vk_budget.heapBudget[i];
+            budget._heap_usages[i] = vk_budget.heapUsage[i];
+        }
+    }
+
+    return budget;
+}
+
+uint32_t PhysicalDevice::api_version() const
+{
+    return std::min(this->_properties->core().apiVersion,
+        this->_instance_api_version);
+}
+
+::VkPhysicalDeviceProperties PhysicalDevice::properties() const
+{
+    return this->_properties->core();
+}
+
+auto PhysicalDevice::properties2() const -> const Properties&
+{
+    return *(this->_properties);
+}
+
+const ::VkPhysicalDeviceLimits& PhysicalDevice::limits() const
+{
+    return this->_properties->limits();
+}
+
+::VkPhysicalDeviceFeatures PhysicalDevice::features() const
+{
+    return this->_features->core();
+}
+
+const DeviceFeatures& PhysicalDevice::features2() const
+{
+    return *(this->_features);
+}
+
+::VkFormatProperties
+PhysicalDevice::format_properties(::VkFormat format) const
+{
+    ::VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(this->_device, format, &properties);
+
+    return properties;
+}
+
+Vector<::VkExtensionProperties> PhysicalDevice::extension_properties() const
+{
+    ::VkResult result;
+
+    uint32_t count = 0;
+    result = vkEnumerateDeviceExtensionProperties(this->_device, nullptr,
+        &count, nullptr);
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+
+    std::vector<::VkExtensionProperties> extensions(count);
+    result = vkEnumerateDeviceExtensionProperties(this->_device, nullptr,
+        &count, extensions.data());
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        throw VulkanError(result);
+    }
+
+    Vector<::VkExtensionProperties> v;
+    for (uint32_t i = 0; i < count; ++i) {
+        v.push(extensions[i]);
+    }
+
+    return v;
+}
+
+bool PhysicalDevice::supports_extension(const char *name) const
+{
+    auto extensions = this->extension_properties();
+    for (uint32_t i = 0; i < extensions.length(); ++i) {
+        if (strcmp(extensions[i].extensionName, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 Device PhysicalDevice::create_device(
     const Device::CreateInfo& create_info) const
 {
     ::VkResult result;
     ::VkDevice device;
 
-    ::VkDeviceCreateInfo info = create_info.c_struct();
+    // Features created for the device's version may go past the
+    // instance's.
+    Device::CreateInfo limited_info = create_info;
+    limited_info.limit_api_version(this->api_version());
+
+    ::VkDeviceCreateInfo info = limited_info.c_struct();
     result = vkCreateDevice(this->_device, &info, nullptr, &device);
 
     if (result != VK_SUCCESS) {
@@ -148,6 +378,13 @@ Device PhysicalDevice::create_device(
     // Construct device class.
     Device vk_device;
     vk_device._device = device;
+    vk_device._dispatch = DeviceDispatch::load(device, info);
+
+    auto memory = this->memory_properties().c_struct();
+    for (uint32_t i = 0; i < memory.memoryTypeCount; ++i) {
+        vk_device._memory_heaps[i] = memory.memoryTypes[i].heapIndex;
+    }
+    vk_device._memory_type_count = memory.memoryTypeCount;
 
     return vk_device;
 }
@@ -257,5 +494,43 @@ bool PhysicalDevice::surface_support_for(uint32_t queue_family_index,
     return this->_device;
 }
 
+void PhysicalDevice::query()
+{
+    Properties *properties = new Properties();
+    this->_properties.reset(properties);
+    auto& chain = properties->_chain;
+
+    // The version decides which structs are valid to chain.
+    auto& core = chain.get<::VkPhysicalDeviceProperties2>().properties;
+    vkGetPhysicalDeviceProperties(this->_device, &core);
+    uint32_t api_version = this->api_version();
+
+    DeviceFeatures *features = new DeviceFeatures(api_version);
+    this->_features.reset(features);
+
+    // Polled often, while enumerating the extensions allocates.
+    this->_memory_budget =
+        this->supports_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    // Physical device functions of Vulkan 1.1 need both the device and
+    // the instance to support it.
+    if (api_version < VK_API_VERSION_1_1) {
+        vkGetPhysicalDeviceFeatures(this->_device, &features->core());
+
+        return;
+    }
+
+    bool vulkan12 = api_version >= VK_API_VERSION_1_2;
+    chain.set_linked<::VkPhysicalDeviceVulkan11Properties>(vulkan12);
+    chain.set_linked<::VkPhysicalDeviceVulkan12Properties>(vulkan12);
+    chain.set_linked<::VkPhysicalDeviceVulkan13Properties>(
+        api_version >= VK_API_VERSION_1_3);
+    vkGetPhysicalDeviceProperties2(this->_device,
+        static_cast<::VkPhysicalDeviceProperties2*>(chain.head()));
+
+    vkGetPhysicalDeviceFeatures2(this->_device,
+        static_cast<::VkPhysicalDeviceFeatures2*>(features->head()));
+}
+
 } // namespace vk
 } // namespace pr
@@ -0,0 +1,96 @@
+#include <prime-vulkan/pipeline-statistics.h>
+
+#include <stdexcept>
+
+namespace pr {
+namespace vk {
+
+// Results come in the order of the bits.
+static const ::VkQueryPipelineStatisticFlags statistic_flags =
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+PipelineStatistics::PipelineStatistics(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    uint32_t max_passes,
+    uint32_t frame_latency)
+    : _readback(device, memory_properties,
+          VK_QUERY_TYPE_PIPELINE_STATISTICS, statistic_flags,
+          max_passes, frame_latency),
+      _names(frame_latency)
+{
+    this->_frame = 0;
+    this->_open = -1;
+}
+
+void PipelineStatistics::begin_frame(CommandBuffer& command_buffer)
+{
+    this->_frame += 1;
+    auto& names = this->_names[(this->_frame - 1) % this->_names.size()];
+
+    if (this->_readback.begin_frame(command_buffer)) {
+        this->_results.clear();
+        for (uint32_t i = 0; i < names.size(); ++i) {
+            const uint64_t *values = this->_readback.values(i);
+
+            Report report;
+            report.name = names[i];
+            report.input_assembly_vertices = values[0];
+            report.vertex_shader_invocations = values[1];
+            report.clipping_primitives = values[2];
+            report.fragment_shader_invocations = values[3];
+            report.compute_shader_invocations = values[4];
+            this->_results.push_back(report);
+        }
+    }
+    names.clear();
+}
+
+void PipelineStatistics::begin_pass(CommandBuffer& command_buffer,
+                                    const char *name)
+{
+    if (this->_open >= 0) {
+        throw std::logic_error("Pipeline statistics passes do not nest.");
+    }
+
+    auto& names = this->_names[(this->_frame - 1) % this->_names.size()];
+    if (names.size() == this->_readback.queries_per_frame()) {
+        return;
+    }
+
+    this->_open = names.size();
+    names.push_back(name);
+    command_buffer.begin_query(this->_readback.pool(),
+        this->_readback.use(this->_open));
+}
+
+void PipelineStatistics::end_pass(CommandBuffer& command_buffer)
+{
+    if (this->_open < 0) {
+        return;
+    }
+
+    command_buffer.end_query(this->_readback.pool(),
+        this->_readback.query(this->_open));
+    this->_open = -1;
+}
+
+void PipelineStatistics::end_frame(CommandBuffer& command_buffer)
+{
+    if (this->_open >= 0) {
+        throw std::logic_error("Pipeline statistics pass left open.");
+    }
+
+    this->_readback.end_frame(command_buffer);
+}
+
+auto PipelineStatistics::results() const -> const std::vector<Report>&
+{
+    return this->_results;
+}
+
+} // namespace vk
+} // namespace pr
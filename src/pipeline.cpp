@@ -11,11 +11,32 @@ Pipeline::ShaderStageCreateInfo::ShaderStageCreateInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 
+    this->_info.pName = nullptr;
     this->_info.pSpecializationInfo = nullptr;
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
 }
 
+Pipeline::ShaderStageCreateInfo::ShaderStageCreateInfo(
+    const ShaderStageCreateInfo& other)
+{
+    *this = other;
+}
+
+auto Pipeline::ShaderStageCreateInfo::operator=(
+    const ShaderStageCreateInfo& other) -> ShaderStageCreateInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pName = this->_arena.copy_string(other._info.pName);
+
+    return *this;
+}
+
 void Pipeline::ShaderStageCreateInfo::set_stage(::VkShaderStageFlagBits stage)
 {
     this->_info.stage = stage;
@@ -29,8 +50,12 @@ void Pipeline::ShaderStageCreateInfo::set_module(
 
 void Pipeline::ShaderStageCreateInfo::set_name(const pr::String& name)
 {
-    this->_name = name;
-    this->_info.pName = this->_name.c_str();
+    this->_info.pName = this->_arena.copy_string(name.c_str());
+}
+
+void Pipeline::ShaderStageCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 ::VkPipelineShaderStageCreateInfo
@@ -44,50 +69,51 @@ Pipeline::DynamicStateCreateInfo::DynamicStateCreateInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 
+    this->_info.dynamicStateCount = 0;
+    this->_info.pDynamicStates = nullptr;
+
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
-
-    this->_states = nullptr;
 }
 
 Pipeline::DynamicStateCreateInfo::DynamicStateCreateInfo(
     const Pipeline::DynamicStateCreateInfo& other)
 {
-    this->_info.sType = other._info.sType;
-
-    this->_info.flags = 0;
-    this->_info.pNext = 0;
-
-    if (other._states != nullptr) {
-        this->_info.dynamicStateCount = other._info.dynamicStateCount;
-        this->_states = new ::VkDynamicState[other._info.dynamicStateCount];
-        for (uint64_t i = 0; i < other._info.dynamicStateCount; ++i) {
-            this->_states[i] = other._states[i];
-        }
-        this->_info.pDynamicStates = this->_states;
-    } else {
-        this->_states = nullptr;
-    }
+    *this = other;
 }
 
-Pipeline::DynamicStateCreateInfo::~DynamicStateCreateInfo()
+auto Pipeline::DynamicStateCreateInfo::operator=(
+    const DynamicStateCreateInfo& other) -> DynamicStateCreateInfo&
 {
-    if (this->_states != nullptr) {
-        delete[] this->_states;
+    if (this == &other) {
+        return *this;
     }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pDynamicStates = this->_arena.copy(
+        other._info.pDynamicStates, other._info.dynamicStateCount);
+
+    return *this;
 }
 
 void Pipeline::DynamicStateCreateInfo::set_dynamic_states(
     const pr::Vector<::VkDynamicState>& states)
 {
-    uint64_t count = states.length();
-    this->_info.dynamicStateCount = count;
+    uint32_t count = states.length();
 
-    this->_states = new ::VkDynamicState[count];
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_states[i] = states[i];
+    ::VkDynamicState *p = this->_arena.allocate<::VkDynamicState>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = states[i];
     }
-    this->_info.pDynamicStates = this->_states;
+
+    this->_info.dynamicStateCount = count;
+    this->_info.pDynamicStates = p;
+}
+
+void Pipeline::DynamicStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 ::VkPipelineDynamicStateCreateInfo
@@ -102,40 +128,74 @@ Pipeline::VertexInputStateCreateInfo::VertexInputStateCreateInfo()
     this->_info.sType =
         VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
+    this->_info.vertexBindingDescriptionCount = 0;
+    this->_info.pVertexBindingDescriptions = nullptr;
+    this->_info.vertexAttributeDescriptionCount = 0;
+    this->_info.pVertexAttributeDescriptions = nullptr;
+
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
 }
 
+Pipeline::VertexInputStateCreateInfo::VertexInputStateCreateInfo(
+    const VertexInputStateCreateInfo& other)
+{
+    *this = other;
+}
+
+auto Pipeline::VertexInputStateCreateInfo::operator=(
+    const VertexInputStateCreateInfo& other) -> VertexInputStateCreateInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pVertexBindingDescriptions = this->_arena.copy(
+        other._info.pVertexBindingDescriptions,
+        other._info.vertexBindingDescriptionCount);
+    this->_info.pVertexAttributeDescriptions = this->_arena.copy(
+        other._info.pVertexAttributeDescriptions,
+        other._info.vertexAttributeDescriptionCount);
+
+    return *this;
+}
+
 void Pipeline::VertexInputStateCreateInfo::set_vertex_binding_descriptions(
     const pr::Vector<VertexInputBindingDescription>& descriptions)
 {
-    if (descriptions.length() != 0) {
-        uint32_t count = descriptions.length();
-        this->_info.vertexBindingDescriptionCount = count;
-        for (uint32_t i = 0; i < count; ++i) {
-            this->_bindings.push_back(descriptions[i].c_struct());
-        }
-        this->_info.pVertexBindingDescriptions = this->_bindings.data();
-    } else {
-        this->_info.vertexBindingDescriptionCount = 0;
-        this->_info.pVertexBindingDescriptions = nullptr;
+    uint32_t count = descriptions.length();
+
+    // Null for none.
+    auto *p = this->_arena.allocate<VertexInputBindingDescription::CType>(
+        count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = descriptions[i].c_struct();
     }
+
+    this->_info.vertexBindingDescriptionCount = count;
+    this->_info.pVertexBindingDescriptions = p;
 }
 
 void Pipeline::VertexInputStateCreateInfo::set_vertex_attribute_descriptions(
     const pr::Vector<VertexInputAttributeDescription>& descriptions)
 {
-    if (descriptions.length() != 0) {
-        uint32_t count = descriptions.length();
-        this->_info.vertexAttributeDescriptionCount = count;
-        for (uint32_t i = 0; i < count; ++i) {
-            this->_attributes.push_back(descriptions[i].c_struct());
-        }
-        this->_info.pVertexAttributeDescriptions = this->_attributes.data();
-    } else {
-        this->_info.vertexAttributeDescriptionCount = 0;
-        this->_info.pVertexAttributeDescriptions = nullptr;
+    uint32_t count = descriptions.length();
+
+    auto *p = this->_arena.allocate<VertexInputAttributeDescription::CType>(
+        count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = descriptions[i].c_struct();
     }
+
+    this->_info.vertexAttributeDescriptionCount = count;
+    this->_info.pVertexAttributeDescriptions = p;
+}
+
+void Pipeline::VertexInputStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 auto Pipeline::VertexInputStateCreateInfo::c_struct() const -> CType
@@ -165,6 +225,11 @@ void Pipeline::InputAssemblyStateCreateInfo::set_primitive_restart_enable(
     this->_info.primitiveRestartEnable = (enable) ? VK_TRUE : VK_FALSE;
 }
 
+void Pipeline::InputAssemblyStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Pipeline::InputAssemblyStateCreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -192,6 +257,11 @@ void Pipeline::ViewportStateCreateInfo::set_scissor_count(uint32_t count)
     this->_info.scissorCount = count;
 }
 
+void Pipeline::ViewportStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Pipeline::ViewportStateCreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -249,6 +319,11 @@ void Pipeline::RasterizationStateCreateInfo::set_depth_bias_enable(
     this->_info.depthBiasEnable = enable;
 }
 
+void Pipeline::RasterizationStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Pipeline::RasterizationStateCreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -278,6 +353,11 @@ void Pipeline::MultisampleStateCreateInfo::set_rasterization_samples(
     this->_info.rasterizationSamples = samples;
 }
 
+void Pipeline::MultisampleStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Pipeline::MultisampleStateCreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -321,15 +401,27 @@ Pipeline::ColorBlendStateCreateInfo::ColorBlendStateCreateInfo()
 
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
+}
 
-    this->_p_attachments = nullptr;
+Pipeline::ColorBlendStateCreateInfo::ColorBlendStateCreateInfo(
+    const ColorBlendStateCreateInfo& other)
+{
+    *this = other;
 }
 
-Pipeline::ColorBlendStateCreateInfo::~ColorBlendStateCreateInfo()
+auto Pipeline::ColorBlendStateCreateInfo::operator=(
+    const ColorBlendStateCreateInfo& other) -> ColorBlendStateCreateInfo&
 {
-    if (this->_p_attachments != nullptr) {
-        delete[] this->_p_attachments;
+    if (this == &other) {
+        return *this;
     }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pAttachments = this->_arena.copy(other._info.pAttachments,
+        other._info.attachmentCount);
+
+    return *this;
 }
 
 void Pipeline::ColorBlendStateCreateInfo::set_logic_op(
@@ -346,15 +438,15 @@ void Pipeline::ColorBlendStateCreateInfo::set_logic_op(
 void Pipeline::ColorBlendStateCreateInfo::set_attachments(
     const pr::Vector<ColorBlendAttachmentState>& attachments)
 {
-    uint64_t count = attachments.length();
+    uint32_t count = attachments.length();
 
-    this->_info.attachmentCount = count;
-
-    this->_p_attachments = new ::VkPipelineColorBlendAttachmentState[count];
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_p_attachments[i] = attachments[i].c_struct();
+    auto *p = this->_arena.allocate<ColorBlendAttachmentState::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = attachments[i].c_struct();
     }
-    this->_info.pAttachments = this->_p_attachments;
+
+    this->_info.attachmentCount = count;
+    this->_info.pAttachments = p;
 }
 
 void Pipeline::ColorBlendStateCreateInfo::set_blend_constants(float r,
@@ -368,6 +460,11 @@ void Pipeline::ColorBlendStateCreateInfo::set_blend_constants(float r,
     this->_info.blendConstants[3] = a;
 }
 
+void Pipeline::ColorBlendStateCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Pipeline::ColorBlendStateCreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -378,33 +475,112 @@ GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 
-    this->_info.basePipelineHandle = nullptr;
+    this->_info.stageCount = 0;
+    this->_info.pStages = nullptr;
+    this->_info.pVertexInputState = nullptr;
+    this->_info.pInputAssemblyState = nullptr;
     this->_info.pTessellationState = nullptr;
+    this->_info.pViewportState = nullptr;
+    this->_info.pRasterizationState = nullptr;
+    this->_info.pMultisampleState = nullptr;
+    this->_info.pDepthStencilState = nullptr;
+    this->_info.pColorBlendState = nullptr;
+    this->_info.pDynamicState = nullptr;
+    this->_info.layout = VK_NULL_HANDLE;
+    this->_info.renderPass = VK_NULL_HANDLE;
+    this->_info.subpass = 0;
+    this->_info.basePipelineHandle = nullptr;
+    this->_info.basePipelineIndex = -1;
 
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
+
+    this->_layout = VK_NULL_HANDLE;
+    this->_render_pass = VK_NULL_HANDLE;
+    this->_pipeline_handle = VK_NULL_HANDLE;
+}
+
+GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(
+    const GraphicsPipelineCreateInfo& other)
+{
+    *this = other;
+}
+
+auto GraphicsPipelineCreateInfo::operator=(
+    const GraphicsPipelineCreateInfo& other) -> GraphicsPipelineCreateInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_vertex_input_state = other._vertex_input_state;
+    this->_input_assembly_state = other._input_assembly_state;
+    this->_viewport_state = other._viewport_state;
+    this->_rasterization_state = other._rasterization_state;
+    this->_multisample_state = other._multisample_state;
+    this->_color_blend_state = other._color_blend_state;
+    this->_dynamic_state = other._dynamic_state;
+    this->_layout = other._layout;
+    this->_render_pass = other._render_pass;
+    this->_pipeline_handle = other._pipeline_handle;
+
+    auto *stages = this->_arena.copy(other._info.pStages,
+        other._info.stageCount);
+    this->copy_arrays(stages, other._info.stageCount);
+    this->_info.pStages = stages;
+
+    // Point to the states of this copy.
+    if (other._info.pVertexInputState != nullptr) {
+        this->copy_arrays(this->_vertex_input_state);
+        this->_info.pVertexInputState = &(this->_vertex_input_state);
+    }
+    if (other._info.pInputAssemblyState != nullptr) {
+        this->_info.pInputAssemblyState = &(this->_input_assembly_state);
+    }
+    if (other._info.pViewportState != nullptr) {
+        this->_info.pViewportState = &(this->_viewport_state);
+    }
+    if (other._info.pRasterizationState != nullptr) {
+        this->_info.pRasterizationState = &(this->_rasterization_state);
+    }
+    if (other._info.pMultisampleState != nullptr) {
+        this->_info.pMultisampleState = &(this->_multisample_state);
+    }
+    if (other._info.pColorBlendState != nullptr) {
+        this->copy_arrays(this->_color_blend_state);
+        this->_info.pColorBlendState = &(this->_color_blend_state);
+    }
+    if (other._info.pDynamicState != nullptr) {
+        this->copy_arrays(this->_dynamic_state);
+        this->_info.pDynamicState = &(this->_dynamic_state);
+    }
+
+    return *this;
 }
 
 void GraphicsPipelineCreateInfo::set_stages(
     const pr::Vector<Pipeline::ShaderStageCreateInfo>& stages)
 {
-    uint64_t count = stages.length();
+    uint32_t count = stages.length();
 
-    this->_info.stageCount = count;
-
-    this->_stages = stages;
-    this->_vk_stages = {};
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_vk_stages.push_back(stages[i].c_struct());
+    auto *p = this->_arena.allocate<Pipeline::ShaderStageCreateInfo::CType>(
+        count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = stages[i].c_struct();
     }
+    this->copy_arrays(p, count);
 
-    this->_info.pStages = this->_vk_stages.data();
+    this->_info.stageCount = count;
+    this->_info.pStages = p;
 }
 
 void GraphicsPipelineCreateInfo::set_vertex_input_state(
     const Pipeline::VertexInputStateCreateInfo& info)
 {
     this->_vertex_input_state = info.c_struct();
+    this->copy_arrays(this->_vertex_input_state);
 
     this->_info.pVertexInputState = &(this->_vertex_input_state);
 }
@@ -445,6 +621,7 @@ void GraphicsPipelineCreateInfo::set_color_blend_state(
     const Pipeline::ColorBlendStateCreateInfo& info)
 {
     this->_color_blend_state = info.c_struct();
+    this->copy_arrays(this->_color_blend_state);
 
     this->_info.pColorBlendState = &(this->_color_blend_state);
 }
@@ -453,6 +630,7 @@ void GraphicsPipelineCreateInfo::set_dynamic_state(
     const Pipeline::DynamicStateCreateInfo& info)
 {
     this->_dynamic_state = info.c_struct();
+    this->copy_arrays(this->_dynamic_state);
 
     this->_info.pDynamicState = &(this->_dynamic_state);
 }
@@ -465,6 +643,13 @@ void GraphicsPipelineCreateInfo::set_layout(
     this->_info.layout = this->_layout;
 }
 
+void GraphicsPipelineCreateInfo::set_layout(PipelineLayoutRef layout)
+{
+    this->_layout = layout.c_ptr();
+
+    this->_info.layout = this->_layout;
+}
+
 void GraphicsPipelineCreateInfo::set_render_pass(
     const RenderPass& render_pass)
 {
@@ -473,6 +658,13 @@ void GraphicsPipelineCreateInfo::set_render_pass(
     this->_info.renderPass = this->_render_pass;
 }
 
+void GraphicsPipelineCreateInfo::set_render_pass(RenderPassRef render_pass)
+{
+    this->_render_pass = render_pass.c_ptr();
+
+    this->_info.renderPass = this->_render_pass;
+}
+
 void GraphicsPipelineCreateInfo::set_subpass(uint32_t subpass)
 {
     this->_info.subpass = subpass;
@@ -484,11 +676,50 @@ void GraphicsPipelineCreateInfo::set_base_pipeline_handle(
     this->_info.basePipelineHandle = pipeline_handle.c_ptr();
 }
 
+void GraphicsPipelineCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto GraphicsPipelineCreateInfo::c_struct() const -> CType
 {
     return this->_info;
 }
 
+void GraphicsPipelineCreateInfo::copy_arrays(
+    Pipeline::ShaderStageCreateInfo::CType *stages,
+    uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        stages[i].pName = this->_arena.copy_string(stages[i].pName);
+    }
+}
+
+void GraphicsPipelineCreateInfo::copy_arrays(
+    Pipeline::VertexInputStateCreateInfo::CType& state)
+{
+    state.pVertexBindingDescriptions = this->_arena.copy(
+        state.pVertexBindingDescriptions,
+        state.vertexBindingDescriptionCount);
+    state.pVertexAttributeDescriptions = this->_arena.copy(
+        state.pVertexAttributeDescriptions,
+        state.vertexAttributeDescriptionCount);
+}
+
+void GraphicsPipelineCreateInfo::copy_arrays(
+    Pipeline::ColorBlendStateCreateInfo::CType& state)
+{
+    state.pAttachments = this->_arena.copy(state.pAttachments,
+        state.attachmentCount);
+}
+
+void GraphicsPipelineCreateInfo::copy_arrays(
+    Pipeline::DynamicStateCreateInfo::CType& state)
+{
+    state.pDynamicStates = this->_arena.copy(state.pDynamicStates,
+        state.dynamicStateCount);
+}
+
 
 Pipeline::Pipeline()
 {
@@ -505,46 +736,83 @@ PipelineLayout::CreateInfo::CreateInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 
+    this->_info.setLayoutCount = 0;
+    this->_info.pSetLayouts = nullptr;
+    this->_info.pushConstantRangeCount = 0;
+    this->_info.pPushConstantRanges = nullptr;
+
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
 }
 
+PipelineLayout::CreateInfo::CreateInfo(const CreateInfo& other)
+{
+    *this = other;
+}
+
+auto PipelineLayout::CreateInfo::operator=(const CreateInfo& other)
+    -> CreateInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pSetLayouts = this->_arena.copy(other._info.pSetLayouts,
+        other._info.setLayoutCount);
+    this->_info.pPushConstantRanges = this->_arena.copy(
+        other._info.pPushConstantRanges, other._info.pushConstantRangeCount);
+
+    return *this;
+}
+
 void PipelineLayout::CreateInfo::set_set_layouts(
     const pr::Vector<::VkDescriptorSetLayout>& set_layouts)
 {
-    if (set_layouts.length() != 0) {
-        fprintf(stderr, "[WARN] Set layout setter with non-zero length Vector is not implemented.\n");
+    uint32_t count = set_layouts.length();
+
+    // Null for none.
+    auto *p = this->_arena.allocate<::VkDescriptorSetLayout>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = set_layouts[i];
     }
 
-    this->_info.setLayoutCount = 0;
-    this->_info.pSetLayouts = nullptr;
+    this->_info.setLayoutCount = count;
+    this->_info.pSetLayouts = p;
 }
 
 void PipelineLayout::CreateInfo::set_set_layouts(
     const pr::Vector<DescriptorSetLayout>& set_layouts)
 {
-    if (set_layouts.length() == 0) {
-        this->_info.setLayoutCount = 0;
-        this->_info.pSetLayouts = nullptr;
-    } else {
-        this->_info.setLayoutCount = set_layouts.length();
-        for (auto& set_layout: set_layouts) {
-            auto vk_set_layout = set_layout.c_ptr();
-            this->_set_layouts.push(vk_set_layout);
-        }
-        this->_info.pSetLayouts = this->_set_layouts.c_ptr();
+    uint32_t count = set_layouts.length();
+
+    auto *p = this->_arena.allocate<::VkDescriptorSetLayout>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = set_layouts[i].c_ptr();
     }
+
+    this->_info.setLayoutCount = count;
+    this->_info.pSetLayouts = p;
 }
 
 void PipelineLayout::CreateInfo::set_push_constant_range(
     const pr::Vector<::VkPushConstantRange>& push_constant_range)
 {
-    if (push_constant_range.length() != 0) {
-        fprintf(stderr, "[WARN] Push constant range setter with non-zero length Vector is not implemented.\n");
+    uint32_t count = push_constant_range.length();
+
+    auto *p = this->_arena.allocate<::VkPushConstantRange>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = push_constant_range[i];
     }
 
-    this->_info.pushConstantRangeCount = 0;
-    this->_info.pPushConstantRanges = nullptr;
+    this->_info.pushConstantRangeCount = count;
+    this->_info.pPushConstantRanges = p;
+}
+
+void PipelineLayout::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 auto PipelineLayout::CreateInfo::c_struct() const -> CType
@@ -621,5 +889,68 @@ auto VertexInputAttributeDescription::c_struct() const -> CType
     return this->_description;
 }
 
+
+ComputePipelineCreateInfo::ComputePipelineCreateInfo()
+{
+    this->_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+
+    this->_info.stage = Pipeline::ShaderStageCreateInfo().c_struct();
+    this->_info.layout = nullptr;
+    this->_info.basePipelineHandle = nullptr;
+    this->_info.basePipelineIndex = -1;
+
+    this->_info.flags = 0;
+    this->_info.pNext = nullptr;
+}
+
+ComputePipelineCreateInfo::ComputePipelineCreateInfo(
+    const ComputePipelineCreateInfo& other)
+{
+    *this = other;
+}
+
+auto ComputePipelineCreateInfo::operator=(
+    const ComputePipelineCreateInfo& other) -> ComputePipelineCreateInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.stage.pName = this->_arena.copy_string(
+        other._info.stage.pName);
+
+    return *this;
+}
+
+void ComputePipelineCreateInfo::set_stage(
+    const Pipeline::ShaderStageCreateInfo& stage)
+{
+    this->_info.stage = stage.c_struct();
+    this->_info.stage.pName = this->_arena.copy_string(
+        this->_info.stage.pName);
+}
+
+void ComputePipelineCreateInfo::set_layout(const PipelineLayout& layout)
+{
+    this->_info.layout = layout.c_ptr();
+}
+
+void ComputePipelineCreateInfo::set_layout(PipelineLayoutRef layout)
+{
+    this->_info.layout = layout.c_ptr();
+}
+
+void ComputePipelineCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
+auto ComputePipelineCreateInfo::c_struct() const -> CType
+{
+    return this->_info;
+}
+
 } // namespace vk
 } // namespace pr
@@ -0,0 +1,56 @@
+#include <prime-vulkan/query-pool.h>
+
+namespace pr {
+namespace vk {
+
+QueryPool::CreateInfo::CreateInfo()
+{
+    this->_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+
+    this->_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    this->_info.queryCount = 0;
+    this->_info.pipelineStatistics = 0;
+
+    this->_info.flags = 0;
+    this->_info.pNext = nullptr;
+}
+
+void QueryPool::CreateInfo::set_query_type(::VkQueryType type)
+{
+    this->_info.queryType = type;
+}
+
+void QueryPool::CreateInfo::set_query_count(uint32_t count)
+{
+    this->_info.queryCount = count;
+}
+
+void QueryPool::CreateInfo::set_pipeline_statistics(
+    ::VkQueryPipelineStatisticFlags statistics)
+{
+    this->_info.pipelineStatistics = statistics;
+}
+
+void QueryPool::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
+auto QueryPool::CreateInfo::c_struct() const -> CType
+{
+    return this->_info;
+}
+
+
+QueryPool::QueryPool()
+{
+    this->_pool = nullptr;
+}
+
+auto QueryPool::c_ptr() const -> CType
+{
+    return *(this->_pool);
+}
+
+} // namespace vk
+} // namespace pr
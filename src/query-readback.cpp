@@ -0,0 +1,186 @@
+#include <prime-vulkan/query-readback.h>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+QueryReadback::QueryReadback(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    ::VkQueryType type,
+    ::VkQueryPipelineStatisticFlags statistics,
+    uint32_t queries_per_frame,
+    uint32_t frame_latency)
+    : _device(device)
+{
+    this->_values_per_query = 1;
+    if (type == VK_QUERY_TYPE_PIPELINE_STATISTICS) {
+        this->_values_per_query = 0;
+        for (auto bits = statistics; bits != 0; bits &= bits - 1) {
+            this->_values_per_query += 1;
+        }
+    }
+    this->_queries_per_frame = queries_per_frame;
+    this->_frame_latency = frame_latency;
+    this->_frame = 0;
+    this->_read_slot = 0;
+    this->_used.resize(frame_latency,
+        std::vector<bool>(queries_per_frame, false));
+    this->_read_used.resize(queries_per_frame, false);
+
+    uint32_t query_count = queries_per_frame * frame_latency;
+
+    QueryPool::CreateInfo pool_info;
+    pool_info.set_query_type(type);
+    pool_info.set_query_count(query_count);
+    pool_info.set_pipeline_statistics(statistics);
+    this->_pool = this->_device.create_unique_query_pool(pool_info);
+
+    Buffer::CreateInfo buffer_info;
+    buffer_info.set_size(
+        sizeof(uint64_t) * this->_values_per_query * query_count);
+    buffer_info.set_usage(VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    buffer_info.set_sharing_mode(VK_SHARING_MODE_EXCLUSIVE);
+    this->_buffer = this->_device.create_unique_buffer(buffer_info);
+
+    // Host cached memory makes reading the results fast.
+    auto requirements = this->_device.memory_requirements_for(
+        this->_buffer.ref());
+    int32_t type_index = memory_properties.find_memory_type(
+        requirements.memory_type_bits(),
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    if (type_index < 0) {
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(),
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    }
+    if (type_index < 0) {
+        throw VulkanError(VK_ERROR_FEATURE_NOT_PRESENT);
+    }
+    auto flags = memory_properties.c_struct()
+        .memoryTypes[type_index].propertyFlags;
+    this->_coherent = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    MemoryAllocateInfo allocate_info;
+    allocate_info.set_allocation_size(requirements.size());
+    allocate_info.set_memory_type_index(type_index);
+    this->_memory = this->_device.allocate_unique_memory(allocate_info);
+
+    this->_device.bind_buffer_memory(this->_buffer.ref(),
+        this->_memory.ref(), 0);
+
+    // Stays mapped until the memory is freed.
+    void *data;
+    this->_device.map_memory(this->_memory.ref(), 0, VK_WHOLE_SIZE, 0,
+        &data);
+    this->_data = static_cast<const uint64_t*>(data);
+}
+
+bool QueryReadback::begin_frame(CommandBuffer& command_buffer)
+{
+    this->_frame += 1;
+    this->_read_slot = (this->_frame - 1) % this->_frame_latency;
+
+    auto& used = this->_used[this->_read_slot];
+    bool any = false;
+    for (uint32_t i = 0; i < this->_queries_per_frame; ++i) {
+        this->_read_used[i] = used[i];
+        any = any || used[i];
+        used[i] = false;
+    }
+
+    if (any && !this->_coherent) {
+        this->_device.invalidate_mapped_memory(this->_memory.ref(),
+            0, VK_WHOLE_SIZE);
+    }
+
+    command_buffer.reset_query_pool(this->_pool.ref(), this->first_query(),
+        this->_queries_per_frame);
+
+    return any;
+}
+
+uint32_t QueryReadback::use(uint32_t index)
+{
+    this->_used[(this->_frame - 1) % this->_frame_latency][index] = true;
+
+    return this->query(index);
+}
+
+uint32_t QueryReadback::query(uint32_t index) const
+{
+    return this->first_query() + index;
+}
+
+void QueryReadback::end_frame(CommandBuffer& command_buffer)
+{
+    auto& used = this->_used[(this->_frame - 1) % this->_frame_latency];
+    ::VkDeviceSize stride = sizeof(uint64_t) * this->_values_per_query;
+
+    bool copied = false;
+    uint32_t i = 0;
+    while (i < this->_queries_per_frame) {
+        if (!used[i]) {
+            i += 1;
+            continue;
+        }
+        uint32_t first = i;
+        while (i < this->_queries_per_frame && used[i]) {
+            i += 1;
+        }
+
+        // Unused queries are never available, so waiting is only safe on
+        // the used ones.
+        uint32_t query = this->query(first);
+        command_buffer.copy_query_pool_results(this->_pool.ref(),
+            query, i - first, this->_buffer.ref(), stride * query, stride,
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        copied = true;
+    }
+
+    if (copied) {
+        ::VkMemoryBarrier barrier;
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext = nullptr;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT, 0, { barrier }, {}, {});
+    }
+}
+
+const uint64_t* QueryReadback::values(uint32_t index) const
+{
+    if (!this->_read_used[index]) {
+        return nullptr;
+    }
+
+    uint32_t query = this->_queries_per_frame * this->_read_slot + index;
+
+    return this->_data + this->_values_per_query * query;
+}
+
+uint32_t QueryReadback::values_per_query() const
+{
+    return this->_values_per_query;
+}
+
+uint32_t QueryReadback::queries_per_frame() const
+{
+    return this->_queries_per_frame;
+}
+
+QueryPoolRef QueryReadback::pool() const
+{
+    return this->_pool.ref();
+}
+
+uint32_t QueryReadback::first_query() const
+{
+    return this->_queries_per_frame *
+        ((this->_frame - 1) % this->_frame_latency);
+}
+
+} // namespace vk
+} // namespace pr
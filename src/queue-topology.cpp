@@ -0,0 +1,114 @@
+#include <prime-vulkan/queue-topology.h>
+
+#include <stdexcept>
+
+namespace pr {
+namespace vk {
+
+QueueTopology::QueueTopology(const PhysicalDevice& physical_device)
+{
+    this->select(physical_device.queue_family_properties());
+}
+
+QueueTopology::QueueTopology(
+    const pr::Vector<QueueFamilyProperties>& families)
+{
+    this->select(families);
+}
+
+uint32_t QueueTopology::graphics_family() const
+{
+    return this->_graphics_family;
+}
+
+uint32_t QueueTopology::compute_family() const
+{
+    return this->_compute_family;
+}
+
+uint32_t QueueTopology::transfer_family() const
+{
+    return this->_transfer_family;
+}
+
+bool QueueTopology::has_dedicated_transfer() const
+{
+    return this->_transfer_family != this->_graphics_family;
+}
+
+bool QueueTopology::has_async_compute() const
+{
+    return this->_compute_family != this->_graphics_family;
+}
+
+pr::Vector<Device::QueueCreateInfo> QueueTopology::queue_create_infos() const
+{
+    pr::Vector<Device::QueueCreateInfo> infos;
+
+    uint32_t families[] = {
+        this->_graphics_family,
+        this->_compute_family,
+        this->_transfer_family,
+    };
+    for (uint32_t i = 0; i < 3; ++i) {
+        bool seen = false;
+        for (uint32_t j = 0; j < i; ++j) {
+            seen = seen || families[j] == families[i];
+        }
+        if (seen) {
+            continue;
+        }
+
+        Device::QueueCreateInfo info;
+        info.set_queue_family_index(families[i]);
+        info.set_queue_count(1);
+        info.set_queue_priorities({ 1.0f });
+        infos.push(info);
+    }
+
+    return infos;
+}
+
+void QueueTopology::select(const pr::Vector<QueueFamilyProperties>& families)
+{
+    const uint32_t none = families.length();
+    this->_graphics_family = none;
+    this->_compute_family = none;
+    this->_transfer_family = none;
+
+    for (uint32_t i = 0; i < families.length(); ++i) {
+        ::VkFlags flags = families[i].queue_flags();
+        if (families[i].queue_count() == 0) {
+            continue;
+        }
+
+        bool graphics = (flags & VK_QUEUE_GRAPHICS_BIT) != 0;
+        bool compute = (flags & VK_QUEUE_COMPUTE_BIT) != 0;
+        bool transfer = (flags & VK_QUEUE_TRANSFER_BIT) != 0;
+
+        if (graphics && this->_graphics_family == none) {
+            this->_graphics_family = i;
+        }
+        if (compute && !graphics && this->_compute_family == none) {
+            this->_compute_family = i;
+        }
+        if (transfer && !graphics && !compute &&
+                this->_transfer_family == none) {
+            this->_transfer_family = i;
+        }
+    }
+
+    if (this->_graphics_family == none) {
+        throw std::runtime_error("No graphics queue family.");
+    }
+    if (this->_compute_family == none) {
+        this->_compute_family = this->_graphics_family;
+    }
+    // Graphics and compute families support transfers as well.
+    if (this->_transfer_family == none) {
+        this->_transfer_family = this->_graphics_family;
+    }
+}
+
+} // namespace vk
+} // namespace pr
@@ -2,10 +2,9 @@
 
 #include <assert.h>
 
-#include <vector>
-
 #include <prime-vulkan/base.h>
 #include <prime-vulkan/fence.h>
+#include <prime-vulkan/tracer.h>
 
 namespace pr {
 namespace vk {
@@ -13,21 +12,47 @@ namespace vk {
 Queue::Queue()
 {
     this->_queue = nullptr;
+    this->_dispatch = DeviceDispatch::loader().get();
 }
 
 void Queue::submit(const pr::Vector<SubmitInfo>& submits, const Fence& fence)
 {
+    PRIME_VULKAN_TRACE_SCOPE("Queue::submit");
+
+    ::VkResult result;
+
+    uint32_t count = submits.length();
+
+    Arena arena;
+    auto *vk_submits = arena.allocate<SubmitInfo::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        vk_submits[i] = submits[i].c_struct();
+    }
+
+    result = this->_dispatch->vkQueueSubmit(this->_queue,
+        count, vk_submits, fence.c_ptr());
+
+    if (result != VK_SUCCESS) {
+        throw VulkanError(result);
+    }
+}
+
+void Queue::submit(const pr::Vector<SubmitInfo>& submits, FenceRef fence)
+{
+    PRIME_VULKAN_TRACE_SCOPE("Queue::submit");
+
     ::VkResult result;
 
     uint32_t count = submits.length();
 
-    std::vector<SubmitInfo::CType> vk_submits;
+    Arena arena;
+    auto *vk_submits = arena.allocate<SubmitInfo::CType>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        vk_submits.push_back(submits[i].c_struct());
+        vk_submits[i] = submits[i].c_struct();
     }
 
-    result = vkQueueSubmit(this->_queue,
-        count, vk_submits.data(), fence.c_ptr());
+    result = this->_dispatch->vkQueueSubmit(this->_queue,
+        count, vk_submits, fence.c_ptr());
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -36,17 +61,20 @@ void Queue::submit(const pr::Vector<SubmitInfo>& submits, const Fence& fence)
 
 void Queue::submit(const pr::Vector<SubmitInfo>& submits)
 {
+    PRIME_VULKAN_TRACE_SCOPE("Queue::submit");
+
     VkResult result;
 
     uint32_t count = submits.length();
 
-    std::vector<SubmitInfo::CType> vk_submits;
+    Arena arena;
+    auto *vk_submits = arena.allocate<SubmitInfo::CType>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        vk_submits.push_back(submits[i].c_struct());
+        vk_submits[i] = submits[i].c_struct();
     }
 
-    result = vkQueueSubmit(this->_queue,
-        count, vk_submits.data(), VK_NULL_HANDLE);
+    result = this->_dispatch->vkQueueSubmit(this->_queue,
+        count, vk_submits, VK_NULL_HANDLE);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -55,11 +83,14 @@ void Queue::submit(const pr::Vector<SubmitInfo>& submits)
 
 void Queue::present(const PresentInfo& present_info)
 {
+    PRIME_VULKAN_TRACE_SCOPE("Queue::present");
+
     ::VkResult result;
 
     PresentInfo::CType vk_present_info = present_info.c_struct();
 
-    result = vkQueuePresentKHR(this->_queue, &vk_present_info);
+    result = this->_dispatch->vkQueuePresentKHR(this->_queue,
+        &vk_present_info);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -69,7 +100,7 @@ void Queue::present(const PresentInfo& present_info)
 void Queue::wait_idle()
 {
     VkResult result;
-    result = vkQueueWaitIdle(this->_queue);
+    result = this->_dispatch->vkQueueWaitIdle(this->_queue);
 
     if (result != VK_SUCCESS) {
         throw VulkanError(result);
@@ -87,21 +118,60 @@ SubmitInfo::SubmitInfo()
     this->_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
     this->_info.waitSemaphoreCount = 0;
+    this->_info.pWaitSemaphores = nullptr;
+    this->_info.pWaitDstStageMask = nullptr;
+    this->_info.commandBufferCount = 0;
+    this->_info.pCommandBuffers = nullptr;
     this->_info.signalSemaphoreCount = 0;
+    this->_info.pSignalSemaphores = nullptr;
 
     this->_info.pNext = nullptr;
 }
 
+SubmitInfo::SubmitInfo(const SubmitInfo& other)
+{
+    *this = other;
+}
+
+auto SubmitInfo::operator=(const SubmitInfo& other) -> SubmitInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pWaitSemaphores = this->_arena.copy(
+        other._info.pWaitSemaphores, other._info.waitSemaphoreCount);
+    this->_info.pWaitDstStageMask = this->_arena.copy(
+        other._info.pWaitDstStageMask, other._info.waitSemaphoreCount);
+    this->_info.pCommandBuffers = this->_arena.copy(
+        other._info.pCommandBuffers, other._info.commandBufferCount);
+    this->_info.pSignalSemaphores = this->_arena.copy(
+        other._info.pSignalSemaphores, other._info.signalSemaphoreCount);
+
+    return *this;
+}
+
 void SubmitInfo::set_wait_semaphores(const pr::Vector<Semaphore>& semaphores)
 {
     uint32_t count = semaphores.length();
 
-    this->_info.waitSemaphoreCount = count;
-
+    auto *p = this->_arena.allocate<Semaphore::CType>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        this->_wait_semaphores.push_back(semaphores[i].c_ptr());
+        p[i] = semaphores[i].c_ptr();
     }
-    this->_info.pWaitSemaphores = this->_wait_semaphores.data();
+
+    this->_info.waitSemaphoreCount = count;
+    this->_info.pWaitSemaphores = p;
+}
+
+void SubmitInfo::set_wait_semaphores(
+    std::initializer_list<SemaphoreRef> semaphores)
+{
+    this->_info.waitSemaphoreCount = semaphores.size();
+    this->_info.pWaitSemaphores = this->_arena.copy(
+        SemaphoreRef::c_ptrs(semaphores.begin()), semaphores.size());
 }
 
 void SubmitInfo::set_wait_dst_stage_mask(
@@ -111,10 +181,11 @@ void SubmitInfo::set_wait_dst_stage_mask(
 
     assert(this->_info.waitSemaphoreCount == count);
 
+    auto *p = this->_arena.allocate<::VkPipelineStageFlags>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        this->_wait_dst_stage_mask.push_back(mask[i]);
+        p[i] = mask[i];
     }
-    this->_info.pWaitDstStageMask = this->_wait_dst_stage_mask.data();
+    this->_info.pWaitDstStageMask = p;
 }
 
 void SubmitInfo::set_command_buffers(
@@ -122,24 +193,48 @@ void SubmitInfo::set_command_buffers(
 {
     uint32_t count = command_buffers.length();
 
-    this->_info.commandBufferCount = count;
-
+    auto *p = this->_arena.allocate<CommandBuffer::CType>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        this->_command_buffers.push_back(command_buffers[i].c_ptr());
+        p[i] = command_buffers[i].c_ptr();
     }
-    this->_info.pCommandBuffers = this->_command_buffers.data();
+
+    this->_info.commandBufferCount = count;
+    this->_info.pCommandBuffers = p;
+}
+
+void SubmitInfo::set_command_buffers(
+    std::initializer_list<CommandBufferRef> command_buffers)
+{
+    this->_info.commandBufferCount = command_buffers.size();
+    this->_info.pCommandBuffers = this->_arena.copy(
+        CommandBufferRef::c_ptrs(command_buffers.begin()),
+        command_buffers.size());
 }
 
 void SubmitInfo::set_signal_semaphores(const pr::Vector<Semaphore>& semaphores)
 {
     uint32_t count = semaphores.length();
 
-    this->_info.signalSemaphoreCount = count;
-
+    auto *p = this->_arena.allocate<Semaphore::CType>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        this->_signal_semaphores.push_back(semaphores[i].c_ptr());
+        p[i] = semaphores[i].c_ptr();
     }
-    this->_info.pSignalSemaphores = this->_signal_semaphores.data();
+
+    this->_info.signalSemaphoreCount = count;
+    this->_info.pSignalSemaphores = p;
+}
+
+void SubmitInfo::set_signal_semaphores(
+    std::initializer_list<SemaphoreRef> semaphores)
+{
+    this->_info.signalSemaphoreCount = semaphores.size();
+    this->_info.pSignalSemaphores = this->_arena.copy(
+        SemaphoreRef::c_ptrs(semaphores.begin()), semaphores.size());
+}
+
+void SubmitInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 auto SubmitInfo::c_struct() const -> CType
@@ -152,37 +247,94 @@ PresentInfo::PresentInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
+    this->_info.waitSemaphoreCount = 0;
+    this->_info.pWaitSemaphores = nullptr;
+    this->_info.swapchainCount = 0;
+    this->_info.pSwapchains = nullptr;
+    this->_info.pImageIndices = nullptr;
     this->_info.pResults = nullptr;
 
     this->_info.pNext = nullptr;
 }
 
+PresentInfo::PresentInfo(const PresentInfo& other)
+{
+    *this = other;
+}
+
+auto PresentInfo::operator=(const PresentInfo& other) -> PresentInfo&
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pWaitSemaphores = this->_arena.copy(
+        other._info.pWaitSemaphores, other._info.waitSemaphoreCount);
+    this->_info.pSwapchains = this->_arena.copy(
+        other._info.pSwapchains, other._info.swapchainCount);
+    this->_info.pImageIndices = this->_arena.copy(
+        other._info.pImageIndices, other._info.swapchainCount);
+
+    return *this;
+}
+
 void PresentInfo::set_wait_semaphores(const pr::Vector<Semaphore>& semaphores)
 {
-    this->_info.waitSemaphoreCount = semaphores.length();
+    uint32_t count = semaphores.length();
 
-    for (auto& semaphore: semaphores) {
-        this->_wait_semaphores.push_back(semaphore.c_ptr());
+    auto *p = this->_arena.allocate<Semaphore::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = semaphores[i].c_ptr();
     }
-    this->_info.pWaitSemaphores = this->_wait_semaphores.data();
+
+    this->_info.waitSemaphoreCount = count;
+    this->_info.pWaitSemaphores = p;
+}
+
+void PresentInfo::set_wait_semaphores(
+    std::initializer_list<SemaphoreRef> semaphores)
+{
+    this->_info.waitSemaphoreCount = semaphores.size();
+    this->_info.pWaitSemaphores = this->_arena.copy(
+        SemaphoreRef::c_ptrs(semaphores.begin()), semaphores.size());
 }
 
 void PresentInfo::set_swapchains(const pr::Vector<Swapchain>& swapchains)
 {
-    this->_info.swapchainCount = swapchains.length();
+    uint32_t count = swapchains.length();
 
-    for (auto& swapchain: swapchains) {
-        this->_swapchains.push_back(swapchain.c_ptr());
+    auto *p = this->_arena.allocate<Swapchain::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = swapchains[i].c_ptr();
     }
-    this->_info.pSwapchains = this->_swapchains.data();
+
+    this->_info.swapchainCount = count;
+    this->_info.pSwapchains = p;
 }
 
 void PresentInfo::set_image_indices(const pr::Vector<uint32_t>& indices)
 {
-    for (auto& index: indices) {
-        this->_indices.push_back(index);
+    uint32_t count = indices.length();
+
+    uint32_t *p = this->_arena.allocate<uint32_t>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = indices[i];
     }
-    this->_info.pImageIndices = this->_indices.data();
+    this->_info.pImageIndices = p;
+}
+
+void PresentInfo::set_swapchains(std::initializer_list<SwapchainRef> swapchains)
+{
+    this->_info.swapchainCount = swapchains.size();
+    this->_info.pSwapchains = this->_arena.copy(
+        SwapchainRef::c_ptrs(swapchains.begin()), swapchains.size());
+}
+
+void PresentInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 auto PresentInfo::c_struct() const -> CType
@@ -0,0 +1,361 @@
+#include <prime-vulkan/readback-queue.h>
+
+#include <stdexcept>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+ReadbackQueue::CreateInfo::CreateInfo()
+{
+    this->_frame_count = 3;
+    this->_buffer_size = 0;
+    this->_queue_family_index = 0;
+}
+
+void ReadbackQueue::CreateInfo::set_frame_count(uint32_t count)
+{
+    this->_frame_count = count;
+}
+
+void ReadbackQueue::CreateInfo::set_buffer_size(::VkDeviceSize size)
+{
+    this->_buffer_size = size;
+}
+
+void ReadbackQueue::CreateInfo::set_queue_family_index(uint32_t index)
+{
+    this->_queue_family_index = index;
+}
+
+
+ReadbackQueue::ReadbackQueue(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    const CreateInfo& info)
+    : _device(device),
+      _info(info)
+{
+    this->_coherent = true;
+    this->_stop = false;
+
+    CommandPool::CreateInfo pool_info;
+    pool_info.set_queue_family_index(info._queue_family_index);
+    pool_info.set_flags(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    this->_command_pool = this->_device.create_unique_command_pool(pool_info);
+
+    Buffer::CreateInfo buffer_info;
+    buffer_info.set_size(info._buffer_size);
+    buffer_info.set_usage(VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    buffer_info.set_sharing_mode(VK_SHARING_MODE_EXCLUSIVE);
+
+    Fence::CreateInfo fence_info;
+
+    CommandBuffer::AllocateInfo allocate_info;
+    allocate_info.set_command_pool(this->_command_pool.ref());
+    allocate_info.set_level(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    allocate_info.set_command_buffer_count(1);
+
+    auto properties = memory_properties.c_struct();
+
+    for (uint32_t i = 0; i < info._frame_count; ++i) {
+        Frame frame;
+        frame.buffer = this->_device.create_unique_buffer(buffer_info);
+
+        // Cached memory makes reading on the host fast.
+        auto requirements = this->_device.memory_requirements_for(
+            frame.buffer.ref());
+        int32_t type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(),
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+        if (type_index < 0) {
+            type_index = memory_properties.find_memory_type(
+                requirements.memory_type_bits(),
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+        }
+        if (type_index < 0) {
+            throw VulkanError(VK_ERROR_FEATURE_NOT_PRESENT);
+        }
+        if ((properties.memoryTypes[type_index].propertyFlags &
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0) {
+            this->_coherent = false;
+        }
+
+        MemoryAllocateInfo memory_info;
+        memory_info.set_allocation_size(requirements.size());
+        memory_info.set_memory_type_index(type_index);
+        frame.memory = this->_device.allocate_unique_memory(memory_info);
+
+        this->_device.bind_buffer_memory(frame.buffer.ref(),
+            frame.memory.ref(), 0);
+
+        // Stays mapped until the memory is freed.
+        void *data;
+        this->_device.map_memory(frame.memory.ref(), 0, VK_WHOLE_SIZE, 0,
+            &data);
+        frame.data = static_cast<const uint8_t*>(data);
+        frame.size = 0;
+
+        frame.fence = this->_device.create_unique_fence(fence_info);
+
+        this->_frames.push_back(std::move(frame));
+        this->_command_buffers.push_back(
+            this->_device.allocate_command_buffers(allocate_info));
+        this->_free.push_back(i);
+    }
+
+    this->_worker = std::thread(&ReadbackQueue::run, this);
+}
+
+ReadbackQueue::~ReadbackQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stop = true;
+    }
+    this->_condition.notify_all();
+
+    this->_worker.join();
+}
+
+std::future<std::vector<uint8_t>> ReadbackQueue::read_image(Queue& queue,
+    ImageRef image,
+    ::VkImageLayout layout,
+    ::VkExtent2D extent,
+    uint32_t texel_size,
+    std::initializer_list<SemaphoreRef> wait_semaphores,
+    ::VkImageAspectFlags aspect_mask)
+{
+    ::VkDeviceSize size =
+        ::VkDeviceSize(extent.width) * extent.height * texel_size;
+    uint32_t index = this->begin_frame(size);
+    auto& frame = this->_frames[index];
+    auto& command_buffer = this->_command_buffers[index];
+
+    ::VkImageMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = layout;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image.c_ptr();
+    barrier.subresourceRange.aspectMask = aspect_mask;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {}, {}, { barrier });
+
+    BufferImageCopy region;
+    region.set_image_subresource(aspect_mask, 0, 0, 1);
+    region.set_image_extent(::VkExtent3D { extent.width, extent.height, 1 });
+    command_buffer.copy_image_to_buffer(image,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, frame.buffer.ref(), { region });
+
+    if (layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask =
+            VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout = layout;
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, {}, {}, { barrier });
+    }
+
+    return this->submit_frame(queue, index, wait_semaphores);
+}
+
+std::future<std::vector<uint8_t>> ReadbackQueue::read_buffer(Queue& queue,
+    BufferRef buffer,
+    ::VkDeviceSize offset,
+    ::VkDeviceSize size,
+    std::initializer_list<SemaphoreRef> wait_semaphores)
+{
+    uint32_t index = this->begin_frame(size);
+    auto& frame = this->_frames[index];
+    auto& command_buffer = this->_command_buffers[index];
+
+    ::VkBufferMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer.c_ptr();
+    barrier.offset = offset;
+    barrier.size = size;
+    command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {}, { barrier }, {});
+
+    BufferCopy region;
+    region.set_src_offset(offset);
+    region.set_size(size);
+    command_buffer.copy_buffer(buffer, frame.buffer.ref(), { region });
+
+    return this->submit_frame(queue, index, wait_semaphores);
+}
+
+uint32_t ReadbackQueue::frame_count() const
+{
+    return this->_info._frame_count;
+}
+
+uint32_t ReadbackQueue::in_flight_count() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_submitted.size();
+}
+
+void ReadbackQueue::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_condition.wait(lock, [this]() {
+        return this->_submitted.empty();
+    });
+}
+
+uint32_t ReadbackQueue::begin_frame(::VkDeviceSize size)
+{
+    if (size > this->_info._buffer_size) {
+        throw std::length_error("Readback larger than the buffer size.");
+    }
+
+    uint32_t index;
+    {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_condition.wait(lock, [this]() {
+            return !this->_free.empty();
+        });
+        index = this->_free.back();
+        this->_free.pop_back();
+    }
+
+    try {
+        auto& frame = this->_frames[index];
+        frame.size = size;
+        frame.promise = std::promise<std::vector<uint8_t>>();
+        this->_device.reset_fences({ frame.fence.ref() });
+
+        CommandBuffer::BeginInfo begin_info;
+        begin_info.set_flags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        auto& command_buffer = this->_command_buffers[index];
+        command_buffer.reset(0);
+        command_buffer.begin(begin_info);
+    } catch (...) {
+        this->release_frame(index);
+        throw;
+    }
+
+    return index;
+}
+
+std::future<std::vector<uint8_t>> ReadbackQueue::submit_frame(Queue& queue,
+    uint32_t index,
+    std::initializer_list<SemaphoreRef> wait_semaphores)
+{
+    auto& frame = this->_frames[index];
+    auto& command_buffer = this->_command_buffers[index];
+
+    std::future<std::vector<uint8_t>> future;
+    try {
+        // Make the copy visible to the host.
+        ::VkMemoryBarrier barrier;
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext = nullptr;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT, 0, { barrier }, {}, {});
+        command_buffer.end();
+
+        pr::Vector<::VkPipelineStageFlags> stages;
+        for (uint32_t i = 0; i < wait_semaphores.size(); ++i) {
+            stages.push(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+
+        SubmitInfo submit;
+        submit.set_wait_semaphores(wait_semaphores);
+        submit.set_wait_dst_stage_mask(stages);
+        submit.set_command_buffers({ CommandBufferRef(command_buffer) });
+
+        future = frame.promise.get_future();
+        queue.submit({ submit }, frame.fence.ref());
+    } catch (...) {
+        this->release_frame(index);
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_submitted.push_back(index);
+    }
+    this->_condition.notify_all();
+
+    return future;
+}
+
+void ReadbackQueue::release_frame(uint32_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_free.push_back(index);
+    }
+    this->_condition.notify_all();
+}
+
+void ReadbackQueue::run()
+{
+    for (;;) {
+        uint32_t index;
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_condition.wait(lock, [this]() {
+                return this->_stop || !this->_submitted.empty();
+            });
+            // Drain the submitted frames before stopping.
+            if (this->_submitted.empty()) {
+                return;
+            }
+            index = this->_submitted.front();
+        }
+
+        auto& frame = this->_frames[index];
+        std::vector<uint8_t> data;
+        std::exception_ptr error;
+        try {
+            this->_device.wait_for_fences({ frame.fence.ref() },
+                true, UINT64_MAX);
+            if (!this->_coherent) {
+                this->_device.invalidate_mapped_memory(frame.memory.ref(),
+                    0, VK_WHOLE_SIZE);
+            }
+            data.assign(frame.data, frame.data + frame.size);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        auto promise = std::move(frame.promise);
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_submitted.pop_front();
+            this->_free.push_back(index);
+        }
+        this->_condition.notify_all();
+
+        if (error) {
+            promise.set_exception(error);
+        } else {
+            promise.set_value(std::move(data));
+        }
+    }
+}
+
+} // namespace vk
+} // namespace pr
@@ -0,0 +1,646 @@
+#include <prime-vulkan/render-graph.h>
+
+#include <assert.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+static const ::VkAccessFlags2 framebuffer_local_access =
+    VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT |
+    VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+    VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+RenderGraph::TransientImageInfo::TransientImageInfo()
+{
+    this->_format = VK_FORMAT_UNDEFINED;
+    this->_extent.width = 0;
+    this->_extent.height = 0;
+    this->_usage = 0;
+    this->_samples = VK_SAMPLE_COUNT_1_BIT;
+    this->_aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT;
+}
+
+void RenderGraph::TransientImageInfo::set_format(::VkFormat format)
+{
+    this->_format = format;
+}
+
+void RenderGraph::TransientImageInfo::set_extent(::VkExtent2D extent)
+{
+    this->_extent = extent;
+}
+
+void RenderGraph::TransientImageInfo::set_usage(::VkImageUsageFlags usage)
+{
+    this->_usage = usage;
+}
+
+void RenderGraph::TransientImageInfo::set_samples(
+    ::VkSampleCountFlagBits samples)
+{
+    this->_samples = samples;
+}
+
+void RenderGraph::TransientImageInfo::set_aspect_mask(
+    ::VkImageAspectFlags aspect_mask)
+{
+    this->_aspect_mask = aspect_mask;
+}
+
+
+RenderGraph::Pass::Pass(const pr::String& name)
+    : _name(name)
+{
+    this->_side_effects = false;
+}
+
+void RenderGraph::Pass::read(ResourceId resource, const ResourceState& state)
+{
+    this->_uses.push_back(Use { resource, state, false });
+}
+
+void RenderGraph::Pass::write(ResourceId resource, const ResourceState& state)
+{
+    this->_uses.push_back(Use { resource, state, true });
+}
+
+void RenderGraph::Pass::set_side_effects(bool side_effects)
+{
+    this->_side_effects = side_effects;
+}
+
+void RenderGraph::Pass::set_record(
+    std::function<void(CommandBuffer&)> record)
+{
+    this->_record = record;
+}
+
+const pr::String& RenderGraph::Pass::name() const
+{
+    return this->_name;
+}
+
+
+RenderGraph::Resource::Resource()
+{
+    this->transient = false;
+    this->image = VK_NULL_HANDLE;
+    this->buffer = VK_NULL_HANDLE;
+    this->aspect_mask = 0;
+    this->size = 0;
+    this->first = -1;
+    this->last = -1;
+    this->previous_alias = -1;
+}
+
+
+RenderGraph::RenderGraph(const Device& device)
+    : _device(device)
+{
+    this->_compiled = false;
+}
+
+auto RenderGraph::create_image(const TransientImageInfo& info) -> ResourceId
+{
+    Resource resource;
+    resource.transient = true;
+    resource.info = info;
+    resource.aspect_mask = info._aspect_mask;
+
+    this->_resources.push_back(std::move(resource));
+    this->_compiled = false;
+
+    return this->_resources.size() - 1;
+}
+
+auto RenderGraph::import_image(ImageRef image,
+                               const ResourceState& initial,
+                               const ResourceState& final,
+                               ::VkImageAspectFlags aspect_mask)
+    -> ResourceId
+{
+    Resource resource;
+    resource.image = image.c_ptr();
+    resource.initial = initial;
+    resource.final = final;
+    resource.aspect_mask = aspect_mask;
+
+    this->_resources.push_back(std::move(resource));
+    this->_compiled = false;
+
+    return this->_resources.size() - 1;
+}
+
+auto RenderGraph::import_buffer(BufferRef buffer,
+                                const ResourceState& initial) -> ResourceId
+{
+    Resource resource;
+    resource.buffer = buffer.c_ptr();
+    resource.initial = initial;
+
+    this->_resources.push_back(std::move(resource));
+    this->_compiled = false;
+
+    return this->_resources.size() - 1;
+}
+
+void RenderGraph::set_imported_image(ResourceId resource, ImageRef image)
+{
+    assert(!this->_resources[resource].transient);
+
+    this->_resources[resource].image = image.c_ptr();
+}
+
+auto RenderGraph::add_pass(const pr::String& name) -> Pass&
+{
+    this->_passes.push_back(std::unique_ptr<Pass>(new Pass(name)));
+    this->_compiled = false;
+
+    return *(this->_passes.back());
+}
+
+void RenderGraph::compile(
+    const PhysicalDevice::MemoryProperties& memory_properties)
+{
+    // Views and images go before the memory they are bound to.
+    for (auto& resource: this->_resources) {
+        resource.view.reset();
+        resource.owned_image.reset();
+        resource.size = 0;
+        resource.first = -1;
+        resource.last = -1;
+        resource.previous_alias = -1;
+    }
+    this->_slots.clear();
+    this->_tracker.clear();
+
+    this->sort_and_cull();
+    this->allocate_transients(memory_properties);
+
+    this->_compiled = true;
+}
+
+void RenderGraph::execute(CommandBuffer& command_buffer)
+{
+    assert(this->_compiled);
+
+    for (ResourceId id = 0; id < this->_resources.size(); ++id) {
+        const Resource& resource = this->_resources[id];
+        if (resource.transient) {
+            continue;
+        }
+        if (resource.buffer != VK_NULL_HANDLE) {
+            this->_tracker.set_buffer_state(this->buffer(id),
+                resource.initial);
+        } else {
+            this->_tracker.set_image_state(this->image(id),
+                resource.initial, resource.aspect_mask);
+        }
+    }
+
+    for (uint32_t i = 0; i < this->_order.size(); ++i) {
+        Pass& pass = *(this->_passes[this->_order[i]]);
+
+        // A transient image starts undefined, but must wait for the last
+        // use of its memory: an alias, or itself in the previous frame.
+        for (ResourceId id = 0; id < this->_resources.size(); ++id) {
+            const Resource& resource = this->_resources[id];
+            if (!resource.transient || resource.first != int64_t(i)) {
+                continue;
+            }
+            ResourceState last = this->_tracker.image_state(
+                this->image(resource.previous_alias));
+            this->_tracker.set_image_state(this->image(id),
+                ResourceState(last.stages(),
+                    ResourceState::write_access(last.access())),
+                resource.aspect_mask);
+        }
+
+        for (auto& use: pass._uses) {
+            const Resource& resource = this->_resources[use.resource];
+            if (resource.buffer != VK_NULL_HANDLE) {
+                this->_tracker.use_buffer(this->buffer(use.resource),
+                    use.state);
+            } else {
+                this->_tracker.use_image(this->image(use.resource),
+                    use.state, resource.aspect_mask);
+            }
+        }
+        this->_tracker.flush(command_buffer);
+
+        if (pass._record) {
+            pass._record(command_buffer);
+        }
+    }
+
+    for (ResourceId id = 0; id < this->_resources.size(); ++id) {
+        const Resource& resource = this->_resources[id];
+        if (resource.transient || resource.buffer != VK_NULL_HANDLE ||
+                resource.final.layout() == VK_IMAGE_LAYOUT_UNDEFINED) {
+            continue;
+        }
+        this->_tracker.use_image(this->image(id), resource.final,
+            resource.aspect_mask);
+    }
+    this->_tracker.flush(command_buffer);
+}
+
+ImageRef RenderGraph::image(ResourceId resource) const
+{
+    const Resource& r = this->_resources[resource];
+    if (r.transient) {
+        return r.owned_image.ref();
+    }
+
+    return ImageRef::from_c_ptr(r.image);
+}
+
+ImageViewRef RenderGraph::image_view(ResourceId resource) const
+{
+    const Resource& r = this->_resources[resource];
+    if (r.transient) {
+        return r.view.ref();
+    }
+
+    return ImageViewRef();
+}
+
+BufferRef RenderGraph::buffer(ResourceId resource) const
+{
+    return BufferRef::from_c_ptr(this->_resources[resource].buffer);
+}
+
+pr::Vector<pr::String> RenderGraph::pass_order() const
+{
+    pr::Vector<pr::String> names;
+    for (auto index: this->_order) {
+        names.push(this->_passes[index]->name());
+    }
+
+    return names;
+}
+
+uint32_t RenderGraph::culled_pass_count() const
+{
+    return this->_passes.size() - this->_order.size();
+}
+
+pr::Vector<SubpassDependency> RenderGraph::subpass_dependencies() const
+{
+    struct Masks
+    {
+        ::VkPipelineStageFlags2 src_stages;
+        ::VkAccessFlags2 src_access;
+        ::VkPipelineStageFlags2 dst_stages;
+        ::VkAccessFlags2 dst_access;
+    };
+    std::map<std::pair<uint32_t, uint32_t>, Masks> dependencies;
+
+    auto add = [&](uint32_t src, uint32_t dst,
+                   ::VkPipelineStageFlags2 src_stages,
+                   ::VkAccessFlags2 src_access,
+                   const ResourceState& dst_state) {
+        auto it = dependencies.find(std::make_pair(src, dst));
+        if (it == dependencies.end()) {
+            dependencies[std::make_pair(src, dst)] = Masks {
+                src_stages, src_access,
+                dst_state.stages(), dst_state.access() };
+            return;
+        }
+        it->second.src_stages |= src_stages;
+        it->second.src_access |= src_access;
+        it->second.dst_stages |= dst_state.stages();
+        it->second.dst_access |= dst_state.access();
+    };
+
+    for (ResourceId id = 0; id < this->_resources.size(); ++id) {
+        int64_t writer = -1;
+        ResourceState written;
+        std::vector<std::pair<uint32_t, ::VkPipelineStageFlags2>> readers;
+
+        for (uint32_t i = 0; i < this->_order.size(); ++i) {
+            for (auto& use: this->_passes[this->_order[i]]->_uses) {
+                if (use.resource != id) {
+                    continue;
+                }
+                if (writer >= 0 && writer != int64_t(i)) {
+                    add(writer, i, written.stages(),
+                        ResourceState::write_access(written.access()),
+                        use.state);
+                }
+                if (!use.write) {
+                    readers.push_back(std::make_pair(i, use.state.stages()));
+                    continue;
+                }
+                // Write after read only needs an execution dependency.
+                for (auto& reader: readers) {
+                    if (reader.first != i) {
+                        add(reader.first, i, reader.second, 0,
+                            ResourceState(use.state.stages(), 0));
+                    }
+                }
+                readers.clear();
+                writer = i;
+                written = use.state;
+            }
+        }
+    }
+
+    pr::Vector<SubpassDependency> vec;
+    for (auto& pair: dependencies) {
+        const Masks& masks = pair.second;
+
+        SubpassDependency dependency;
+        dependency.set_subpass_src_dst(pair.first.first, pair.first.second);
+        dependency.set_stage_mask_src_dst(
+            ResourceState::legacy_stages(masks.src_stages,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+            ResourceState::legacy_stages(masks.dst_stages,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT));
+        dependency.set_access_mask_src_dst(
+            ResourceState::legacy_access(masks.src_access),
+            ResourceState::legacy_access(masks.dst_access));
+        // Attachment to attachment or input attachment stays in the tile.
+        bool by_region =
+            (masks.src_access & ~framebuffer_local_access) == 0 &&
+            (masks.dst_access & ~framebuffer_local_access) == 0 &&
+            masks.dst_access != 0;
+        if (by_region) {
+            dependency.set_dependency_flags(VK_DEPENDENCY_BY_REGION_BIT);
+        }
+        vec.push(dependency);
+    }
+
+    return vec;
+}
+
+::VkDeviceSize RenderGraph::transient_memory_size() const
+{
+    ::VkDeviceSize size = 0;
+    for (auto& slot: this->_slots) {
+        size += slot.size;
+    }
+
+    return size;
+}
+
+::VkDeviceSize RenderGraph::unaliased_memory_size() const
+{
+    ::VkDeviceSize size = 0;
+    for (auto& resource: this->_resources) {
+        size += resource.size;
+    }
+
+    return size;
+}
+
+void RenderGraph::sort_and_cull()
+{
+    uint32_t count = this->_passes.size();
+    std::vector<std::vector<uint32_t>> successors(count);
+    std::vector<std::vector<uint32_t>> predecessors(count);
+
+    auto add_edge = [&](uint32_t from, uint32_t to) {
+        if (from != to) {
+            successors[from].push_back(to);
+            predecessors[to].push_back(from);
+        }
+    };
+
+    // Writers of a resource run in the order they were added, and pure
+    // readers after all of them.
+    for (ResourceId id = 0; id < this->_resources.size(); ++id) {
+        std::vector<uint32_t> writers;
+        std::vector<uint32_t> readers;
+        for (uint32_t p = 0; p < count; ++p) {
+            bool reads = false;
+            bool writes = false;
+            for (auto& use: this->_passes[p]->_uses) {
+                if (use.resource != id) {
+                    continue;
+                }
+                if (use.write) {
+                    writes = true;
+                } else {
+                    reads = true;
+                }
+            }
+            if (writes) {
+                writers.push_back(p);
+            } else if (reads) {
+                readers.push_back(p);
+            }
+        }
+        for (uint32_t k = 1; k < writers.size(); ++k) {
+            add_edge(writers[k - 1], writers[k]);
+        }
+        for (auto writer: writers) {
+            for (auto reader: readers) {
+                add_edge(writer, reader);
+            }
+        }
+    }
+
+    // Passes with side effects or writing imported resources are the
+    // roots. Everything they depend on stays.
+    std::vector<bool> live(count, false);
+    std::vector<uint32_t> stack;
+    for (uint32_t p = 0; p < count; ++p) {
+        bool root = this->_passes[p]->_side_effects;
+        for (auto& use: this->_passes[p]->_uses) {
+            if (use.write && !this->_resources[use.resource].transient) {
+                root = true;
+            }
+        }
+        if (root) {
+            live[p] = true;
+            stack.push_back(p);
+        }
+    }
+    while (!stack.empty()) {
+        uint32_t p = stack.back();
+        stack.pop_back();
+        for (auto q: predecessors[p]) {
+            if (!live[q]) {
+                live[q] = true;
+                stack.push_back(q);
+            }
+        }
+    }
+
+    // Kahn's algorithm. Ties keep the order the passes were added in.
+    std::vector<uint32_t> in_degree(count, 0);
+    uint32_t live_count = 0;
+    for (uint32_t p = 0; p < count; ++p) {
+        if (live[p]) {
+            in_degree[p] = predecessors[p].size();
+            ++live_count;
+        }
+    }
+    std::priority_queue<uint32_t, std::vector<uint32_t>,
+        std::greater<uint32_t>> ready;
+    for (uint32_t p = 0; p < count; ++p) {
+        if (live[p] && in_degree[p] == 0) {
+            ready.push(p);
+        }
+    }
+
+    this->_order.clear();
+    while (!ready.empty()) {
+        uint32_t p = ready.top();
+        ready.pop();
+        this->_order.push_back(p);
+        for (auto s: successors[p]) {
+            if (live[s] && --in_degree[s] == 0) {
+                ready.push(s);
+            }
+        }
+    }
+    if (this->_order.size() != live_count) {
+        this->_order.clear();
+        throw std::logic_error("Render graph has a dependency cycle.");
+    }
+
+    for (uint32_t i = 0; i < this->_order.size(); ++i) {
+        for (auto& use: this->_passes[this->_order[i]]->_uses) {
+            Resource& resource = this->_resources[use.resource];
+            if (resource.first < 0) {
+                resource.first = i;
+            }
+            resource.last = i;
+        }
+    }
+}
+
+void RenderGraph::allocate_transients(
+    const PhysicalDevice::MemoryProperties& memory_properties)
+{
+    std::vector<ResourceId> transients;
+    std::vector<uint32_t> memory_type_bits(this->_resources.size(), 0);
+
+    for (ResourceId id = 0; id < this->_resources.size(); ++id) {
+        Resource& resource = this->_resources[id];
+        if (!resource.transient || resource.first < 0) {
+            continue;
+        }
+
+        Image::CreateInfo info;
+        info.set_format(resource.info._format);
+        info.set_extent(::VkExtent3D {
+            resource.info._extent.width, resource.info._extent.height, 1 });
+        info.set_usage(resource.info._usage);
+        info.set_samples(resource.info._samples);
+        resource.owned_image = this->_device.create_unique_image(info);
+
+        auto requirements = this->_device.memory_requirements_for(
+            resource.owned_image.ref());
+        resource.size = requirements.size();
+        memory_type_bits[id] = requirements.memory_type_bits();
+
+        transients.push_back(id);
+    }
+
+    // Largest first, so that smaller images fill the gaps.
+    std::stable_sort(transients.begin(), transients.end(),
+        [this](ResourceId a, ResourceId b) {
+            return this->_resources[a].size > this->_resources[b].size;
+        });
+
+    for (auto id: transients) {
+        const Resource& resource = this->_resources[id];
+
+        Slot *found = nullptr;
+        for (auto& slot: this->_slots) {
+            if ((slot.memory_type_bits & memory_type_bits[id]) == 0) {
+                continue;
+            }
+            bool overlaps = false;
+            for (auto other: slot.resources) {
+                const Resource& o = this->_resources[other];
+                if (resource.first <= o.last && o.first <= resource.last) {
+                    overlaps = true;
+                    break;
+                }
+            }
+            if (!overlaps) {
+                found = &slot;
+                break;
+            }
+        }
+        if (found == nullptr) {
+            this->_slots.push_back(Slot());
+            found = &(this->_slots.back());
+            found->size = 0;
+            found->memory_type_bits = ~0u;
+        }
+
+        found->size = std::max(found->size, resource.size);
+        found->memory_type_bits &= memory_type_bits[id];
+        found->resources.push_back(id);
+    }
+
+    for (auto& slot: this->_slots) {
+        // Prefer device local memory.
+        int32_t type_index = memory_properties.find_memory_type(
+            slot.memory_type_bits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (type_index < 0) {
+            type_index = memory_properties.find_memory_type(
+                slot.memory_type_bits, 0);
+        }
+        if (type_index < 0) {
+            throw VulkanError(VK_ERROR_FEATURE_NOT_PRESENT);
+        }
+
+        MemoryAllocateInfo allocate_info;
+        allocate_info.set_allocation_size(slot.size);
+        allocate_info.set_memory_type_index(type_index);
+        slot.memory = this->_device.allocate_unique_memory(allocate_info);
+
+        std::sort(slot.resources.begin(), slot.resources.end(),
+            [this](ResourceId a, ResourceId b) {
+                return this->_resources[a].first < this->_resources[b].first;
+            });
+
+        uint32_t count = slot.resources.size();
+        for (uint32_t k = 0; k < count; ++k) {
+            Resource& resource = this->_resources[slot.resources[k]];
+            // The first user follows the last one of the previous frame.
+            resource.previous_alias = slot.resources[(k + count - 1) % count];
+
+            this->_device.bind_image_memory(resource.owned_image.ref(),
+                slot.memory.ref(), 0);
+
+            ::VkImageSubresourceRange range;
+            range.aspectMask = resource.aspect_mask;
+            range.baseMipLevel = 0;
+            range.levelCount = 1;
+            range.baseArrayLayer = 0;
+            range.layerCount = 1;
+
+            ImageView::CreateInfo view_info;
+            view_info.set_image(resource.owned_image.ref());
+            view_info.set_view_type(VK_IMAGE_VIEW_TYPE_2D);
+            view_info.set_format(resource.info._format);
+            view_info.set_components(VK_COMPONENT_SWIZZLE_IDENTITY,
+                                     VK_COMPONENT_SWIZZLE_IDENTITY,
+                                     VK_COMPONENT_SWIZZLE_IDENTITY,
+                                     VK_COMPONENT_SWIZZLE_IDENTITY);
+            view_info.set_subresource_range(range);
+            resource.view = this->_device.create_unique_image_view(view_info);
+        }
+    }
+}
+
+} // namespace vk
+} // namespace pr
@@ -87,29 +87,27 @@ SubpassDescription::SubpassDescription()
     this->_description.pDepthStencilAttachment = nullptr;
 
     this->_description.flags = 0;
-
-    this->_attachments = nullptr;
 }
 
 SubpassDescription::SubpassDescription(const SubpassDescription& other)
 {
-    this->_description = other._description;
-
-    if (other._attachments != nullptr) {
-        uint32_t count = other._description.colorAttachmentCount;
-        this->_attachments = new AttachmentReference::CType[count];
-        for (uint32_t i = 0; i < count; ++i) {
-            this->_attachments[i] = other._attachments[i];
-        }
-        this->_description.pColorAttachments = this->_attachments;
-    }
+    *this = other;
 }
 
-SubpassDescription::~SubpassDescription()
+auto SubpassDescription::operator=(const SubpassDescription& other)
+    -> SubpassDescription&
 {
-    if (this->_attachments != nullptr) {
-        delete[] this->_attachments;
+    if (this == &other) {
+        return *this;
     }
+    this->_arena.clear();
+
+    this->_description = other._description;
+    this->_description.pColorAttachments = this->_arena.copy(
+        other._description.pColorAttachments,
+        other._description.colorAttachmentCount);
+
+    return *this;
 }
 
 void SubpassDescription::set_pipeline_bind_point(::VkPipelineBindPoint bind_point)
@@ -120,16 +118,16 @@ void SubpassDescription::set_pipeline_bind_point(::VkPipelineBindPoint bind_poin
 void SubpassDescription::set_color_attachments(
     const pr::Vector<AttachmentReference>& attachments)
 {
-    uint64_t count = attachments.length();
-
-    this->_description.colorAttachmentCount = count;
+    uint32_t count = attachments.length();
 
-    // TODO: nullptr for zero-length vector.
-    this->_attachments = new AttachmentReference::CType[count];
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_attachments[i] = attachments[i].c_struct();
+    // Null for none.
+    auto *p = this->_arena.allocate<AttachmentReference::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = attachments[i].c_struct();
     }
-    this->_description.pColorAttachments = this->_attachments;
+
+    this->_description.colorAttachmentCount = count;
+    this->_description.pColorAttachments = p;
 }
 
 auto SubpassDescription::c_struct() const -> CType
@@ -163,6 +161,11 @@ void SubpassDependency::set_access_mask_src_dst(::VkAccessFlags src,
     this->_dependency.dstAccessMask = dst;
 }
 
+void SubpassDependency::set_dependency_flags(::VkDependencyFlags flags)
+{
+    this->_dependency.dependencyFlags = flags;
+}
+
 auto SubpassDependency::c_struct() const -> CType
 {
     return this->_dependency;
@@ -173,54 +176,92 @@ RenderPass::CreateInfo::CreateInfo()
 {
     this->_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
 
+    this->_info.attachmentCount = 0;
+    this->_info.pAttachments = nullptr;
+    this->_info.subpassCount = 0;
+    this->_info.pSubpasses = nullptr;
+    this->_info.dependencyCount = 0;
+    this->_info.pDependencies = nullptr;
+
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
 }
 
-RenderPass::CreateInfo::~CreateInfo()
+RenderPass::CreateInfo::CreateInfo(const CreateInfo& other)
+{
+    *this = other;
+}
+
+auto RenderPass::CreateInfo::operator=(const CreateInfo& other)
+    -> CreateInfo&
 {
+    if (this == &other) {
+        return *this;
+    }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pAttachments = this->_arena.copy(other._info.pAttachments,
+        other._info.attachmentCount);
+
+    auto *subpasses = this->_arena.copy(other._info.pSubpasses,
+        other._info.subpassCount);
+    this->copy_subpass_references(subpasses, other._info.subpassCount);
+    this->_info.pSubpasses = subpasses;
+
+    this->_info.pDependencies = this->_arena.copy(other._info.pDependencies,
+        other._info.dependencyCount);
+
+    return *this;
 }
 
 void RenderPass::CreateInfo::set_attachments(
     const pr::Vector<AttachmentDescription>& vec)
 {
-    this->_attachments = vec;
-    uint64_t count = vec.length();
-
-    this->_info.attachmentCount = count;
+    uint32_t count = vec.length();
 
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_p_attachments.push_back(this->_attachments[i].c_struct());
+    auto *p = this->_arena.allocate<AttachmentDescription::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = vec[i].c_struct();
     }
-    this->_info.pAttachments = this->_p_attachments.data();
+
+    this->_info.attachmentCount = count;
+    this->_info.pAttachments = p;
 }
 
 void RenderPass::CreateInfo::set_subpasses(
     const pr::Vector<SubpassDescription>& vec)
 {
-    this->_subpasses = vec;
-    uint64_t count = vec.length();
+    uint32_t count = vec.length();
 
-    this->_info.subpassCount = count;
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_p_subpasses.push_back(this->_subpasses[i].c_struct());
+    auto *p = this->_arena.allocate<SubpassDescription::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = vec[i].c_struct();
     }
+    // The references belong to `vec`.
+    this->copy_subpass_references(p, count);
 
-    this->_info.pSubpasses = this->_p_subpasses.data();
+    this->_info.subpassCount = count;
+    this->_info.pSubpasses = p;
 }
 
 void RenderPass::CreateInfo::set_dependencies(
     const pr::Vector<SubpassDependency>& vec)
 {
-    this->_dependencies = vec;
-    uint64_t count = vec.length();
+    uint32_t count = vec.length();
+
+    auto *p = this->_arena.allocate<SubpassDependency::CType>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = vec[i].c_struct();
+    }
 
     this->_info.dependencyCount = count;
+    this->_info.pDependencies = p;
+}
 
-    for (uint64_t i = 0; i < count; ++i) {
-        this->_p_dependencies.push_back(this->_dependencies[i].c_struct());
-    }
-    this->_info.pDependencies = this->_p_dependencies.data();
+void RenderPass::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 auto RenderPass::CreateInfo::c_struct() const -> CType
@@ -228,6 +269,25 @@ auto RenderPass::CreateInfo::c_struct() const -> CType
     return this->_info;
 }
 
+void RenderPass::CreateInfo::copy_subpass_references(
+    SubpassDescription::CType *subpasses,
+    uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& subpass = subpasses[i];
+        subpass.pInputAttachments = this->_arena.copy(
+            subpass.pInputAttachments, subpass.inputAttachmentCount);
+        subpass.pColorAttachments = this->_arena.copy(
+            subpass.pColorAttachments, subpass.colorAttachmentCount);
+        subpass.pResolveAttachments = this->_arena.copy(
+            subpass.pResolveAttachments, subpass.colorAttachmentCount);
+        subpass.pDepthStencilAttachment = this->_arena.copy(
+            subpass.pDepthStencilAttachment, 1);
+        subpass.pPreserveAttachments = this->_arena.copy(
+            subpass.pPreserveAttachments, subpass.preserveAttachmentCount);
+    }
+}
+
 
 RenderPass::BeginInfo::BeginInfo()
 {
@@ -241,11 +301,21 @@ void RenderPass::BeginInfo::set_render_pass(const RenderPass& render_pass)
     this->_info.renderPass = render_pass.c_ptr();
 }
 
+void RenderPass::BeginInfo::set_render_pass(RenderPassRef render_pass)
+{
+    this->_info.renderPass = render_pass.c_ptr();
+}
+
 void RenderPass::BeginInfo::set_framebuffer(const Framebuffer& framebuffer)
 {
     this->_info.framebuffer = framebuffer.c_ptr();
 }
 
+void RenderPass::BeginInfo::set_framebuffer(FramebufferRef framebuffer)
+{
+    this->_info.framebuffer = framebuffer.c_ptr();
+}
+
 void RenderPass::BeginInfo::set_render_area(::VkRect2D area)
 {
     this->_info.renderArea = area;
@@ -262,6 +332,11 @@ void RenderPass::BeginInfo::set_clear_values(
     this->_info.pClearValues = this->_clear_values.data();
 }
 
+void RenderPass::BeginInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto RenderPass::BeginInfo::c_struct() const -> CType
 {
     return this->_info;
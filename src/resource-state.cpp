@@ -0,0 +1,475 @@
+#include <prime-vulkan/resource-state.h>
+
+namespace pr {
+namespace vk {
+
+static const ::VkAccessFlags2 read_access_flags =
+    VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+    VK_ACCESS_2_INDEX_READ_BIT |
+    VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT |
+    VK_ACCESS_2_UNIFORM_READ_BIT |
+    VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT |
+    VK_ACCESS_2_SHADER_READ_BIT |
+    VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+    VK_ACCESS_2_TRANSFER_READ_BIT |
+    VK_ACCESS_2_HOST_READ_BIT |
+    VK_ACCESS_2_MEMORY_READ_BIT |
+    VK_ACCESS_2_SHADER_SAMPLED_READ_BIT |
+    VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+
+ResourceState::ResourceState()
+{
+    this->_stages = VK_PIPELINE_STAGE_2_NONE;
+    this->_access = VK_ACCESS_2_NONE;
+    this->_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+}
+
+ResourceState::ResourceState(::VkPipelineStageFlags2 stages,
+                             ::VkAccessFlags2 access,
+                             ::VkImageLayout layout)
+{
+    this->_stages = stages;
+    this->_access = access;
+    this->_layout = layout;
+}
+
+::VkPipelineStageFlags2 ResourceState::stages() const
+{
+    return this->_stages;
+}
+
+::VkAccessFlags2 ResourceState::access() const
+{
+    return this->_access;
+}
+
+::VkImageLayout ResourceState::layout() const
+{
+    return this->_layout;
+}
+
+bool ResourceState::writes() const
+{
+    return ResourceState::write_access(this->_access) != 0;
+}
+
+::VkAccessFlags2 ResourceState::read_access(::VkAccessFlags2 access)
+{
+    return access & read_access_flags;
+}
+
+::VkAccessFlags2 ResourceState::write_access(::VkAccessFlags2 access)
+{
+    return access & ~read_access_flags;
+}
+
+// Stage bits below 32 have the same values in both APIs. Fold the
+// synchronization2-only stages into their closest legacy stages.
+::VkPipelineStageFlags ResourceState::legacy_stages(
+    ::VkPipelineStageFlags2 stages, ::VkPipelineStageFlags none)
+{
+    const ::VkPipelineStageFlags2 transfer = VK_PIPELINE_STAGE_2_COPY_BIT |
+        VK_PIPELINE_STAGE_2_RESOLVE_BIT |
+        VK_PIPELINE_STAGE_2_BLIT_BIT |
+        VK_PIPELINE_STAGE_2_CLEAR_BIT;
+    const ::VkPipelineStageFlags2 vertex_input =
+        VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+        VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+    const ::VkPipelineStageFlags2 pre_rasterization =
+        VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT;
+    const ::VkPipelineStageFlags2 known = 0xFFFFFFFFULL | transfer |
+        vertex_input | pre_rasterization;
+
+    auto legacy = static_cast<::VkPipelineStageFlags>(stages & 0xFFFFFFFFULL);
+    if (stages & transfer) {
+        legacy |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+    if (stages & vertex_input) {
+        legacy |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+    if (stages & pre_rasterization) {
+        legacy |= VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
+    }
+    if (stages & ~known) {
+        legacy |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    return (legacy != 0) ? legacy : none;
+}
+
+::VkAccessFlags ResourceState::legacy_access(::VkAccessFlags2 access)
+{
+    auto legacy = static_cast<::VkAccessFlags>(access & 0xFFFFFFFFULL);
+    if (access & (VK_ACCESS_2_SHADER_SAMPLED_READ_BIT |
+            VK_ACCESS_2_SHADER_STORAGE_READ_BIT)) {
+        legacy |= VK_ACCESS_SHADER_READ_BIT;
+    }
+    if (access & VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT) {
+        legacy |= VK_ACCESS_SHADER_WRITE_BIT;
+    }
+
+    return legacy;
+}
+
+ResourceState ResourceState::transfer_read()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        VK_ACCESS_2_TRANSFER_READ_BIT,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+}
+
+ResourceState ResourceState::transfer_write()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+}
+
+ResourceState ResourceState::vertex_buffer()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT,
+        VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+}
+
+ResourceState ResourceState::index_buffer()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT,
+        VK_ACCESS_2_INDEX_READ_BIT);
+}
+
+ResourceState ResourceState::indirect_buffer()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+        VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT);
+}
+
+ResourceState ResourceState::uniform_buffer(::VkPipelineStageFlags2 stages)
+{
+    return ResourceState(stages, VK_ACCESS_2_UNIFORM_READ_BIT);
+}
+
+ResourceState ResourceState::shader_read(::VkPipelineStageFlags2 stages)
+{
+    return ResourceState(stages, VK_ACCESS_2_SHADER_READ_BIT,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+ResourceState ResourceState::shader_write(::VkPipelineStageFlags2 stages)
+{
+    return ResourceState(stages,
+        VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT,
+        VK_IMAGE_LAYOUT_GENERAL);
+}
+
+ResourceState ResourceState::color_attachment()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+            VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+}
+
+ResourceState ResourceState::depth_stencil_attachment()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+            VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+        VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+}
+
+ResourceState ResourceState::present()
+{
+    // The presentation engine waits on a semaphore, not on a stage.
+    return ResourceState(VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+}
+
+ResourceState ResourceState::host_read()
+{
+    return ResourceState(VK_PIPELINE_STAGE_2_HOST_BIT,
+        VK_ACCESS_2_HOST_READ_BIT);
+}
+
+
+ResourceStateTracker::Tracked::Tracked()
+{
+    this->write_stages = VK_PIPELINE_STAGE_2_NONE;
+    this->write_access = VK_ACCESS_2_NONE;
+    this->read_stages = VK_PIPELINE_STAGE_2_NONE;
+    this->visible_stages = VK_PIPELINE_STAGE_2_NONE;
+    this->visible_access = VK_ACCESS_2_NONE;
+    this->aspect_mask = 0;
+    this->pending = -1;
+}
+
+ResourceStateTracker::ResourceStateTracker()
+{
+}
+
+void ResourceStateTracker::use_buffer(BufferRef buffer,
+                                      const ResourceState& state)
+{
+    Tracked& tracked = this->_buffers[buffer.c_ptr()];
+
+    Barrier barrier;
+    if (!ResourceStateTracker::needs_barrier(tracked, state, false,
+            &barrier)) {
+        ResourceStateTracker::apply(tracked, state, false, false);
+        return;
+    }
+
+    if (tracked.pending >= 0) {
+        // Nothing was recorded in between, widen the queued barrier.
+        auto& vk_barrier = this->_buffer_barriers[tracked.pending];
+        vk_barrier.dstStageMask |= state.stages();
+        vk_barrier.dstAccessMask |= state.access();
+    } else {
+        ::VkBufferMemoryBarrier2 vk_barrier;
+        vk_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        vk_barrier.pNext = nullptr;
+        vk_barrier.srcStageMask = barrier.src_stages;
+        vk_barrier.srcAccessMask = barrier.src_access;
+        vk_barrier.dstStageMask = state.stages();
+        vk_barrier.dstAccessMask = state.access();
+        vk_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vk_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vk_barrier.buffer = buffer.c_ptr();
+        vk_barrier.offset = 0;
+        vk_barrier.size = VK_WHOLE_SIZE;
+
+        tracked.pending = this->_buffer_barriers.size();
+        this->_buffer_barriers.push_back(vk_barrier);
+    }
+
+    ResourceStateTracker::apply(tracked, state, false, true);
+}
+
+void ResourceStateTracker::use_image(ImageRef image,
+                                     const ResourceState& state,
+                                     ::VkImageAspectFlags aspect_mask)
+{
+    Tracked& tracked = this->_images[image.c_ptr()];
+    if (tracked.aspect_mask == 0) {
+        tracked.aspect_mask = aspect_mask;
+    }
+
+    Barrier barrier;
+    if (!ResourceStateTracker::needs_barrier(tracked, state, true,
+            &barrier)) {
+        ResourceStateTracker::apply(tracked, state, true, false);
+        return;
+    }
+
+    if (tracked.pending >= 0) {
+        auto& vk_barrier = this->_image_barriers[tracked.pending];
+        vk_barrier.dstStageMask |= state.stages();
+        vk_barrier.dstAccessMask |= state.access();
+        vk_barrier.newLayout = state.layout();
+    } else {
+        ::VkImageMemoryBarrier2 vk_barrier;
+        vk_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        vk_barrier.pNext = nullptr;
+        vk_barrier.srcStageMask = barrier.src_stages;
+        vk_barrier.srcAccessMask = barrier.src_access;
+        vk_barrier.dstStageMask = state.stages();
+        vk_barrier.dstAccessMask = state.access();
+        vk_barrier.oldLayout = tracked.last.layout();
+        vk_barrier.newLayout = state.layout();
+        vk_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vk_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vk_barrier.image = image.c_ptr();
+        vk_barrier.subresourceRange.aspectMask = tracked.aspect_mask;
+        vk_barrier.subresourceRange.baseMipLevel = 0;
+        vk_barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        vk_barrier.subresourceRange.baseArrayLayer = 0;
+        vk_barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+        tracked.pending = this->_image_barriers.size();
+        this->_image_barriers.push_back(vk_barrier);
+    }
+
+    ResourceStateTracker::apply(tracked, state, true, true);
+}
+
+void ResourceStateTracker::flush(CommandBuffer& command_buffer)
+{
+    if (this->_buffer_barriers.empty() && this->_image_barriers.empty()) {
+        return;
+    }
+
+    ::VkDependencyInfo info;
+    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    info.pNext = nullptr;
+    info.dependencyFlags = 0;
+    info.memoryBarrierCount = 0;
+    info.pMemoryBarriers = nullptr;
+    info.bufferMemoryBarrierCount = this->_buffer_barriers.size();
+    info.pBufferMemoryBarriers = this->_buffer_barriers.data();
+    info.imageMemoryBarrierCount = this->_image_barriers.size();
+    info.pImageMemoryBarriers = this->_image_barriers.data();
+
+    command_buffer.pipeline_barrier2(info);
+
+    for (auto& barrier: this->_buffer_barriers) {
+        auto it = this->_buffers.find(barrier.buffer);
+        if (it != this->_buffers.end()) {
+            it->second.pending = -1;
+        }
+    }
+    for (auto& barrier: this->_image_barriers) {
+        auto it = this->_images.find(barrier.image);
+        if (it != this->_images.end()) {
+            it->second.pending = -1;
+        }
+    }
+    this->_buffer_barriers.clear();
+    this->_image_barriers.clear();
+}
+
+uint32_t ResourceStateTracker::pending_barrier_count() const
+{
+    return this->_buffer_barriers.size() + this->_image_barriers.size();
+}
+
+void ResourceStateTracker::set_buffer_state(BufferRef buffer,
+                                            const ResourceState& state)
+{
+    ResourceStateTracker::assign(this->_buffers[buffer.c_ptr()], state);
+}
+
+void ResourceStateTracker::set_image_state(ImageRef image,
+                                           const ResourceState& state,
+                                           ::VkImageAspectFlags aspect_mask)
+{
+    Tracked& tracked = this->_images[image.c_ptr()];
+    ResourceStateTracker::assign(tracked, state);
+    tracked.aspect_mask = aspect_mask;
+}
+
+ResourceState ResourceStateTracker::buffer_state(BufferRef buffer) const
+{
+    auto it = this->_buffers.find(buffer.c_ptr());
+    if (it == this->_buffers.end()) {
+        return ResourceState();
+    }
+
+    return it->second.last;
+}
+
+ResourceState ResourceStateTracker::image_state(ImageRef image) const
+{
+    auto it = this->_images.find(image.c_ptr());
+    if (it == this->_images.end()) {
+        return ResourceState();
+    }
+
+    return it->second.last;
+}
+
+void ResourceStateTracker::forget(BufferRef buffer)
+{
+    this->_buffers.erase(buffer.c_ptr());
+}
+
+void ResourceStateTracker::forget(ImageRef image)
+{
+    this->_images.erase(image.c_ptr());
+}
+
+void ResourceStateTracker::clear()
+{
+    this->_buffers.clear();
+    this->_images.clear();
+    this->_buffer_barriers.clear();
+    this->_image_barriers.clear();
+}
+
+bool ResourceStateTracker::needs_barrier(const Tracked& tracked,
+                                         const ResourceState& state,
+                                         bool is_image,
+                                         Barrier *barrier)
+{
+    bool transition = is_image && state.layout() != tracked.last.layout();
+
+    // Write after write, write after read, or a layout change. Earlier
+    // reads only need an execution dependency.
+    if (transition || state.writes()) {
+        barrier->src_stages = tracked.write_stages | tracked.read_stages;
+        barrier->src_access = tracked.write_access;
+
+        return transition || barrier->src_stages != VK_PIPELINE_STAGE_2_NONE;
+    }
+
+    // Read after read.
+    if (tracked.write_stages == VK_PIPELINE_STAGE_2_NONE) {
+        return false;
+    }
+
+    // Read after write, unless an earlier barrier already covers it.
+    bool visible = (state.stages() & ~tracked.visible_stages) == 0 &&
+        (state.access() & ~tracked.visible_access) == 0;
+    if (visible) {
+        return false;
+    }
+    barrier->src_stages = tracked.write_stages;
+    barrier->src_access = tracked.write_access;
+
+    return true;
+}
+
+void ResourceStateTracker::assign(Tracked& tracked,
+                                  const ResourceState& state)
+{
+    int64_t pending = tracked.pending;
+    tracked = Tracked();
+    tracked.pending = pending;
+
+    if (state.writes()) {
+        tracked.write_stages = state.stages();
+        tracked.write_access = ResourceState::write_access(state.access());
+    } else {
+        tracked.read_stages = state.stages();
+    }
+    tracked.last = state;
+}
+
+void ResourceStateTracker::apply(Tracked& tracked,
+                                 const ResourceState& state,
+                                 bool is_image,
+                                 bool barrier)
+{
+    bool transition = is_image && state.layout() != tracked.last.layout();
+
+    if (state.writes()) {
+        // Later accesses must wait for this write.
+        tracked.write_stages = state.stages();
+        tracked.write_access = ResourceState::write_access(state.access());
+        tracked.read_stages = VK_PIPELINE_STAGE_2_NONE;
+        tracked.visible_stages = VK_PIPELINE_STAGE_2_NONE;
+        tracked.visible_access = VK_ACCESS_2_NONE;
+    } else if (transition) {
+        // The layout change is a write, visible to the stages it waited.
+        tracked.write_stages = state.stages();
+        tracked.write_access = VK_ACCESS_2_NONE;
+        tracked.read_stages = state.stages();
+        tracked.visible_stages = state.stages();
+        tracked.visible_access = state.access();
+    } else {
+        tracked.read_stages |= state.stages();
+        if (barrier) {
+            tracked.visible_stages |= state.stages();
+            tracked.visible_access |= state.access();
+        }
+    }
+
+    if (is_image) {
+        tracked.last = state;
+    } else {
+        tracked.last = ResourceState(state.stages(), state.access());
+    }
+}
+
+} // namespace vk
+} // namespace pr
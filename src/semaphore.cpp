@@ -10,6 +10,11 @@ Semaphore::CreateInfo::CreateInfo()
     this->_info.pNext = nullptr;
 }
 
+void Semaphore::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 auto Semaphore::CreateInfo::c_struct() const -> CType
 {
     return this->_info;
@@ -17,6 +17,11 @@ void ShaderModule::CreateInfo::set_code(const uint32_t *code, uint64_t size)
     this->_info.codeSize = size;
 }
 
+void ShaderModule::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 ::VkShaderModuleCreateInfo ShaderModule::CreateInfo::c_struct() const
 {
     return this->_info;
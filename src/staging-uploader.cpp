@@ -0,0 +1,243 @@
+#include <prime-vulkan/staging-uploader.h>
+
+#include <string.h>
+
+#include <numeric>
+#include <stdexcept>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+// Copies from a buffer need no alignment. Kept word aligned anyway.
+static const ::VkDeviceSize buffer_alignment = 4;
+
+// `bufferOffset` of a copy to an image must be a multiple of the texel
+// block size, and of 4. Block sizes of 3, 6, 12 or 24 bytes are not
+// powers of two.
+static ::VkDeviceSize image_alignment(uint32_t texel_size)
+{
+    if (texel_size == 0) {
+        throw std::invalid_argument("Texel size of 0.");
+    }
+
+    return std::lcm(::VkDeviceSize(texel_size), ::VkDeviceSize(4));
+}
+
+StagingUploader::StagingUploader(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    ::VkDeviceSize capacity)
+    : _device(device)
+{
+    this->_capacity = capacity;
+    this->_used = 0;
+
+    Buffer::CreateInfo buffer_info;
+    buffer_info.set_size(capacity);
+    buffer_info.set_usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    buffer_info.set_sharing_mode(VK_SHARING_MODE_EXCLUSIVE);
+    this->_buffer = this->_device.create_unique_buffer(buffer_info);
+
+    auto requirements = this->_device.memory_requirements_for(
+        this->_buffer.ref());
+    int32_t type_index = memory_properties.find_memory_type(
+        requirements.memory_type_bits(),
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (type_index < 0) {
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(),
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    }
+    if (type_index < 0) {
+        throw VulkanError(VK_ERROR_FEATURE_NOT_PRESENT);
+    }
+    auto flags = memory_properties.c_struct()
+        .memoryTypes[type_index].propertyFlags;
+    this->_coherent = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    MemoryAllocateInfo allocate_info;
+    allocate_info.set_allocation_size(requirements.size());
+    allocate_info.set_memory_type_index(type_index);
+    this->_memory = this->_device.allocate_unique_memory(allocate_info);
+
+    this->_device.bind_buffer_memory(this->_buffer.ref(),
+        this->_memory.ref(), 0);
+
+    // Stays mapped until the memory is freed.
+    void *data;
+    this->_device.map_memory(this->_memory.ref(), 0, VK_WHOLE_SIZE, 0,
+        &data);
+    this->_data = static_cast<uint8_t*>(data);
+}
+
+bool StagingUploader::upload_image(ImageRef image,
+    const void *data,
+    ::VkDeviceSize size,
+    uint32_t texel_size,
+    const pr::Vector<BufferImageCopy>& regions,
+    const ResourceState& final_state,
+    ::VkImageAspectFlags aspect_mask)
+{
+    int64_t offset = this->stage(data, size, image_alignment(texel_size));
+    if (offset < 0) {
+        return false;
+    }
+
+    ImageUpload *upload = nullptr;
+    for (auto& pending: this->_images) {
+        if (pending.image.c_ptr() == image.c_ptr()) {
+            upload = &pending;
+            break;
+        }
+    }
+    if (upload == nullptr) {
+        this->_images.push_back(ImageUpload());
+        upload = &this->_images.back();
+        upload->image = image;
+        upload->aspect_mask = aspect_mask;
+    }
+    upload->final_state = final_state;
+
+    for (auto& region: regions) {
+        BufferImageCopy staged = region;
+        staged.set_buffer_offset(region.c_struct().bufferOffset + offset);
+        upload->regions.push(staged);
+    }
+
+    return true;
+}
+
+bool StagingUploader::upload_buffer(BufferRef buffer,
+    ::VkDeviceSize offset,
+    const void *data,
+    ::VkDeviceSize size,
+    const ResourceState& final_state)
+{
+    int64_t staged = this->stage(data, size, buffer_alignment);
+    if (staged < 0) {
+        return false;
+    }
+
+    BufferUpload *upload = nullptr;
+    for (auto& pending: this->_buffers) {
+        if (pending.buffer.c_ptr() == buffer.c_ptr()) {
+            upload = &pending;
+            break;
+        }
+    }
+    if (upload == nullptr) {
+        this->_buffers.push_back(BufferUpload());
+        upload = &this->_buffers.back();
+        upload->buffer = buffer;
+    }
+    upload->final_state = final_state;
+
+    BufferCopy region;
+    region.set_src_offset(staged);
+    region.set_dst_offset(offset);
+    region.set_size(size);
+    upload->regions.push(region);
+
+    return true;
+}
+
+void StagingUploader::record(CommandBuffer& command_buffer,
+                             ResourceStateTracker& tracker)
+{
+    if (this->empty()) {
+        return;
+    }
+
+    for (auto& upload: this->_images) {
+        tracker.use_image(upload.image, ResourceState::transfer_write(),
+            upload.aspect_mask);
+    }
+    for (auto& upload: this->_buffers) {
+        tracker.use_buffer(upload.buffer, ResourceState::transfer_write());
+    }
+    tracker.flush(command_buffer);
+
+    this->copy(command_buffer);
+
+    for (auto& upload: this->_images) {
+        tracker.use_image(upload.image, upload.final_state,
+            upload.aspect_mask);
+    }
+    for (auto& upload: this->_buffers) {
+        tracker.use_buffer(upload.buffer, upload.final_state);
+    }
+    tracker.flush(command_buffer);
+
+    this->_images.clear();
+    this->_buffers.clear();
+}
+
+void StagingUploader::record_copies(CommandBuffer& command_buffer)
+{
+    this->copy(command_buffer);
+
+    this->_images.clear();
+    this->_buffers.clear();
+}
+
+void StagingUploader::reset()
+{
+    this->_used = 0;
+}
+
+bool StagingUploader::empty() const
+{
+    return this->_images.empty() && this->_buffers.empty();
+}
+
+::VkDeviceSize StagingUploader::capacity() const
+{
+    return this->_capacity;
+}
+
+::VkDeviceSize StagingUploader::used() const
+{
+    return this->_used;
+}
+
+int64_t StagingUploader::stage(const void *data, ::VkDeviceSize size,
+                               ::VkDeviceSize alignment)
+{
+    if (size > this->_capacity) {
+        throw std::length_error("Upload larger than the staging buffer.");
+    }
+
+    ::VkDeviceSize offset =
+        (this->_used + alignment - 1) / alignment * alignment;
+    if (offset + size > this->_capacity) {
+        return -1;
+    }
+
+    memcpy(this->_data + offset, data, size);
+    this->_used = offset + size;
+
+    return offset;
+}
+
+void StagingUploader::copy(CommandBuffer& command_buffer)
+{
+    if (!this->_coherent) {
+        this->_device.flush_mapped_memory(this->_memory.ref(),
+            0, VK_WHOLE_SIZE);
+    }
+
+    for (auto& upload: this->_images) {
+        command_buffer.copy_buffer_to_image(this->_buffer.ref(),
+            upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            upload.regions);
+    }
+    for (auto& upload: this->_buffers) {
+        command_buffer.copy_buffer(this->_buffer.ref(), upload.buffer,
+            upload.regions);
+    }
+}
+
+} // namespace vk
+} // namespace pr
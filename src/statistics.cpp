@@ -0,0 +1,198 @@
+#include <prime-vulkan/statistics.h>
+
+#include <atomic>
+
+namespace pr {
+namespace vk {
+
+// Object types with counters, in the order of the counters.
+static const ::VkObjectType counted_types[] = {
+    VK_OBJECT_TYPE_BUFFER,
+    VK_OBJECT_TYPE_IMAGE,
+    VK_OBJECT_TYPE_IMAGE_VIEW,
+    VK_OBJECT_TYPE_DEVICE_MEMORY,
+    VK_OBJECT_TYPE_SWAPCHAIN_KHR,
+    VK_OBJECT_TYPE_SHADER_MODULE,
+    VK_OBJECT_TYPE_PIPELINE_LAYOUT,
+    VK_OBJECT_TYPE_PIPELINE,
+    VK_OBJECT_TYPE_RENDER_PASS,
+    VK_OBJECT_TYPE_FRAMEBUFFER,
+    VK_OBJECT_TYPE_COMMAND_POOL,
+    VK_OBJECT_TYPE_COMMAND_BUFFER,
+    VK_OBJECT_TYPE_SEMAPHORE,
+    VK_OBJECT_TYPE_FENCE,
+    VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT,
+    VK_OBJECT_TYPE_DESCRIPTOR_POOL,
+    VK_OBJECT_TYPE_DESCRIPTOR_SET,
+    VK_OBJECT_TYPE_QUERY_POOL,
+};
+
+static const size_t counted_type_count =
+    sizeof(counted_types) / sizeof(counted_types[0]);
+
+// Zero-initialized, like any static.
+static struct
+{
+    std::atomic<uint64_t> created[counted_type_count];
+    std::atomic<uint64_t> destroyed[counted_type_count];
+    std::atomic<uint64_t> memory_type_bytes[VK_MAX_MEMORY_TYPES];
+    std::atomic<uint64_t> memory_type_allocations[VK_MAX_MEMORY_TYPES];
+    std::atomic<uint64_t> allocate_count;
+    std::atomic<uint64_t> free_count;
+    std::atomic<uint64_t> map_count;
+    std::atomic<uint64_t> unmap_count;
+} counters;
+
+// Index of the counters of `type`, or `counted_type_count`.
+static size_t counter_index(::VkObjectType type)
+{
+    size_t i = 0;
+    while (i < counted_type_count && counted_types[i] != type) {
+        i += 1;
+    }
+
+    return i;
+}
+
+void Statistics::object_created(::VkObjectType type, uint64_t count)
+{
+    size_t i = counter_index(type);
+    if (i < counted_type_count) {
+        counters.created[i].fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void Statistics::object_destroyed(::VkObjectType type)
+{
+    size_t i = counter_index(type);
+    if (i < counted_type_count) {
+        counters.destroyed[i].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Statistics::memory_allocated(uint32_t memory_type,
+                                  ::VkDeviceSize size)
+{
+    counters.allocate_count.fetch_add(1, std::memory_order_relaxed);
+    if (memory_type < VK_MAX_MEMORY_TYPES) {
+        counters.memory_type_bytes[memory_type].fetch_add(size,
+            std::memory_order_relaxed);
+        counters.memory_type_allocations[memory_type].fetch_add(1,
+            std::memory_order_relaxed);
+    }
+}
+
+void Statistics::memory_freed(uint32_t memory_type, ::VkDeviceSize size)
+{
+    counters.free_count.fetch_add(1, std::memory_order_relaxed);
+    if (memory_type < VK_MAX_MEMORY_TYPES) {
+        counters.memory_type_bytes[memory_type].fetch_sub(size,
+            std::memory_order_relaxed);
+        counters.memory_type_allocations[memory_type].fetch_sub(1,
+            std::memory_order_relaxed);
+    }
+}
+
+void Statistics::memory_mapped()
+{
+    counters.map_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Statistics::memory_unmapped()
+{
+    counters.unmap_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+Statistics::Statistics(const uint8_t *memory_heaps,
+                       uint32_t memory_type_count)
+{
+    auto relaxed = std::memory_order_relaxed;
+
+    for (size_t i = 0; i < counted_type_count; ++i) {
+        this->_created.push_back(counters.created[i].load(relaxed));
+        this->_destroyed.push_back(counters.destroyed[i].load(relaxed));
+    }
+
+    for (uint32_t i = 0; i < VK_MAX_MEMORY_HEAPS; ++i) {
+        this->_heap_bytes[i] = 0;
+    }
+    for (uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; ++i) {
+        this->_memory_type_bytes[i] =
+            counters.memory_type_bytes[i].load(relaxed);
+        this->_memory_type_allocations[i] =
+            counters.memory_type_allocations[i].load(relaxed);
+
+        if (i < memory_type_count) {
+            this->_heap_bytes[memory_heaps[i]] +=
+                this->_memory_type_bytes[i];
+        }
+    }
+
+    this->_allocate_count = counters.allocate_count.load(relaxed);
+    this->_free_count = counters.free_count.load(relaxed);
+    this->_map_count = counters.map_count.load(relaxed);
+    this->_unmap_count = counters.unmap_count.load(relaxed);
+}
+
+uint64_t Statistics::live_objects(::VkObjectType type) const
+{
+    size_t i = counter_index(type);
+    if (i == counted_type_count) {
+        return 0;
+    }
+
+    // Destroyed is read after created, so it may be ahead.
+    return (this->_created[i] > this->_destroyed[i])
+        ? this->_created[i] - this->_destroyed[i]
+        : 0;
+}
+
+uint64_t Statistics::created_objects(::VkObjectType type) const
+{
+    size_t i = counter_index(type);
+
+    return (i < counted_type_count) ? this->_created[i] : 0;
+}
+
+::VkDeviceSize Statistics::memory_type_bytes(uint32_t memory_type) const
+{
+    return (memory_type < VK_MAX_MEMORY_TYPES)
+        ? this->_memory_type_bytes[memory_type]
+        : 0;
+}
+
+uint64_t Statistics::memory_type_allocations(uint32_t memory_type) const
+{
+    return (memory_type < VK_MAX_MEMORY_TYPES)
+        ? this->_memory_type_allocations[memory_type]
+        : 0;
+}
+
+::VkDeviceSize Statistics::heap_bytes(uint32_t heap) const
+{
+    return (heap < VK_MAX_MEMORY_HEAPS) ? this->_heap_bytes[heap] : 0;
+}
+
+uint64_t Statistics::allocate_count() const
+{
+    return this->_allocate_count;
+}
+
+uint64_t Statistics::free_count() const
+{
+    return this->_free_count;
+}
+
+uint64_t Statistics::map_count() const
+{
+    return this->_map_count;
+}
+
+uint64_t Statistics::unmap_count() const
+{
+    return this->_unmap_count;
+}
+
+} // namespace vk
+} // namespace pr
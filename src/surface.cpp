@@ -23,6 +23,11 @@ Surface::WaylandSurfaceCreateInfo::WaylandSurfaceCreateInfo(
     this->_info.surface = surface;
 }
 
+void Surface::WaylandSurfaceCreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 ::VkWaylandSurfaceCreateInfoKHR
 Surface::WaylandSurfaceCreateInfo::c_struct() const
 {
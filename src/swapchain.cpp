@@ -26,15 +26,25 @@ Swapchain::CreateInfo::CreateInfo()
 
     this->_info.flags = 0;
     this->_info.pNext = nullptr;
+}
 
-    this->_indices = nullptr;
+Swapchain::CreateInfo::CreateInfo(const CreateInfo& other)
+{
+    *this = other;
 }
 
-Swapchain::CreateInfo::~CreateInfo()
+auto Swapchain::CreateInfo::operator=(const CreateInfo& other) -> CreateInfo&
 {
-    if (this->_indices != nullptr) {
-        delete[] this->_indices;
+    if (this == &other) {
+        return *this;
     }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pQueueFamilyIndices = this->_arena.copy(
+        other._info.pQueueFamilyIndices, other._info.queueFamilyIndexCount);
+
+    return *this;
 }
 
 void Swapchain::CreateInfo::set_surface(const Surface& surface)
@@ -80,18 +90,16 @@ void Swapchain::CreateInfo::set_image_sharing_mode(::VkSharingMode mode)
 void Swapchain::CreateInfo::set_queue_family_indices(
     const Vector<uint32_t>& indices)
 {
-    auto length = indices.length();
-    if (length != 0) {
-        this->_info.queueFamilyIndexCount = length;
-        this->_indices = new uint32_t[length];
-        for (uint64_t i = 0; i < length; ++i) {
-            this->_indices[i] = indices[i];
-        }
-        this->_info.pQueueFamilyIndices = this->_indices;
-    } else {
-        this->_info.queueFamilyIndexCount = 0;
-        this->_info.pQueueFamilyIndices = nullptr;
+    uint32_t count = indices.length();
+
+    // Null for none.
+    uint32_t *p = this->_arena.allocate<uint32_t>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = indices[i];
     }
+
+    this->_info.queueFamilyIndexCount = count;
+    this->_info.pQueueFamilyIndices = p;
 }
 
 void Swapchain::CreateInfo::set_pre_transform(
@@ -117,6 +125,11 @@ void Swapchain::CreateInfo::set_clipped(bool clipped)
     this->_info.clipped = (clipped) ? VK_TRUE : VK_FALSE;
 }
 
+void Swapchain::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
+}
+
 ::VkSwapchainCreateInfoKHR Swapchain::CreateInfo::c_struct() const
 {
     return this->_info;
@@ -132,76 +145,5 @@ Swapchain::Swapchain()
     return *(this->_swapchain);
 }
 
-
-Image::Image()
-{
-    this->_image = nullptr;
-}
-
-::VkImage Image::c_ptr() const
-{
-    return this->_image;
-}
-
-
-ImageView::CreateInfo::CreateInfo()
-{
-    this->_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-
-    this->_info.flags = 0;
-    this->_info.pNext = nullptr;
-}
-
-void ImageView::CreateInfo::set_image(const Image& image)
-{
-    this->_info.image = image.c_ptr();
-}
-
-void ImageView::CreateInfo::set_view_type(::VkImageViewType type)
-{
-    this->_info.viewType = type;
-}
-
-void ImageView::CreateInfo::set_format(::VkFormat format)
-{
-    this->_info.format = format;
-}
-
-void ImageView::CreateInfo::set_components(::VkComponentSwizzle r,
-                                             ::VkComponentSwizzle g,
-                                             ::VkComponentSwizzle b,
-                                             ::VkComponentSwizzle a)
-{
-    this->_info.components.r = r;
-    this->_info.components.g = g;
-    this->_info.components.b = b;
-    this->_info.components.a = a;
-}
-
-void ImageView::CreateInfo::set_subresource_range(::VkImageSubresourceRange range)
-{
-    this->_info.subresourceRange = range;
-}
-
-::VkImageViewCreateInfo ImageView::CreateInfo::c_struct() const
-{
-    return this->_info;
-}
-
-
-ImageView::ImageView()
-{
-    this->_view = nullptr;
-}
-
-ImageView::~ImageView()
-{
-}
-
-::VkImageView ImageView::c_ptr() const
-{
-    return *(this->_view);
-}
-
 } // namespace vk
 } // namespace pr
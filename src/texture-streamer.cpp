@@ -0,0 +1,350 @@
+#include <prime-vulkan/texture-streamer.h>
+
+#include <assert.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+TextureStreamer::CreateInfo::CreateInfo()
+{
+    this->_frame_budget = 16 * 1024 * 1024;
+    this->_memory_budget = 256 * 1024 * 1024;
+    this->_frames_in_flight = 2;
+    this->_tail_extent = 64;
+    this->_final_state = ResourceState::shader_read(
+        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+}
+
+void TextureStreamer::CreateInfo::set_frame_budget(::VkDeviceSize bytes)
+{
+    this->_frame_budget = bytes;
+}
+
+void TextureStreamer::CreateInfo::set_memory_budget(::VkDeviceSize bytes)
+{
+    this->_memory_budget = bytes;
+}
+
+void TextureStreamer::CreateInfo::set_frames_in_flight(uint32_t count)
+{
+    this->_frames_in_flight = count;
+}
+
+void TextureStreamer::CreateInfo::set_tail_extent(uint32_t extent)
+{
+    this->_tail_extent = extent;
+}
+
+void TextureStreamer::CreateInfo::set_final_state(const ResourceState& state)
+{
+    this->_final_state = state;
+}
+
+
+TextureStreamer::TextureStreamer(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    const CreateInfo& info)
+    : _device(device),
+      _memory_properties(memory_properties),
+      _info(info)
+{
+    this->_resident_memory = 0;
+    this->_frame = 0;
+
+    for (uint32_t i = 0; i < info._frames_in_flight; ++i) {
+        this->_uploaders.push_back(std::make_unique<StagingUploader>(
+            device, memory_properties, info._frame_budget));
+    }
+}
+
+auto TextureStreamer::add_texture(::VkFormat format,
+                                  ::VkExtent2D extent,
+                                  uint32_t mip_levels,
+                                  uint32_t texel_size,
+                                  MipSource source) -> TextureId
+{
+    Texture texture;
+    texture.format = format;
+    texture.extent = extent;
+    texture.mip_levels = mip_levels;
+    texture.texel_size = texel_size;
+    texture.source = source;
+    texture.memory_size = 0;
+    texture.resident_level = mip_levels;
+    texture.last_use = -1;
+
+    if (this->level_size(texture, 0) > this->_info._frame_budget) {
+        throw std::length_error("Mip level larger than the frame budget.");
+    }
+
+    this->_textures.push_back(std::move(texture));
+
+    return this->_textures.size() - 1;
+}
+
+void TextureStreamer::request(TextureId texture)
+{
+    this->_textures[texture].last_use = this->_frame;
+}
+
+void TextureStreamer::update(CommandBuffer& command_buffer,
+                             ResourceStateTracker& tracker,
+                             uint32_t frame_index)
+{
+    auto& uploader = *this->_uploaders[frame_index % this->_uploaders.size()];
+    uploader.reset();
+
+    this->evict_down_to(this->_info._memory_budget, tracker);
+
+    std::vector<TextureId> candidates;
+    for (TextureId id = 0; id < this->_textures.size(); ++id) {
+        auto& texture = this->_textures[id];
+        if (texture.last_use == this->_frame && texture.resident_level > 0) {
+            candidates.push_back(id);
+        }
+    }
+
+    ::VkDeviceSize budget = this->_info._frame_budget;
+    bool uploaded = false;
+    while (!candidates.empty()) {
+        // The smallest upload first, so coarse levels of every texture
+        // come before fine levels of any.
+        uint32_t best = 0;
+        ::VkDeviceSize best_size = 0;
+        uint32_t best_first = 0;
+        for (uint32_t i = 0; i < candidates.size(); ++i) {
+            auto& texture = this->_textures[candidates[i]];
+            uint32_t first = (texture.resident_level == texture.mip_levels)
+                ? this->tail_level(texture)
+                : texture.resident_level - 1;
+            ::VkDeviceSize size = 0;
+            for (uint32_t level = first; level < texture.resident_level;
+                    ++level) {
+                size += this->level_size(texture, level);
+            }
+            if (i == 0 || size < best_size) {
+                best = i;
+                best_size = size;
+                best_first = first;
+            }
+        }
+
+        TextureId id = candidates[best];
+        auto& texture = this->_textures[id];
+        // A single upload may use the whole budget.
+        if (uploaded && best_size > budget) {
+            break;
+        }
+        if (!texture.image && !this->make_resident(id, tracker)) {
+            candidates.erase(candidates.begin() + best);
+            continue;
+        }
+
+        bool staged = true;
+        for (uint32_t level = best_first; level < texture.resident_level;
+                ++level) {
+            ::VkExtent3D extent;
+            extent.width = std::max(texture.extent.width >> level, 1u);
+            extent.height = std::max(texture.extent.height >> level, 1u);
+            extent.depth = 1;
+
+            BufferImageCopy region;
+            region.set_image_subresource(VK_IMAGE_ASPECT_COLOR_BIT,
+                level, 0, 1);
+            region.set_image_extent(extent);
+
+            staged = uploader.upload_image(texture.image.ref(),
+                texture.source(level), this->level_size(texture, level),
+                texture.texel_size, { region }, this->_info._final_state);
+            if (!staged) {
+                break;
+            }
+        }
+        // The tail fits in the frame budget, so this only happens after
+        // other uploads used the staging memory.
+        if (!staged) {
+            break;
+        }
+
+        texture.resident_level = best_first;
+        budget -= std::min(budget, best_size);
+        uploaded = true;
+
+        if (texture.resident_level == 0) {
+            candidates.erase(candidates.begin() + best);
+        }
+        if (budget == 0) {
+            break;
+        }
+    }
+
+    uploader.record(command_buffer, tracker);
+
+    ++this->_frame;
+}
+
+ImageRef TextureStreamer::image(TextureId texture) const
+{
+    auto& t = this->_textures[texture];
+
+    return (t.resident_level < t.mip_levels) ? t.image.ref() : ImageRef();
+}
+
+ImageViewRef TextureStreamer::image_view(TextureId texture) const
+{
+    auto& t = this->_textures[texture];
+
+    return (t.resident_level < t.mip_levels) ? t.view.ref() : ImageViewRef();
+}
+
+uint32_t TextureStreamer::resident_level(TextureId texture) const
+{
+    return this->_textures[texture].resident_level;
+}
+
+::VkDeviceSize TextureStreamer::resident_memory() const
+{
+    return this->_resident_memory;
+}
+
+void TextureStreamer::set_memory_budget(::VkDeviceSize bytes)
+{
+    this->_info._memory_budget = bytes;
+}
+
+uint64_t TextureStreamer::frame() const
+{
+    return this->_frame;
+}
+
+uint32_t TextureStreamer::tail_level(const Texture& texture) const
+{
+    uint32_t level = 0;
+    while (level + 1 < texture.mip_levels &&
+           std::max(texture.extent.width >> level,
+                    texture.extent.height >> level) >
+           this->_info._tail_extent) {
+        ++level;
+    }
+
+    return level;
+}
+
+::VkDeviceSize TextureStreamer::level_size(const Texture& texture,
+                                           uint32_t level) const
+{
+    ::VkDeviceSize width = std::max(texture.extent.width >> level, 1u);
+    ::VkDeviceSize height = std::max(texture.extent.height >> level, 1u);
+
+    return width * height * texture.texel_size;
+}
+
+bool TextureStreamer::make_resident(TextureId id,
+                                    ResourceStateTracker& tracker)
+{
+    auto& texture = this->_textures[id];
+    assert(!texture.image);
+
+    Image::CreateInfo image_info;
+    image_info.set_format(texture.format);
+    image_info.set_extent(::VkExtent3D {
+        texture.extent.width, texture.extent.height, 1 });
+    image_info.set_mip_levels(texture.mip_levels);
+    image_info.set_usage(VK_IMAGE_USAGE_SAMPLED_BIT |
+        VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    auto image = this->_device.create_unique_image(image_info);
+
+    auto requirements = this->_device.memory_requirements_for(image.ref());
+    ::VkDeviceSize size = requirements.size();
+    if (size > this->_info._memory_budget) {
+        return false;
+    }
+
+    // Before evicting, which cannot be undone.
+    int32_t type_index = this->_memory_properties.find_memory_type(
+        requirements.memory_type_bits(), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (type_index < 0) {
+        type_index = this->_memory_properties.find_memory_type(
+            requirements.memory_type_bits(), 0);
+    }
+    if (type_index < 0) {
+        throw VulkanError(VK_ERROR_FEATURE_NOT_PRESENT);
+    }
+
+    if (!this->evict_down_to(this->_info._memory_budget - size, tracker)) {
+        return false;
+    }
+
+    MemoryAllocateInfo allocate_info;
+    allocate_info.set_allocation_size(size);
+    allocate_info.set_memory_type_index(type_index);
+    texture.memory = this->_device.allocate_unique_memory(allocate_info);
+    this->_device.bind_image_memory(image.ref(), texture.memory.ref(), 0);
+    texture.image = std::move(image);
+    texture.memory_size = size;
+
+    ::VkImageSubresourceRange range;
+    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.baseMipLevel = 0;
+    range.levelCount = texture.mip_levels;
+    range.baseArrayLayer = 0;
+    range.layerCount = 1;
+
+    ImageView::CreateInfo view_info;
+    view_info.set_image(texture.image.ref());
+    view_info.set_view_type(VK_IMAGE_VIEW_TYPE_2D);
+    view_info.set_format(texture.format);
+    view_info.set_components(VK_COMPONENT_SWIZZLE_IDENTITY,
+                             VK_COMPONENT_SWIZZLE_IDENTITY,
+                             VK_COMPONENT_SWIZZLE_IDENTITY,
+                             VK_COMPONENT_SWIZZLE_IDENTITY);
+    view_info.set_subresource_range(range);
+    texture.view = this->_device.create_unique_image_view(view_info);
+
+    this->_resident_memory += size;
+
+    return true;
+}
+
+bool TextureStreamer::evict_down_to(::VkDeviceSize bytes,
+                                    ResourceStateTracker& tracker)
+{
+    int64_t safe_frame = this->_frame - this->_info._frames_in_flight;
+    while (this->_resident_memory > bytes) {
+        Texture *victim = nullptr;
+        for (auto& other: this->_textures) {
+            if (!other.image || other.last_use > safe_frame) {
+                continue;
+            }
+            if (victim == nullptr || other.last_use < victim->last_use) {
+                victim = &other;
+            }
+        }
+        if (victim == nullptr) {
+            return false;
+        }
+        this->evict(*victim, tracker);
+    }
+
+    return true;
+}
+
+void TextureStreamer::evict(Texture& texture, ResourceStateTracker& tracker)
+{
+    tracker.forget(texture.image.ref());
+
+    texture.view.reset();
+    texture.image.reset();
+    texture.memory.reset();
+    this->_resident_memory -= texture.memory_size;
+    texture.memory_size = 0;
+    texture.resident_level = texture.mip_levels;
+}
+
+} // namespace vk
+} // namespace pr
@@ -0,0 +1,183 @@
+#include <prime-vulkan/tracer.h>
+
+#include <atomic>
+#include <chrono>
+
+namespace pr {
+namespace vk {
+
+static std::atomic<Tracer*> current_tracer(nullptr);
+
+// Write `text` as a JSON string.
+static void write_json_string(std::ostream& stream, const char *text)
+{
+    stream << '"';
+    for (const char *c = text; *c != '\0'; ++c) {
+        switch (*c) {
+        case '"':
+            stream << "\\\"";
+            break;
+        case '\\':
+            stream << "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(*c) >= 0x20) {
+                stream << *c;
+            }
+            break;
+        }
+    }
+    stream << '"';
+}
+
+// Write nanoseconds as microseconds with three decimals.
+static void write_microseconds(std::ostream& stream, uint64_t ns)
+{
+    uint64_t fraction = ns % 1000;
+    stream << (ns / 1000) << '.' << (fraction / 100)
+        << (fraction / 10 % 10) << (fraction % 10);
+}
+
+Tracer::Scope::Scope(const char *name)
+{
+    this->_tracer = Tracer::current();
+    this->_name = name;
+    this->_start = (this->_tracer != nullptr) ? Tracer::now() : 0;
+}
+
+Tracer::Scope::~Scope()
+{
+    if (this->_tracer != nullptr) {
+        this->_tracer->add_cpu_span(this->_name, this->_start,
+            Tracer::now());
+    }
+}
+
+
+Tracer::Tracer(size_t capacity)
+{
+    this->_spans.resize((capacity > 0) ? capacity : 1);
+    this->_next = 0;
+    this->_wrapped = false;
+}
+
+Tracer::~Tracer()
+{
+    Tracer *self = this;
+    current_tracer.compare_exchange_strong(self, nullptr);
+}
+
+Tracer* Tracer::current()
+{
+    return current_tracer.load(std::memory_order_acquire);
+}
+
+void Tracer::set_current(Tracer *tracer)
+{
+    current_tracer.store(tracer, std::memory_order_release);
+}
+
+uint64_t Tracer::now()
+{
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time)
+        .count();
+}
+
+void Tracer::add_cpu_span(const char *name, uint64_t start, uint64_t end)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->add(name, start, end, this->thread_track());
+}
+
+void Tracer::add_gpu_span(const char *name, uint64_t start, uint64_t end)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->add(name, start, end, 0);
+}
+
+size_t Tracer::size() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return (this->_wrapped) ? this->_spans.size() : this->_next;
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_next = 0;
+    this->_wrapped = false;
+}
+
+void Tracer::write_chrome_trace(std::ostream& stream) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    // Name the tracks.
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+        "\"args\":{\"name\":\"GPU\"}}";
+    for (size_t i = 0; i < this->_threads.size(); ++i) {
+        stream << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":" << (i + 1) << ",\"args\":{\"name\":\"CPU "
+            << (i + 1) << "\"}}";
+    }
+
+    size_t count = (this->_wrapped) ? this->_spans.size() : this->_next;
+    size_t first = (this->_wrapped) ? this->_next : 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto& span = this->_spans[(first + i) % this->_spans.size()];
+        uint64_t duration = (span.end > span.start)
+            ? span.end - span.start
+            : 0;
+
+        stream << ",{\"name\":";
+        write_json_string(stream, span.name);
+        stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.track
+            << ",\"ts\":";
+        write_microseconds(stream, span.start);
+        stream << ",\"dur\":";
+        write_microseconds(stream, duration);
+        stream << '}';
+    }
+
+    stream << "]}\n";
+}
+
+void Tracer::add(const char *name, uint64_t start, uint64_t end,
+                 uint32_t track)
+{
+    auto& span = this->_spans[this->_next];
+    span.name = name;
+    span.start = start;
+    span.end = end;
+    span.track = track;
+
+    this->_next += 1;
+    if (this->_next == this->_spans.size()) {
+        this->_next = 0;
+        this->_wrapped = true;
+    }
+}
+
+uint32_t Tracer::thread_track()
+{
+    auto id = std::this_thread::get_id();
+    for (size_t i = 0; i < this->_threads.size(); ++i) {
+        if (this->_threads[i] == id) {
+            return i + 1;
+        }
+    }
+    this->_threads.push_back(id);
+
+    return this->_threads.size();
+}
+
+} // namespace vk
+} // namespace pr
@@ -0,0 +1,530 @@
+#include <prime-vulkan/upload-engine.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <prime-vulkan/base.h>
+
+namespace pr {
+namespace vk {
+
+// Add the mip levels and layers `regions` write to `ranges`, one range
+// per mip level.
+static void add_ranges(std::vector<::VkImageSubresourceRange>& ranges,
+    const pr::Vector<BufferImageCopy>& regions,
+    ::VkImageAspectFlags aspect_mask)
+{
+    for (auto& region: regions) {
+        auto layers = region.c_struct().imageSubresource;
+
+        ::VkImageSubresourceRange *range = nullptr;
+        for (auto& added: ranges) {
+            if (added.baseMipLevel == layers.mipLevel) {
+                range = &added;
+                break;
+            }
+        }
+        if (range == nullptr) {
+            ranges.push_back(::VkImageSubresourceRange {
+                aspect_mask, layers.mipLevel, 1,
+                layers.baseArrayLayer, layers.layerCount });
+            continue;
+        }
+
+        uint32_t end = std::max(range->baseArrayLayer + range->layerCount,
+            layers.baseArrayLayer + layers.layerCount);
+        range->baseArrayLayer = std::min(range->baseArrayLayer,
+            layers.baseArrayLayer);
+        range->layerCount = end - range->baseArrayLayer;
+    }
+}
+
+static ::VkImageMemoryBarrier image_barrier(ImageRef image,
+    const ::VkImageSubresourceRange& range,
+    ::VkAccessFlags src_access,
+    ::VkAccessFlags dst_access,
+    ::VkImageLayout old_layout,
+    ::VkImageLayout new_layout,
+    uint32_t src_family,
+    uint32_t dst_family)
+{
+    ::VkImageMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    barrier.oldLayout = old_layout;
+    barrier.newLayout = new_layout;
+    barrier.srcQueueFamilyIndex = src_family;
+    barrier.dstQueueFamilyIndex = dst_family;
+    barrier.image = image.c_ptr();
+    barrier.subresourceRange = range;
+
+    return barrier;
+}
+
+static ::VkBufferMemoryBarrier buffer_barrier(BufferRef buffer,
+    ::VkAccessFlags src_access,
+    ::VkAccessFlags dst_access,
+    uint32_t src_family,
+    uint32_t dst_family)
+{
+    ::VkBufferMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    barrier.srcQueueFamilyIndex = src_family;
+    barrier.dstQueueFamilyIndex = dst_family;
+    barrier.buffer = buffer.c_ptr();
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    return barrier;
+}
+
+// Whether the graphics family must release the destination before the
+// upload. The other regions of buffers are kept, and so are images that
+// are not in the undefined layout.
+static bool keeps_contents(const ImageRef& image,
+                           ::VkImageLayout old_layout)
+{
+    return !image || old_layout != VK_IMAGE_LAYOUT_UNDEFINED;
+}
+
+UploadEngine::CreateInfo::CreateInfo()
+{
+    this->_staging_size = 32 * 1024 * 1024;
+    this->_batches_in_flight = 2;
+}
+
+void UploadEngine::CreateInfo::set_staging_size(::VkDeviceSize size)
+{
+    this->_staging_size = size;
+}
+
+void UploadEngine::CreateInfo::set_batches_in_flight(uint32_t count)
+{
+    this->_batches_in_flight = count;
+}
+
+
+UploadEngine::UploadEngine(const Device& device,
+    const PhysicalDevice::MemoryProperties& memory_properties,
+    const QueueTopology& topology,
+    const CreateInfo& info)
+    : _device(device),
+      _transfer_family(topology.transfer_family()),
+      _graphics_family(topology.graphics_family()),
+      _queue(device.queue_for(topology.transfer_family(), 0))
+{
+    this->_current = 0;
+    this->_ready = false;
+    this->_submitted = -1;
+    this->_unacquired = false;
+    this->_wait_stages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+    CommandPool::CreateInfo pool_info;
+    pool_info.set_queue_family_index(this->_transfer_family);
+    pool_info.set_flags(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    this->_command_pool = this->_device.create_unique_command_pool(pool_info);
+
+    CommandBuffer::AllocateInfo allocate_info;
+    allocate_info.set_command_pool(this->_command_pool.ref());
+    allocate_info.set_level(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    allocate_info.set_command_buffer_count(1);
+
+    Fence::CreateInfo fence_info;
+    fence_info.set_flags(VK_FENCE_CREATE_SIGNALED_BIT);
+    Semaphore::CreateInfo semaphore_info;
+
+    for (uint32_t i = 0; i < info._batches_in_flight; ++i) {
+        Batch batch;
+        batch.uploader = std::make_unique<StagingUploader>(device,
+            memory_properties, info._staging_size);
+        batch.fence = this->_device.create_unique_fence(fence_info);
+        batch.semaphore = this->_device.create_unique_semaphore(
+            semaphore_info);
+        batch.release_semaphore = this->_device.create_unique_semaphore(
+            semaphore_info);
+        batch.released = false;
+        batch.wait_release = false;
+        this->_batches.push_back(std::move(batch));
+
+        this->_command_buffers.push_back(
+            this->_device.allocate_command_buffers(allocate_info));
+    }
+}
+
+UploadEngine::~UploadEngine()
+{
+    try {
+        this->wait_idle();
+    } catch (const VulkanError&) {
+        // Nothing left to do on a lost device.
+    }
+}
+
+bool UploadEngine::upload_image(ImageRef image,
+    const void *data,
+    ::VkDeviceSize size,
+    uint32_t texel_size,
+    const pr::Vector<BufferImageCopy>& regions,
+    const ResourceState& final_state,
+    ::VkImageAspectFlags aspect_mask)
+{
+    auto& batch = this->staging_batch();
+    if (!batch.uploader->upload_image(image, data, size, texel_size, regions,
+            final_state, aspect_mask)) {
+        return false;
+    }
+
+    Destination *destination = nullptr;
+    for (auto& pending: batch.destinations) {
+        if (pending.image.c_ptr() == image.c_ptr()) {
+            destination = &pending;
+            break;
+        }
+    }
+    if (destination == nullptr) {
+        batch.destinations.push_back(Destination());
+        destination = &batch.destinations.back();
+        destination->image = image;
+        destination->aspect_mask = aspect_mask;
+        destination->old_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+    destination->final_state = final_state;
+    add_ranges(destination->ranges, regions, aspect_mask);
+
+    return true;
+}
+
+bool UploadEngine::upload_buffer(BufferRef buffer,
+    ::VkDeviceSize offset,
+    const void *data,
+    ::VkDeviceSize size,
+    const ResourceState& final_state)
+{
+    auto& batch = this->staging_batch();
+    if (!batch.uploader->upload_buffer(buffer, offset, data, size,
+            final_state)) {
+        return false;
+    }
+
+    for (auto& destination: batch.destinations) {
+        if (destination.buffer.c_ptr() == buffer.c_ptr()) {
+            destination.final_state = final_state;
+            return true;
+        }
+    }
+
+    Destination destination;
+    destination.buffer = buffer;
+    destination.final_state = final_state;
+    destination.aspect_mask = 0;
+    destination.old_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    batch.destinations.push_back(destination);
+
+    return true;
+}
+
+bool UploadEngine::release(CommandBuffer& command_buffer,
+                           ResourceStateTracker& tracker)
+{
+    if (!this->_ready || this->_batches[this->_current].uploader->empty()) {
+        return false;
+    }
+
+    auto& batch = this->_batches[this->_current];
+    if (batch.released) {
+        throw std::logic_error("The upload batch was already released.");
+    }
+
+    bool dedicated = this->_transfer_family != this->_graphics_family;
+    uint32_t src_family = dedicated
+        ? this->_graphics_family
+        : VK_QUEUE_FAMILY_IGNORED;
+    uint32_t dst_family = dedicated
+        ? this->_transfer_family
+        : VK_QUEUE_FAMILY_IGNORED;
+    // A release only makes the writes available. In place, one barrier
+    // also makes them visible to the copies.
+    ::VkAccessFlags dst_access = dedicated ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    ::VkPipelineStageFlags src_stages = 0;
+    pr::Vector<::VkImageMemoryBarrier> image_barriers;
+    pr::Vector<::VkBufferMemoryBarrier> buffer_barriers;
+    for (auto& destination: batch.destinations) {
+        ResourceState state = destination.image
+            ? tracker.image_state(destination.image)
+            : tracker.buffer_state(destination.buffer);
+        if (destination.image) {
+            destination.old_layout = state.layout();
+            tracker.set_image_state(destination.image,
+                ResourceState::transfer_write(), destination.aspect_mask);
+        } else {
+            tracker.set_buffer_state(destination.buffer,
+                ResourceState::transfer_write());
+        }
+        // Acquired from the undefined layout by `submit`.
+        if (dedicated &&
+                !keeps_contents(destination.image, destination.old_layout)) {
+            continue;
+        }
+
+        src_stages |= ResourceState::legacy_stages(state.stages(),
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+        ::VkAccessFlags src_access = ResourceState::legacy_access(
+            ResourceState::write_access(state.access()));
+        if (destination.image) {
+            for (auto& range: destination.ranges) {
+                image_barriers.push(image_barrier(destination.image, range,
+                    src_access, dst_access, destination.old_layout,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    src_family, dst_family));
+            }
+        } else {
+            buffer_barriers.push(buffer_barrier(destination.buffer,
+                src_access, dst_access, src_family, dst_family));
+        }
+    }
+
+    bool recorded = image_barriers.length() > 0 ||
+        buffer_barriers.length() > 0;
+    if (recorded) {
+        command_buffer.pipeline_barrier(src_stages, dedicated
+                ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+                : VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, {}, buffer_barriers, image_barriers);
+    }
+    batch.released = true;
+    batch.wait_release = dedicated && recorded;
+
+    return batch.wait_release;
+}
+
+SemaphoreRef UploadEngine::release_semaphore() const
+{
+    return this->_batches[this->_current].release_semaphore.ref();
+}
+
+bool UploadEngine::submit()
+{
+    if (!this->_ready || this->_batches[this->_current].uploader->empty()) {
+        return false;
+    }
+    if (!this->_batches[this->_current].released) {
+        throw std::logic_error("The upload batch was not released.");
+    }
+    if (this->_unacquired) {
+        throw std::logic_error("The previous upload batch was not acquired.");
+    }
+
+    auto& batch = this->_batches[this->_current];
+    auto& command_buffer = this->_command_buffers[this->_current];
+
+    CommandBuffer::BeginInfo begin_info;
+    begin_info.set_flags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    command_buffer.reset(0);
+    command_buffer.begin(begin_info);
+
+    // Acquire what the graphics family released, and discard the old
+    // contents of the rest. In place, `release` did both.
+    pr::Vector<::VkImageMemoryBarrier> image_barriers;
+    pr::Vector<::VkBufferMemoryBarrier> buffer_barriers;
+    if (this->_transfer_family != this->_graphics_family) {
+        for (auto& destination: batch.destinations) {
+            bool kept = keeps_contents(destination.image,
+                destination.old_layout);
+            uint32_t src_family = kept
+                ? this->_graphics_family
+                : VK_QUEUE_FAMILY_IGNORED;
+            uint32_t dst_family = kept
+                ? this->_transfer_family
+                : VK_QUEUE_FAMILY_IGNORED;
+
+            if (destination.image) {
+                for (auto& range: destination.ranges) {
+                    image_barriers.push(image_barrier(destination.image,
+                        range, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                        destination.old_layout,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        src_family, dst_family));
+                }
+            } else {
+                buffer_barriers.push(buffer_barrier(destination.buffer,
+                    0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                    src_family, dst_family));
+            }
+        }
+    }
+    // Chained to the release semaphore wait, and after the copies of the
+    // earlier batches.
+    if (image_barriers.length() > 0 || buffer_barriers.length() > 0) {
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {},
+            buffer_barriers, image_barriers);
+    }
+
+    batch.uploader->record_copies(command_buffer);
+
+    this->_wait_stages = 0;
+    for (auto& destination: batch.destinations) {
+        this->_wait_stages |= ResourceState::legacy_stages(
+            destination.final_state.stages(),
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    }
+
+    // Release to the graphics family, or transition in place when there
+    // is no dedicated transfer family.
+    pr::Vector<::VkImageMemoryBarrier> final_images;
+    pr::Vector<::VkBufferMemoryBarrier> final_buffers;
+    if (this->_transfer_family != this->_graphics_family) {
+        this->final_barriers(batch, this->_transfer_family,
+            this->_graphics_family, true, final_images, final_buffers);
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, {},
+            final_buffers, final_images);
+    } else {
+        this->final_barriers(batch, VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED, false, final_images, final_buffers);
+        command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+            this->_wait_stages, 0, {}, final_buffers, final_images);
+    }
+
+    command_buffer.end();
+
+    this->_device.reset_fences({ batch.fence.ref() });
+
+    SubmitInfo submit;
+    if (batch.wait_release) {
+        submit.set_wait_semaphores({ batch.release_semaphore.ref() });
+        submit.set_wait_dst_stage_mask({ VK_PIPELINE_STAGE_TRANSFER_BIT });
+    }
+    submit.set_command_buffers({ CommandBufferRef(command_buffer) });
+    submit.set_signal_semaphores({ batch.semaphore.ref() });
+    this->_queue.submit({ submit }, batch.fence.ref());
+    batch.released = false;
+    batch.wait_release = false;
+
+    this->_submitted = this->_current;
+    this->_unacquired = true;
+    this->_current = (this->_current + 1) % this->_batches.size();
+    this->_ready = false;
+
+    return true;
+}
+
+bool UploadEngine::acquire(CommandBuffer& command_buffer,
+                           ResourceStateTracker& tracker)
+{
+    if (!this->_unacquired) {
+        return false;
+    }
+
+    auto& batch = this->_batches[this->_submitted];
+
+    if (this->_transfer_family != this->_graphics_family) {
+        pr::Vector<::VkImageMemoryBarrier> image_barriers;
+        pr::Vector<::VkBufferMemoryBarrier> buffer_barriers;
+        this->final_barriers(batch, this->_transfer_family,
+            this->_graphics_family, false, image_barriers, buffer_barriers);
+        // Chained to the semaphore wait, which uses the same stages.
+        command_buffer.pipeline_barrier(this->_wait_stages,
+            this->_wait_stages, 0, {}, buffer_barriers, image_barriers);
+    }
+
+    for (auto& destination: batch.destinations) {
+        if (destination.image) {
+            tracker.set_image_state(destination.image,
+                destination.final_state, destination.aspect_mask);
+        } else {
+            tracker.set_buffer_state(destination.buffer,
+                destination.final_state);
+        }
+    }
+    batch.destinations.clear();
+    this->_unacquired = false;
+
+    return true;
+}
+
+SemaphoreRef UploadEngine::semaphore() const
+{
+    if (this->_submitted < 0) {
+        return SemaphoreRef();
+    }
+
+    return this->_batches[this->_submitted].semaphore.ref();
+}
+
+::VkPipelineStageFlags UploadEngine::wait_stages() const
+{
+    return this->_wait_stages;
+}
+
+Queue& UploadEngine::queue()
+{
+    return this->_queue;
+}
+
+void UploadEngine::wait_idle()
+{
+    for (auto& batch: this->_batches) {
+        this->_device.wait_for_fences({ batch.fence.ref() }, true,
+            UINT64_MAX);
+    }
+}
+
+auto UploadEngine::staging_batch() -> Batch&
+{
+    auto& batch = this->_batches[this->_current];
+    if (!this->_ready) {
+        this->_device.wait_for_fences({ batch.fence.ref() }, true,
+            UINT64_MAX);
+        batch.uploader->reset();
+        this->_ready = true;
+    }
+    if (batch.released) {
+        throw std::logic_error("The upload batch was already released.");
+    }
+
+    return batch;
+}
+
+void UploadEngine::final_barriers(const Batch& batch,
+    uint32_t src_family,
+    uint32_t dst_family,
+    bool release,
+    pr::Vector<::VkImageMemoryBarrier>& image_barriers,
+    pr::Vector<::VkBufferMemoryBarrier>& buffer_barriers) const
+{
+    bool same_queue = src_family == dst_family;
+
+    for (auto& destination: batch.destinations) {
+        // A release makes the writes available; an acquire makes them
+        // visible. In place, one barrier does both.
+        ::VkAccessFlags src_access = (release || same_queue)
+            ? VK_ACCESS_TRANSFER_WRITE_BIT
+            : 0;
+        ::VkAccessFlags dst_access = (!release || same_queue)
+            ? ResourceState::legacy_access(destination.final_state.access())
+            : 0;
+
+        if (destination.image) {
+            for (auto& range: destination.ranges) {
+                image_barriers.push(image_barrier(destination.image, range,
+                    src_access, dst_access,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    destination.final_state.layout(),
+                    src_family, dst_family));
+            }
+        } else {
+            buffer_barriers.push(buffer_barrier(destination.buffer,
+                src_access, dst_access, src_family, dst_family));
+        }
+    }
+}
+
+} // namespace vk
+} // namespace pr
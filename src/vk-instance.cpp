@@ -69,27 +69,59 @@ Instance::CreateInfo::CreateInfo()
     this->_info.flags = 0;
 }
 
-Instance::CreateInfo::~CreateInfo()
+Instance::CreateInfo::CreateInfo(const CreateInfo& other)
 {
-    if (this->_pp_enabled_extension_names != nullptr) {
-        delete[] this->_pp_enabled_extension_names;
+    *this = other;
+}
+
+auto Instance::CreateInfo::operator=(const CreateInfo& other) -> CreateInfo&
+{
+    if (this == &other) {
+        return *this;
     }
+    this->_arena.clear();
+
+    this->_info = other._info;
+    this->_info.pApplicationInfo = this->_arena.copy(
+        other._info.pApplicationInfo, 1);
+    this->_info.ppEnabledExtensionNames = this->_arena.copy_strings(
+        other._info.ppEnabledExtensionNames,
+        other._info.enabledExtensionCount);
+
+    return *this;
+}
+
+void Instance::CreateInfo::set_api_version(uint32_t version)
+{
+    auto *p = this->_arena.allocate<::VkApplicationInfo>(1);
+    p->sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    p->pNext = nullptr;
+    p->pApplicationName = nullptr;
+    p->applicationVersion = 0;
+    p->pEngineName = nullptr;
+    p->engineVersion = 0;
+    p->apiVersion = version;
+
+    this->_info.pApplicationInfo = p;
 }
 
 void Instance::CreateInfo::set_enabled_extension_names(
     const pr::Vector<pr::String>& names)
 {
-    this->_enabled_extension_names = names;
-
-    this->_info.enabledExtensionCount = names.length();
+    uint32_t count = names.length();
 
-    // Make compatible.
-    this->_pp_enabled_extension_names = new const char*[names.length()];
-    for (uint64_t i = 0; i < names.length(); ++i) {
-        this->_pp_enabled_extension_names[i] =
-            this->_enabled_extension_names[i].c_str();
+    const char **p = this->_arena.allocate<const char*>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        p[i] = this->_arena.copy_string(names[i].c_str());
     }
-    this->_info.ppEnabledExtensionNames = this->_pp_enabled_extension_names;
+
+    this->_info.enabledExtensionCount = count;
+    this->_info.ppEnabledExtensionNames = p;
+}
+
+void Instance::CreateInfo::set_next(const void *next)
+{
+    this->_info.pNext = next;
 }
 
 struct VkInstanceDeleter
@@ -114,6 +146,12 @@ Instance::Instance(const Instance::CreateInfo& info)
     } else {
         throw VulkanError(result);
     }
+
+    auto application_info = info._info.pApplicationInfo;
+    this->_api_version = (application_info != nullptr &&
+            application_info->apiVersion != 0)
+        ? application_info->apiVersion
+        : VK_API_VERSION_1_0;
 }
 
 Instance::~Instance()
@@ -142,6 +180,11 @@ Surface Instance::create_wayland_surface(
     return surface;
 }
 
+uint32_t Instance::api_version() const
+{
+    return this->_api_version;
+}
+
 ::VkInstance Instance::c_ptr()
 {
     return *(this->_instance);
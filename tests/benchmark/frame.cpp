@@ -0,0 +1,656 @@
+// Frame loop throughput, without a window.
+//
+// The rectangle of tests/vertex drawn `--draws` times a frame into an
+// `OffscreenTarget`, with `--frames-in-flight` frames queued as a swapchain
+// loop would have them, recorded on `--threads` threads.
+//
+//     ./frame --frames 1000 --draws 1000 --frames-in-flight 2 --threads 4
+//
+// Prints frames per second, the CPU time spent recording and submitting a
+// frame, and the heap and device memory allocations per frame. Run it
+// before and after a change to the library, on the same driver.
+
+#include <prime-vulkan/vulkan.h>
+
+// C
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// C++
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "headless.h"
+
+static float vertices[] = {
+    -0.5f, -0.5f,   1.0f, 0.0f, 0.0f,
+     0.5f, -0.5f,   0.0f, 1.0f, 0.0f,
+     0.5f,  0.5f,   0.0f, 0.0f, 1.0f,
+    -0.5f,  0.5f,   1.0f, 1.0f, 1.0f,
+};
+
+static uint16_t indices[] = {
+    0, 1, 2, 2, 3, 0,
+};
+
+//=====================
+// Allocation counting
+//=====================
+
+// Every `new`, in the library, Primer and here. `new[]` and the sized
+// `delete` go through these.
+static std::atomic<uint64_t> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void *p = malloc((size > 0) ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+//=================
+// Options
+//=================
+
+struct Options
+{
+    uint32_t frames = 1000;
+    /// Frames run before measuring, to fill the pools and caches.
+    uint32_t warmup = 10;
+    uint32_t draws = 100;
+    uint32_t frames_in_flight = 2;
+    uint32_t threads = 1;
+    uint32_t width = 256;
+    uint32_t height = 256;
+};
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--draws N]"
+        " [--frames-in-flight N] [--threads N] [--width N]"
+        " [--height N]\n", program);
+    exit(1);
+}
+
+static Options parse_options(int argc, char *argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+        uint32_t value = strtoul(argv[i + 1], nullptr, 10);
+
+        if (strcmp(argv[i], "--frames") == 0) {
+            options.frames = value;
+        } else if (strcmp(argv[i], "--warmup") == 0) {
+            options.warmup = value;
+        } else if (strcmp(argv[i], "--draws") == 0) {
+            options.draws = value;
+        } else if (strcmp(argv[i], "--frames-in-flight") == 0) {
+            options.frames_in_flight = value;
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            options.threads = value;
+        } else if (strcmp(argv[i], "--width") == 0) {
+            options.width = value;
+        } else if (strcmp(argv[i], "--height") == 0) {
+            options.height = value;
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    if (options.frames == 0 || options.frames_in_flight == 0 ||
+            options.threads == 0 || options.width == 0 ||
+            options.height == 0) {
+        usage(argv[0]);
+    }
+
+    return options;
+}
+
+//=================
+// Recorders
+//=================
+
+/// Threads recording one slice of the frame each. The calling thread
+/// records the first slice.
+class Recorders
+{
+public:
+    using Job = std::function<void(uint32_t slice)>;
+
+public:
+    Recorders(uint32_t count, Job job)
+        : _job(job),
+          _generation(0),
+          _pending(0),
+          _quit(false)
+    {
+        for (uint32_t slice = 1; slice < count; ++slice) {
+            this->_threads.emplace_back(&Recorders::work, this, slice);
+        }
+    }
+
+    ~Recorders()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_quit = true;
+        }
+        this->_start.notify_all();
+
+        for (auto& thread: this->_threads) {
+            thread.join();
+        }
+    }
+
+    /// Run the job for every slice and wait for all of them.
+    void run()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_generation += 1;
+            this->_pending = this->_threads.size();
+        }
+        this->_start.notify_all();
+
+        this->_job(0);
+
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_done.wait(lock, [this]() { return this->_pending == 0; });
+    }
+
+private:
+    void work(uint32_t slice)
+    {
+        uint64_t generation = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(this->_mutex);
+                this->_start.wait(lock, [&]() {
+                    return this->_quit || this->_generation != generation;
+                });
+                if (this->_quit) {
+                    return;
+                }
+                generation = this->_generation;
+            }
+
+            this->_job(slice);
+
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_pending -= 1;
+            if (this->_pending == 0) {
+                this->_done.notify_one();
+            }
+        }
+    }
+
+private:
+    Job _job;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    uint64_t _generation;
+    size_t _pending;
+    bool _quit;
+};
+
+//=================
+// Scene
+//=================
+
+static std::vector<uint32_t> load_shader(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == nullptr) {
+        fprintf(stderr, "Failed to open %s. Run `make shaders`.\n", path);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    std::vector<uint32_t> code(size / sizeof(uint32_t));
+    fread(code.data(), sizeof(uint32_t), code.size(), f);
+    fclose(f);
+
+    return code;
+}
+
+/// The first slice of a frame clears the image, the others draw over it.
+/// Both passes are compatible, so they share the pipeline and the
+/// framebuffers.
+static pr::vk::UniqueRenderPass create_render_pass(pr::vk::Device& device,
+                                                  ::VkFormat format,
+                                                  bool clear)
+{
+    pr::vk::AttachmentDescription attachment;
+    attachment.set_format(format);
+    attachment.set_samples(VK_SAMPLE_COUNT_1_BIT);
+    attachment.set_load_op((clear)
+        ? VK_ATTACHMENT_LOAD_OP_CLEAR
+        : VK_ATTACHMENT_LOAD_OP_LOAD);
+    attachment.set_store_op(VK_ATTACHMENT_STORE_OP_STORE);
+    attachment.set_stencil_load_op(VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+    attachment.set_stencil_store_op(VK_ATTACHMENT_STORE_OP_DONT_CARE);
+    attachment.set_initial_layout((clear)
+        ? VK_IMAGE_LAYOUT_UNDEFINED
+        : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    attachment.set_final_layout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+    pr::vk::SubpassDescription subpass;
+    subpass.set_pipeline_bind_point(VK_PIPELINE_BIND_POINT_GRAPHICS);
+    subpass.set_color_attachments({
+        pr::vk::AttachmentReference(0,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL),
+    });
+
+    // Also orders the slices of a frame after each other.
+    pr::vk::SubpassDependency dependency;
+    dependency.set_subpass_src_dst(VK_SUBPASS_EXTERNAL, 0);
+    dependency.set_stage_mask_src_dst(
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    dependency.set_access_mask_src_dst(
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+    pr::vk::RenderPass::CreateInfo info;
+    info.set_attachments({ attachment });
+    info.set_subpasses({ subpass });
+    info.set_dependencies({ dependency });
+
+    return device.create_unique_render_pass(info);
+}
+
+static pr::vk::UniquePipeline create_pipeline(pr::vk::Device& device,
+    pr::vk::RenderPassRef render_pass,
+    pr::vk::PipelineLayoutRef layout)
+{
+    auto vert_code = load_shader("vert.spv");
+    auto frag_code = load_shader("frag.spv");
+
+    pr::vk::ShaderModule::CreateInfo vert_info;
+    vert_info.set_code(vert_code.data(),
+        vert_code.size() * sizeof(uint32_t));
+    auto vert_module = device.create_shader_module(vert_info);
+
+    pr::vk::ShaderModule::CreateInfo frag_info;
+    frag_info.set_code(frag_code.data(),
+        frag_code.size() * sizeof(uint32_t));
+    auto frag_module = device.create_shader_module(frag_info);
+
+    pr::vk::Pipeline::ShaderStageCreateInfo vert_stage;
+    vert_stage.set_stage(VK_SHADER_STAGE_VERTEX_BIT);
+    vert_stage.set_module(vert_module);
+    vert_stage.set_name("main"_S);
+
+    pr::vk::Pipeline::ShaderStageCreateInfo frag_stage;
+    frag_stage.set_stage(VK_SHADER_STAGE_FRAGMENT_BIT);
+    frag_stage.set_module(frag_module);
+    frag_stage.set_name("main"_S);
+
+    pr::vk::VertexInputBindingDescription binding;
+    binding.set_binding(0);
+    binding.set_stride(4 * 5);
+    binding.set_input_rate(VK_VERTEX_INPUT_RATE_VERTEX);
+
+    pr::vk::VertexInputAttributeDescription position;
+    position.set_binding(0);
+    position.set_location(0);
+    position.set_format(VK_FORMAT_R32G32_SFLOAT);
+    position.set_offset(0);
+
+    pr::vk::VertexInputAttributeDescription color;
+    color.set_binding(0);
+    color.set_location(1);
+    color.set_format(VK_FORMAT_R32G32B32_SFLOAT);
+    color.set_offset(8);
+
+    pr::vk::Pipeline::VertexInputStateCreateInfo vertex_input;
+    vertex_input.set_vertex_binding_descriptions({ binding });
+    vertex_input.set_vertex_attribute_descriptions({ position, color });
+
+    pr::vk::Pipeline::InputAssemblyStateCreateInfo input_assembly;
+    input_assembly.set_topology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+    input_assembly.set_primitive_restart_enable(false);
+
+    pr::vk::Pipeline::ViewportStateCreateInfo viewport;
+    viewport.set_viewport_count(1);
+    viewport.set_scissor_count(1);
+
+    pr::vk::Pipeline::RasterizationStateCreateInfo rasterization;
+    rasterization.set_depth_clamp_enable(false);
+    rasterization.set_rasterizer_discard_enable(false);
+    rasterization.set_polygon_mode(VK_POLYGON_MODE_FILL);
+    rasterization.set_line_width(1.0f);
+    rasterization.set_cull_mode(VK_CULL_MODE_NONE);
+    rasterization.set_front_face(VK_FRONT_FACE_CLOCKWISE);
+    rasterization.set_depth_bias_enable(false);
+
+    pr::vk::Pipeline::MultisampleStateCreateInfo multisample;
+    multisample.set_sample_shading_enable(false);
+    multisample.set_rasterization_samples(VK_SAMPLE_COUNT_1_BIT);
+
+    pr::vk::Pipeline::ColorBlendAttachmentState blend_attachment;
+    blend_attachment.set_color_write_mask(
+        VK_COLOR_COMPONENT_R_BIT |
+        VK_COLOR_COMPONENT_G_BIT |
+        VK_COLOR_COMPONENT_B_BIT |
+        VK_COLOR_COMPONENT_A_BIT);
+    blend_attachment.set_blend_enable(false);
+
+    pr::vk::Pipeline::ColorBlendStateCreateInfo color_blend;
+    color_blend.set_logic_op(VK_LOGIC_OP_COPY);
+    color_blend.set_attachments({ blend_attachment });
+    color_blend.set_blend_constants(0.0f, 0.0f, 0.0f, 0.0f);
+
+    pr::vk::Pipeline::DynamicStateCreateInfo dynamic_state;
+    dynamic_state.set_dynamic_states({
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR,
+    });
+
+    pr::vk::GraphicsPipelineCreateInfo info;
+    info.set_stages({ vert_stage, frag_stage });
+    info.set_vertex_input_state(vertex_input);
+    info.set_input_assembly_state(input_assembly);
+    info.set_viewport_state(viewport);
+    info.set_rasterization_state(rasterization);
+    info.set_multisample_state(multisample);
+    info.set_color_blend_state(color_blend);
+    info.set_dynamic_state(dynamic_state);
+    info.set_layout(layout);
+    info.set_render_pass(render_pass);
+    info.set_subpass(0);
+
+    auto pipelines = device.create_unique_graphics_pipelines({ info });
+
+    return std::move(pipelines[0]);
+}
+
+/// What every frame draws with.
+struct Scene
+{
+    pr::vk::UniqueRenderPass clear_pass;
+    pr::vk::UniqueRenderPass load_pass;
+    pr::vk::UniquePipelineLayout layout;
+    pr::vk::UniquePipeline pipeline;
+    pr::vk::UniqueBuffer vertex_buffer;
+    pr::vk::UniqueBuffer index_buffer;
+    /// One for each image of the target.
+    std::vector<pr::vk::UniqueFramebuffer> framebuffers;
+    ::VkExtent2D extent;
+
+    Scene(Headless& headless, pr::vk::OffscreenTarget& target)
+    {
+        auto& device = headless.device();
+
+        this->extent = target.extent();
+        this->clear_pass = create_render_pass(device,
+            target.color_format(), true);
+        this->load_pass = create_render_pass(device,
+            target.color_format(), false);
+
+        pr::vk::PipelineLayout::CreateInfo layout_info;
+        layout_info.set_set_layouts(pr::Vector<::VkDescriptorSetLayout>());
+        layout_info.set_push_constant_range(
+            pr::Vector<::VkPushConstantRange>());
+        this->layout = device.create_unique_pipeline_layout(layout_info);
+
+        this->pipeline = create_pipeline(device, this->clear_pass.ref(),
+            this->layout.ref());
+
+        this->vertex_buffer = headless.create_buffer(sizeof(vertices),
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertices);
+        this->index_buffer = headless.create_buffer(sizeof(indices),
+            VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indices);
+
+        for (uint32_t i = 0; i < target.image_count(); ++i) {
+            pr::vk::Framebuffer::CreateInfo info;
+            info.set_render_pass(this->clear_pass.ref());
+            info.set_attachments({ target.color_view(i) });
+            info.set_width(this->extent.width);
+            info.set_height(this->extent.height);
+            info.set_layers(1);
+            this->framebuffers.push_back(
+                device.create_unique_framebuffer(info));
+        }
+    }
+
+    /// Record `draw_count` draws into the framebuffer of the image.
+    void record(pr::vk::CommandBuffer& command_buffer,
+                uint32_t image_index,
+                bool first_slice,
+                uint32_t draw_count) const
+    {
+        pr::vk::CommandBuffer::BeginInfo begin_info;
+        begin_info.set_flags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+        command_buffer.reset(0);
+        command_buffer.begin(begin_info);
+
+        ::VkRect2D area;
+        area.offset.x = 0;
+        area.offset.y = 0;
+        area.extent = this->extent;
+
+        pr::vk::RenderPass::BeginInfo pass_info;
+        pass_info.set_render_pass((first_slice)
+            ? this->clear_pass.ref()
+            : this->load_pass.ref());
+        pass_info.set_framebuffer(this->framebuffers[image_index].ref());
+        pass_info.set_render_area(area);
+        if (first_slice) {
+            ::VkClearValue clear;
+            clear.color.float32[0] = 0.0f;
+            clear.color.float32[1] = 0.0f;
+            clear.color.float32[2] = 0.0f;
+            clear.color.float32[3] = 1.0f;
+            pass_info.set_clear_values({ clear });
+        }
+        command_buffer.begin_render_pass(pass_info,
+            VK_SUBPASS_CONTENTS_INLINE);
+
+        command_buffer.bind_pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS,
+            this->pipeline.ref());
+        command_buffer.bind_vertex_buffers(0,
+            { this->vertex_buffer.ref() }, { 0 });
+        command_buffer.bind_index_buffer(this->index_buffer.ref(), 0,
+            VK_INDEX_TYPE_UINT16);
+
+        ::VkViewport viewport;
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = (float)this->extent.width;
+        viewport.height = (float)this->extent.height;
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+        command_buffer.set_viewport(0, { viewport });
+        command_buffer.set_scissor(0, { area });
+
+        for (uint32_t i = 0; i < draw_count; ++i) {
+            command_buffer.draw_indexed(6, 1, 0, 0, i);
+        }
+
+        command_buffer.end_render_pass();
+        command_buffer.end();
+    }
+};
+
+/// Command buffers and semaphores of one frame in flight.
+struct Frame
+{
+    /// One pool for each recording thread.
+    std::vector<pr::vk::UniqueCommandPool> pools;
+    pr::Vector<pr::vk::CommandBuffer> command_buffers;
+    pr::vk::UniqueSemaphore image_available;
+    pr::vk::UniqueSemaphore render_finished;
+
+    Frame(Headless& headless, uint32_t threads)
+    {
+        auto& device = headless.device();
+
+        for (uint32_t i = 0; i < threads; ++i) {
+            pr::vk::CommandPool::CreateInfo pool_info;
+            pool_info.set_queue_family_index(headless.queue_family());
+            pool_info.set_flags(
+                VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+            this->pools.push_back(
+                device.create_unique_command_pool(pool_info));
+
+            pr::vk::CommandBuffer::AllocateInfo allocate_info;
+            allocate_info.set_command_pool(this->pools.back().ref());
+            allocate_info.set_level(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+            allocate_info.set_command_buffer_count(1);
+            this->command_buffers.push(
+                device.allocate_command_buffers(allocate_info));
+        }
+
+        pr::vk::Semaphore::CreateInfo semaphore_info;
+        this->image_available = device.create_unique_semaphore(
+            semaphore_info);
+        this->render_finished = device.create_unique_semaphore(
+            semaphore_info);
+    }
+};
+
+//=================
+// Frame loop
+//=================
+
+static void run(Headless& headless, const Options& options)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto& device = headless.device();
+    auto& queue = headless.queue();
+
+    // An image for each frame in flight. Acquiring an image waits for the
+    // frame that used it last, so it also frees that frame's resources.
+    pr::vk::OffscreenTarget::CreateInfo target_info;
+    target_info.set_image_count(options.frames_in_flight);
+    target_info.set_extent(::VkExtent2D { options.width, options.height });
+    target_info.set_color_usage(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+    pr::vk::OffscreenTarget target(device,
+        headless.physical_device().memory_properties(), target_info);
+
+    Scene scene(headless, target);
+
+    std::vector<Frame> frames;
+    for (uint32_t i = 0; i < options.frames_in_flight; ++i) {
+        frames.emplace_back(headless, options.threads);
+    }
+
+    // Set before each `Recorders::run`.
+    Frame *frame = nullptr;
+    uint32_t image_index = 0;
+
+    Recorders recorders(options.threads, [&](uint32_t slice) {
+        // Spread the draws over the slices, the first ones getting the
+        // remainder.
+        uint32_t draw_count = options.draws / options.threads +
+            ((slice < options.draws % options.threads) ? 1 : 0);
+        scene.record(frame->command_buffers[slice], image_index,
+            slice == 0, draw_count);
+    });
+
+    Clock::time_point start;
+    Clock::duration cpu_time(0);
+    uint64_t allocations_before = 0;
+    uint64_t device_allocations_before = 0;
+
+    uint32_t total = options.warmup + options.frames;
+    for (uint32_t i = 0; i < total; ++i) {
+        if (i == options.warmup) {
+            start = Clock::now();
+            allocations_before = allocations.load();
+            device_allocations_before =
+                device.statistics().allocate_count();
+        }
+
+        frame = &frames[i % options.frames_in_flight];
+        image_index = target.acquire_next_image(queue, UINT64_MAX,
+            frame->image_available.ref());
+
+        auto cpu_start = Clock::now();
+
+        recorders.run();
+
+        pr::vk::SubmitInfo submit;
+        submit.set_wait_semaphores({ frame->image_available.ref() });
+        submit.set_wait_dst_stage_mask({
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        });
+        submit.set_command_buffers(frame->command_buffers);
+        submit.set_signal_semaphores({ frame->render_finished.ref() });
+        queue.submit({ submit });
+
+        target.present(queue, image_index,
+            { frame->render_finished.ref() });
+
+        if (i >= options.warmup) {
+            cpu_time += Clock::now() - cpu_start;
+        }
+    }
+    target.wait_idle();
+
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    double cpu_ms =
+        std::chrono::duration<double, std::milli>(cpu_time).count();
+    uint64_t frame_allocations = allocations.load() - allocations_before;
+    uint64_t device_allocations = device.statistics().allocate_count() -
+        device_allocations_before;
+
+    printf("frames: %u\n", options.frames);
+    printf("draws: %u\n", options.draws);
+    printf("frames in flight: %u\n", options.frames_in_flight);
+    printf("threads: %u\n", options.threads);
+    printf("fps: %.1f\n", options.frames / seconds);
+    printf("cpu ms/frame: %.4f\n", cpu_ms / options.frames);
+    printf("allocations/frame: %.2f\n",
+        double(frame_allocations) / options.frames);
+    printf("device allocations/frame: %.2f\n",
+        double(device_allocations) / options.frames);
+}
+
+int main(int argc, char *argv[])
+{
+    Options options = parse_options(argc, argv);
+
+    Headless *headless = new Headless();
+    run(*headless, options);
+    delete headless;
+
+    return 0;
+}
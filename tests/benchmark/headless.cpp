@@ -0,0 +1,126 @@
+#include "headless.h"
+
+// C
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Headless::Headless()
+{
+    pr::vk::Instance::CreateInfo instance_info;
+    instance_info.set_enabled_extension_names(pr::Vector<pr::String>());
+    this->_instance = new pr::vk::Instance(instance_info);
+
+    pr::vk::DeviceSelector::CreateInfo selector_info;
+    selector_info.set_preferred_type(VK_PHYSICAL_DEVICE_TYPE_CPU);
+    pr::vk::DeviceSelector selector(*this->_instance, selector_info);
+    if (selector.candidates().length() == 0) {
+        fprintf(stderr, "No Vulkan device with a graphics queue.\n");
+        exit(1);
+    }
+    auto selection = selector.select();
+
+    this->_physical_device = new pr::vk::PhysicalDevice(
+        selection.physical_device);
+    fprintf(stderr, "Device: %s\n",
+        this->_physical_device->properties().deviceName);
+
+    this->_queue_family = selection.topology.graphics_family();
+    this->_device = new pr::vk::Device(selection.device);
+    this->_queue = new pr::vk::Queue(selection.graphics_queue);
+}
+
+Headless::~Headless()
+{
+    this->_device->wait_idle();
+    this->_memories.clear();
+
+    delete this->_queue;
+    delete this->_device;
+    delete this->_physical_device;
+    delete this->_instance;
+}
+
+pr::vk::PhysicalDevice& Headless::physical_device()
+{
+    return *this->_physical_device;
+}
+
+pr::vk::Device& Headless::device()
+{
+    return *this->_device;
+}
+
+pr::vk::Queue& Headless::queue()
+{
+    return *this->_queue;
+}
+
+uint32_t Headless::queue_family() const
+{
+    return this->_queue_family;
+}
+
+pr::vk::UniqueBuffer Headless::create_buffer(::VkDeviceSize size,
+                                             ::VkBufferUsageFlags usage,
+                                             const void *data)
+{
+    pr::vk::Buffer::CreateInfo info;
+    info.set_size(size);
+    info.set_usage(usage);
+    info.set_sharing_mode(VK_SHARING_MODE_EXCLUSIVE);
+    auto buffer = this->_device->create_unique_buffer(info);
+
+    auto memory = this->allocate(
+        this->_device->memory_requirements_for(buffer.ref()),
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    this->_device->bind_buffer_memory(buffer.ref(), memory, 0);
+
+    if (data != nullptr) {
+        void *mapped;
+        this->_device->map_memory(memory, 0, size, 0, &mapped);
+        memcpy(mapped, data, size);
+        this->_device->unmap_memory(memory);
+    }
+
+    return buffer;
+}
+
+pr::vk::UniqueImage Headless::create_image(::VkFormat format,
+                                           ::VkExtent2D extent,
+                                           ::VkImageUsageFlags usage)
+{
+    pr::vk::Image::CreateInfo info;
+    info.set_format(format);
+    info.set_extent(::VkExtent3D { extent.width, extent.height, 1 });
+    info.set_usage(usage);
+    auto image = this->_device->create_unique_image(info);
+
+    auto memory = this->allocate(
+        this->_device->memory_requirements_for(image.ref()),
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    this->_device->bind_image_memory(image.ref(), memory, 0);
+
+    return image;
+}
+
+pr::vk::DeviceMemoryRef Headless::allocate(
+    const pr::vk::MemoryRequirements& requirements,
+    ::VkMemoryPropertyFlags properties)
+{
+    auto memory_properties = this->_physical_device->memory_properties();
+    int32_t type_index = memory_properties.find_memory_type(
+        requirements.memory_type_bits(), properties);
+    if (type_index < 0) {
+        type_index = memory_properties.find_memory_type(
+            requirements.memory_type_bits(), 0);
+    }
+
+    pr::vk::MemoryAllocateInfo info;
+    info.set_allocation_size(requirements.size());
+    info.set_memory_type_index(type_index);
+    this->_memories.push_back(this->_device->allocate_unique_memory(info));
+
+    return this->_memories.back().ref();
+}
@@ -0,0 +1,58 @@
+#ifndef _HEADLESS_H
+#define _HEADLESS_H
+
+#include <prime-vulkan/vulkan.h>
+
+// C
+#include <stdint.h>
+
+// C++
+#include <vector>
+
+/// Instance, device and queue without a window, for benchmarks on a CPU
+/// driver like lavapipe or the mock ICD.
+///
+/// Picks a CPU physical device if there is one, and its graphics queue
+/// family. Select the driver with `VK_ICD_FILENAMES`.
+class Headless
+{
+public:
+    Headless();
+
+    ~Headless();
+
+    pr::vk::PhysicalDevice& physical_device();
+
+    pr::vk::Device& device();
+
+    pr::vk::Queue& queue();
+
+    uint32_t queue_family() const;
+
+    /// Create a buffer bound to host visible memory, filled with `data`
+    /// unless it is null.
+    pr::vk::UniqueBuffer create_buffer(::VkDeviceSize size,
+                                       ::VkBufferUsageFlags usage,
+                                       const void *data = nullptr);
+
+    /// Create an optimal tiling 2D image bound to device memory.
+    pr::vk::UniqueImage create_image(::VkFormat format,
+                                     ::VkExtent2D extent,
+                                     ::VkImageUsageFlags usage);
+
+private:
+    /// Allocate memory for the requirements, kept until destruction.
+    pr::vk::DeviceMemoryRef allocate(
+        const pr::vk::MemoryRequirements& requirements,
+        ::VkMemoryPropertyFlags properties);
+
+private:
+    pr::vk::Instance *_instance;
+    pr::vk::PhysicalDevice *_physical_device;
+    pr::vk::Device *_device;
+    pr::vk::Queue *_queue;
+    uint32_t _queue_family;
+    std::vector<pr::vk::UniqueDeviceMemory> _memories;
+};
+
+#endif // _HEADLESS_H
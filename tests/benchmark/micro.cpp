@@ -0,0 +1,397 @@
+// Per-call overhead of the wrapper next to the same raw Vulkan calls.
+//
+// The raw versions call through the device's dispatch table, as an
+// application loading its device functions would, so the difference is
+// the wrapper itself and not the loader trampoline.
+
+#include <prime-vulkan/vulkan.h>
+
+#include <benchmark/benchmark.h>
+
+#include "headless.h"
+
+static Headless *headless = nullptr;
+
+// Commands recorded per iteration by the recording benchmarks.
+static const int commands_per_iteration = 64;
+
+static const ::VkDeviceSize buffer_size = 4096;
+
+// Submissions between waits in the submit benchmarks.
+static const int submits_per_wait = 256;
+
+static const uint32_t sets_per_allocation = 4;
+
+//===================
+// Command recording
+//===================
+
+struct Recording
+{
+    pr::vk::UniqueCommandPool pool;
+    pr::vk::CommandBuffer *command_buffer;
+    pr::vk::UniqueBuffer src;
+    pr::vk::UniqueBuffer dst;
+
+    Recording()
+    {
+        auto& device = headless->device();
+
+        pr::vk::CommandPool::CreateInfo pool_info;
+        pool_info.set_queue_family_index(headless->queue_family());
+        pool_info.set_flags(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+        this->pool = device.create_unique_command_pool(pool_info);
+
+        pr::vk::CommandBuffer::AllocateInfo allocate_info;
+        allocate_info.set_command_pool(this->pool.ref());
+        allocate_info.set_level(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        allocate_info.set_command_buffer_count(1);
+        this->command_buffer = new pr::vk::CommandBuffer(
+            device.allocate_command_buffers(allocate_info));
+
+        auto usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        this->src = headless->create_buffer(buffer_size, usage);
+        this->dst = headless->create_buffer(buffer_size, usage);
+    }
+
+    ~Recording()
+    {
+        delete this->command_buffer;
+    }
+};
+
+static void record_wrapper(benchmark::State& state)
+{
+    Recording recording;
+    auto& command_buffer = *recording.command_buffer;
+
+    pr::vk::CommandBuffer::BeginInfo begin_info;
+    begin_info.set_flags(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+    pr::vk::BufferCopy region;
+    region.set_size(buffer_size);
+
+    ::VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    for (auto _: state) {
+        command_buffer.begin(begin_info);
+        for (int i = 0; i < commands_per_iteration; ++i) {
+            command_buffer.fill_buffer(recording.src.ref(), 0, buffer_size,
+                i);
+            command_buffer.pipeline_barrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, 0, { barrier }, {}, {});
+            command_buffer.copy_buffer(recording.src.ref(),
+                recording.dst.ref(), { region });
+        }
+        command_buffer.end();
+    }
+    state.SetItemsProcessed(state.iterations() * commands_per_iteration * 3);
+}
+BENCHMARK(record_wrapper);
+
+static void record_raw(benchmark::State& state)
+{
+    Recording recording;
+    auto& vk = headless->device().dispatch();
+    ::VkCommandBuffer command_buffer = recording.command_buffer->c_ptr();
+    ::VkBuffer src = recording.src.c_ptr();
+    ::VkBuffer dst = recording.dst.c_ptr();
+
+    ::VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    ::VkBufferCopy region = { 0, 0, buffer_size };
+
+    ::VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    for (auto _: state) {
+        vk.vkBeginCommandBuffer(command_buffer, &begin_info);
+        for (int i = 0; i < commands_per_iteration; ++i) {
+            vk.vkCmdFillBuffer(command_buffer, src, 0, buffer_size, i);
+            vk.vkCmdPipelineBarrier(command_buffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier,
+                0, nullptr, 0, nullptr);
+            vk.vkCmdCopyBuffer(command_buffer, src, dst, 1, &region);
+        }
+        vk.vkEndCommandBuffer(command_buffer);
+    }
+    state.SetItemsProcessed(state.iterations() * commands_per_iteration * 3);
+}
+BENCHMARK(record_raw);
+
+//=================
+// Submit info
+//=================
+
+static void submit_info_wrapper(benchmark::State& state)
+{
+    Recording recording;
+    auto semaphore = headless->device().create_unique_semaphore(
+        pr::vk::Semaphore::CreateInfo());
+
+    for (auto _: state) {
+        pr::vk::SubmitInfo info;
+        info.set_command_buffers({
+            pr::vk::CommandBufferRef(*recording.command_buffer) });
+        info.set_signal_semaphores({ semaphore.ref() });
+        auto vk_info = info.c_struct();
+        benchmark::DoNotOptimize(vk_info);
+    }
+}
+BENCHMARK(submit_info_wrapper);
+
+static void submit_info_raw(benchmark::State& state)
+{
+    Recording recording;
+    auto semaphore = headless->device().create_unique_semaphore(
+        pr::vk::Semaphore::CreateInfo());
+    ::VkCommandBuffer command_buffer = recording.command_buffer->c_ptr();
+    ::VkSemaphore vk_semaphore = semaphore.c_ptr();
+
+    for (auto _: state) {
+        ::VkSubmitInfo vk_info;
+        vk_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        vk_info.pNext = nullptr;
+        vk_info.waitSemaphoreCount = 0;
+        vk_info.pWaitSemaphores = nullptr;
+        vk_info.pWaitDstStageMask = nullptr;
+        vk_info.commandBufferCount = 1;
+        vk_info.pCommandBuffers = &command_buffer;
+        vk_info.signalSemaphoreCount = 1;
+        vk_info.pSignalSemaphores = &vk_semaphore;
+        benchmark::DoNotOptimize(vk_info);
+    }
+}
+BENCHMARK(submit_info_raw);
+
+//=================
+// Queue submit
+//=================
+
+// Empty submissions, so the driver does as little as it can.
+static void queue_submit_wrapper(benchmark::State& state)
+{
+    auto& queue = headless->queue();
+    int count = 0;
+
+    for (auto _: state) {
+        queue.submit({ pr::vk::SubmitInfo() });
+        if (++count % submits_per_wait == 0) {
+            queue.wait_idle();
+        }
+    }
+    queue.wait_idle();
+}
+BENCHMARK(queue_submit_wrapper);
+
+static void queue_submit_raw(benchmark::State& state)
+{
+    auto& vk = headless->device().dispatch();
+    ::VkQueue queue = headless->queue().c_ptr();
+    int count = 0;
+
+    for (auto _: state) {
+        ::VkSubmitInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        vk.vkQueueSubmit(queue, 1, &info, VK_NULL_HANDLE);
+        if (++count % submits_per_wait == 0) {
+            vk.vkQueueWaitIdle(queue);
+        }
+    }
+    vk.vkQueueWaitIdle(queue);
+}
+BENCHMARK(queue_submit_raw);
+
+//=======================
+// Descriptor allocation
+//=======================
+
+struct Descriptors
+{
+    pr::vk::UniqueDescriptorSetLayout layout;
+    pr::vk::UniqueDescriptorPool pool;
+
+    Descriptors()
+    {
+        auto& device = headless->device();
+
+        pr::vk::DescriptorSetLayout::Binding binding;
+        binding.set_binding(0);
+        binding.set_descriptor_type(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        binding.set_descriptor_count(1);
+        binding.set_stage_flags(VK_SHADER_STAGE_VERTEX_BIT);
+
+        pr::vk::DescriptorSetLayout::CreateInfo layout_info;
+        layout_info.set_bindings({ binding });
+        this->layout = device.create_unique_descriptor_set_layout(
+            layout_info);
+
+        pr::vk::DescriptorPool::Size size;
+        size.set_type(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        size.set_descriptor_count(sets_per_allocation);
+
+        pr::vk::DescriptorPool::CreateInfo pool_info;
+        pool_info.set_pool_sizes({ size });
+        pool_info.set_max_sets(sets_per_allocation);
+        this->pool = device.create_unique_descriptor_pool(pool_info);
+    }
+};
+
+// Both versions reset the pool with the raw call, the wrapper has none.
+static void descriptor_allocation_wrapper(benchmark::State& state)
+{
+    Descriptors descriptors;
+    auto& device = headless->device();
+
+    for (auto _: state) {
+        pr::vk::DescriptorSet::AllocateInfo info;
+        info.set_descriptor_pool(descriptors.pool.ref());
+        info.set_set_layouts({
+            descriptors.layout.ref(), descriptors.layout.ref(),
+            descriptors.layout.ref(), descriptors.layout.ref(),
+        });
+        auto sets = device.allocate_descriptor_sets(info);
+        benchmark::DoNotOptimize(sets);
+
+        vkResetDescriptorPool(device.c_ptr(), descriptors.pool.c_ptr(), 0);
+    }
+    state.SetItemsProcessed(state.iterations() * sets_per_allocation);
+}
+BENCHMARK(descriptor_allocation_wrapper);
+
+static void descriptor_allocation_raw(benchmark::State& state)
+{
+    Descriptors descriptors;
+    auto& device = headless->device();
+    auto& vk = device.dispatch();
+    ::VkDescriptorSetLayout layouts[sets_per_allocation];
+    for (auto& layout: layouts) {
+        layout = descriptors.layout.c_ptr();
+    }
+
+    for (auto _: state) {
+        ::VkDescriptorSetAllocateInfo info;
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        info.pNext = nullptr;
+        info.descriptorPool = descriptors.pool.c_ptr();
+        info.descriptorSetCount = sets_per_allocation;
+        info.pSetLayouts = layouts;
+
+        ::VkDescriptorSet sets[sets_per_allocation];
+        vk.vkAllocateDescriptorSets(device.c_ptr(), &info, sets);
+        benchmark::DoNotOptimize(sets);
+
+        vkResetDescriptorPool(device.c_ptr(), descriptors.pool.c_ptr(), 0);
+    }
+    state.SetItemsProcessed(state.iterations() * sets_per_allocation);
+}
+BENCHMARK(descriptor_allocation_raw);
+
+//========================
+// Create info conversion
+//========================
+
+static void image_create_info_wrapper(benchmark::State& state)
+{
+    for (auto _: state) {
+        pr::vk::Image::CreateInfo info;
+        info.set_format(VK_FORMAT_R8G8B8A8_UNORM);
+        info.set_extent(::VkExtent3D { 1024, 1024, 1 });
+        info.set_mip_levels(11);
+        info.set_usage(VK_IMAGE_USAGE_SAMPLED_BIT |
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+        auto vk_info = info.c_struct();
+        benchmark::DoNotOptimize(vk_info);
+    }
+}
+BENCHMARK(image_create_info_wrapper);
+
+static void image_create_info_raw(benchmark::State& state)
+{
+    for (auto _: state) {
+        ::VkImageCreateInfo vk_info;
+        vk_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        vk_info.pNext = nullptr;
+        vk_info.flags = 0;
+        vk_info.imageType = VK_IMAGE_TYPE_2D;
+        vk_info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        vk_info.extent = ::VkExtent3D { 1024, 1024, 1 };
+        vk_info.mipLevels = 11;
+        vk_info.arrayLayers = 1;
+        vk_info.samples = VK_SAMPLE_COUNT_1_BIT;
+        vk_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        vk_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT |
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        vk_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        vk_info.queueFamilyIndexCount = 0;
+        vk_info.pQueueFamilyIndices = nullptr;
+        vk_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        benchmark::DoNotOptimize(vk_info);
+    }
+}
+BENCHMARK(image_create_info_raw);
+
+static void descriptor_set_layout_create_info_wrapper(
+    benchmark::State& state)
+{
+    for (auto _: state) {
+        pr::vk::DescriptorSetLayout::Binding binding;
+        binding.set_binding(0);
+        binding.set_descriptor_type(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        binding.set_descriptor_count(1);
+        binding.set_stage_flags(VK_SHADER_STAGE_VERTEX_BIT);
+
+        pr::vk::DescriptorSetLayout::CreateInfo info;
+        info.set_bindings({ binding });
+        auto vk_info = info.c_struct();
+        benchmark::DoNotOptimize(vk_info);
+    }
+}
+BENCHMARK(descriptor_set_layout_create_info_wrapper);
+
+static void descriptor_set_layout_create_info_raw(benchmark::State& state)
+{
+    for (auto _: state) {
+        ::VkDescriptorSetLayoutBinding binding;
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        binding.pImmutableSamplers = nullptr;
+
+        ::VkDescriptorSetLayoutCreateInfo vk_info;
+        vk_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        vk_info.pNext = nullptr;
+        vk_info.flags = 0;
+        vk_info.bindingCount = 1;
+        vk_info.pBindings = &binding;
+        benchmark::DoNotOptimize(vk_info);
+        benchmark::DoNotOptimize(binding);
+    }
+}
+BENCHMARK(descriptor_set_layout_create_info_raw);
+
+int main(int argc, char *argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    headless = new Headless();
+    benchmark::RunSpecifiedBenchmarks();
+    delete headless;
+
+    benchmark::Shutdown();
+
+    return 0;
+}